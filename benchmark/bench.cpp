@@ -1,8 +1,29 @@
 #include "bench.hpp"
+#include <eirin/random.hpp>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <unordered_map>
 #include <vector>
 
+#ifdef __linux__
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
 eirin::fixed64 f64_identity(eirin::fixed64 val)
 {
     return val;
@@ -54,3 +75,329 @@ std::string get_input(std::string input, std::string key)
     }
     return VALUE_DEFAULT;
 }
+
+#ifdef __linux__
+
+static int open_event(uint32_t type, uint64_t config, int group)
+{
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group == -1;
+    // user space only, which is allowed with perf_event_paranoid <= 2.
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+}
+
+// UOPS_ISSUED.ANY on intel, and retired uops on amd.
+static bool uops_event(uint64_t& config)
+{
+    if(const char* env = std::getenv("EIRIN_BENCH_UOPS_EVENT"))
+    {
+        config = std::strtoull(env, nullptr, 16);
+        return true;
+    }
+#    if defined(__x86_64__) || defined(__i386__)
+    if(__builtin_cpu_is("intel"))
+    {
+        config = 0x010e;
+        return true;
+    }
+    if(__builtin_cpu_is("amd"))
+    {
+        config = 0x00c1;
+        return true;
+    }
+#    endif
+    return false;
+}
+
+perf_counters::perf_counters(benchmark::State& state) : m_state(state)
+{
+    static const bool enabled = []
+    {
+        const char* env = std::getenv("EIRIN_BENCH_COUNTERS");
+        return env == nullptr || std::string(env) != "0";
+    }();
+    if(!enabled)
+        return;
+
+    // the first event leads the group, so all of them count the same instructions.
+    m_fds[0] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+    if(m_fds[0] < 0)
+    {
+        static bool reported = false;
+        if(!reported)
+            std::fprintf(stderr, "perf_counters: perf_event_open is not available, the hardware counters are disabled.\n");
+        reported = true;
+        return;
+    }
+    m_names[m_count++] = "cycles";
+    const auto add = [this](uint32_t type, uint64_t config, const char* name)
+    {
+        const int fd = open_event(type, config, m_fds[0]);
+        if(fd >= 0)
+        {
+            m_fds[m_count] = fd;
+            m_names[m_count++] = name;
+        }
+    };
+    add(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions");
+    add(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, "branch-misses");
+    uint64_t uops = 0;
+    if(uops_event(uops))
+        add(PERF_TYPE_RAW, uops, "uops");
+
+    ioctl(m_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+perf_counters::~perf_counters()
+{
+    if(m_count == 0)
+        return;
+    ioctl(m_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    double values[max_events] = {};
+    for(int i = 0; i < m_count; ++i)
+    {
+        // {value, time enabled, time running}, the value is scaled up if the counters were multiplexed.
+        uint64_t data[3] = {};
+        if(read(m_fds[i], data, sizeof(data)) == static_cast<ssize_t>(sizeof(data)) && data[2] != 0)
+            values[i] = static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        m_state.counters[m_names[i]] = benchmark::Counter(values[i], benchmark::Counter::kAvgIterations);
+    }
+    if(m_count > 1 && m_names[1] == std::string("instructions") && values[0] > 0)
+        m_state.counters["IPC"] = values[1] / values[0];
+    for(int i = m_count - 1; i >= 0; --i)
+        close(m_fds[i]);
+}
+
+#else
+
+perf_counters::perf_counters(benchmark::State& state) : m_state(state)
+{
+}
+
+perf_counters::~perf_counters()
+{
+}
+
+#endif
+
+const char* distribution_name(input_distribution distribution)
+{
+    static const char* const names[] = {"uniform", "boundary", "small", "large"};
+    return names[static_cast<uint32_t>(distribution)];
+}
+
+// the domains of the benchmarks in the dataset mode, all representable by fixed32.
+const std::vector<dataset_domain> dataset_domains = {
+    {"arith", -1000, 1000},
+    {"mul", -100, 100},
+    {"div_den", 1, 100},
+    {"sqrt", 0, 30000},
+    {"exp", -10, 10},
+    {"log", 0.0001, 30000},
+    {"trig", -1000, 1000},
+    {"tan", -1.5, 1.5},
+    {"asin", -1, 1},
+    {"pow_base", 0.1, 10},
+    {"pow_exp", -4, 4},
+};
+
+namespace
+{
+constexpr char dataset_magic[8] = {'E', 'I', 'R', 'I', 'N', 'D', 'S', '1'};
+constexpr int dataset_types = 3;
+constexpr size_t dataset_align = 64;
+constexpr auto distributions = static_cast<size_t>(input_distribution::count);
+
+struct dataset_header
+{
+    char magic[8];
+    uint64_t seed;
+    uint32_t count;
+    uint32_t domains;
+};
+
+// the offsets of the values of every distribution, for fixed32, fixed64 and double.
+struct dataset_entry
+{
+    char name[32];
+    uint64_t offsets[distributions][dataset_types];
+};
+
+// a value of a distribution, the small ones are k ULPs away from `x`.
+struct dataset_value
+{
+    double x;
+    int64_t ulps;
+};
+
+template <typename R>
+R to_raw(dataset_value v, double lo, double hi, int f)
+{
+    const auto raw_lo = static_cast<int64_t>(std::ceil(std::ldexp(lo, f)));
+    const auto raw_hi = static_cast<int64_t>(std::floor(std::ldexp(hi, f)));
+    const auto raw = static_cast<int64_t>(std::llround(std::ldexp(v.x, f))) + v.ulps;
+    return static_cast<R>(std::clamp(raw, raw_lo, raw_hi));
+}
+} // namespace
+
+bool generate_dataset(const std::string& path, uint32_t count, uint64_t seed)
+{
+    if(count == 0 || (count & (count - 1)) != 0)
+        return false;
+    eirin::pcg2014_64 rng(seed);
+    // pcg2014_64 returns 56 bits.
+    const auto uniform = [&rng] { return std::ldexp(static_cast<double>(rng() >> 3), -53); };
+
+    const size_t table_size = sizeof(dataset_header) + sizeof(dataset_entry) * dataset_domains.size();
+    std::vector<unsigned char> file((table_size + dataset_align - 1) / dataset_align * dataset_align);
+    std::vector<dataset_entry> entries(dataset_domains.size());
+    const auto append = [&file](const void* data, size_t size)
+    {
+        const size_t offset = file.size();
+        file.resize((offset + size + dataset_align - 1) / dataset_align * dataset_align);
+        std::memcpy(file.data() + offset, data, size);
+        return static_cast<uint64_t>(offset);
+    };
+
+    std::vector<dataset_value> values(count);
+    std::vector<int32_t> raw32(count);
+    std::vector<int64_t> raw64(count);
+    std::vector<double> doubles(count);
+    for(size_t d = 0; d < dataset_domains.size(); ++d)
+    {
+        const auto [name, lo, hi] = dataset_domains[d];
+        std::snprintf(entries[d].name, sizeof(entries[d].name), "%s", name);
+        const double width = hi - lo;
+        for(size_t dist = 0; dist < distributions; ++dist)
+        {
+            for(auto& v : values)
+            {
+                const double u = uniform();
+                switch(static_cast<input_distribution>(dist))
+                {
+                case input_distribution::uniform:
+                    v = {lo + u * width, 0};
+                    break;
+                case input_distribution::boundary:
+                    v = {u < 0.5 ? lo + 2 * u * width / 1024 : hi - (2 * u - 1) * width / 1024, 0};
+                    break;
+                case input_distribution::small:
+                {
+                    const auto k = static_cast<int64_t>(rng() % 256) + 1;
+                    if(lo < 0 && hi > 0)
+                        v = {0, u < 0.5 ? -k : k};
+                    else
+                        v = lo >= 0 ? dataset_value{lo, k - 1} : dataset_value{hi, 1 - k};
+                    break;
+                }
+                case input_distribution::large:
+                    if(lo < 0 && hi > 0)
+                        v = {u < 0.5 ? lo * (1 - u / 4) : hi * (1 - (u - 0.5) / 4), 0};
+                    else
+                        v = {lo >= 0 ? hi - u * width / 8 : lo + u * width / 8, 0};
+                    break;
+                default:
+                    break;
+                }
+            }
+            // the double values are the fixed64 ones, so both see the same inputs.
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                raw32[i] = to_raw<int32_t>(values[i], lo, hi, 16);
+                raw64[i] = to_raw<int64_t>(values[i], lo, hi, 32);
+                doubles[i] = std::ldexp(static_cast<double>(raw64[i]), -32);
+            }
+            entries[d].offsets[dist][0] = append(raw32.data(), raw32.size() * sizeof(int32_t));
+            entries[d].offsets[dist][1] = append(raw64.data(), raw64.size() * sizeof(int64_t));
+            entries[d].offsets[dist][2] = append(doubles.data(), doubles.size() * sizeof(double));
+        }
+    }
+
+    dataset_header header{};
+    std::memcpy(header.magic, dataset_magic, sizeof(header.magic));
+    header.seed = seed;
+    header.count = count;
+    header.domains = static_cast<uint32_t>(dataset_domains.size());
+    std::memcpy(file.data(), &header, sizeof(header));
+    std::memcpy(file.data() + sizeof(header), entries.data(), sizeof(dataset_entry) * entries.size());
+
+    std::error_code ec;
+    const auto parent = std::filesystem::path(path).parent_path();
+    if(!parent.empty())
+        std::filesystem::create_directories(parent, ec);
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+    return static_cast<bool>(out);
+}
+
+dataset_file::dataset_file(const std::string& path)
+{
+#if defined(__unix__) || defined(__APPLE__)
+    const int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+        return;
+    struct stat st;
+    if(fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(dataset_header))
+    {
+        const auto size = static_cast<size_t>(st.st_size);
+        void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data != MAP_FAILED && std::memcmp(data, dataset_magic, sizeof(dataset_magic)) == 0)
+        {
+            m_data = static_cast<const unsigned char*>(data);
+            m_size = size;
+        }
+        else if(data != MAP_FAILED)
+            munmap(data, size);
+    }
+    close(fd);
+#else
+    std::ifstream in(path, std::ios::binary);
+    m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    if(m_buffer.size() >= sizeof(dataset_header) && std::memcmp(m_buffer.data(), dataset_magic, sizeof(dataset_magic)) == 0)
+    {
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+    }
+#endif
+}
+
+dataset_file::~dataset_file()
+{
+#if defined(__unix__) || defined(__APPLE__)
+    if(m_data != nullptr)
+        munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+}
+
+uint32_t dataset_file::count() const noexcept
+{
+    dataset_header header;
+    std::memcpy(&header, m_data, sizeof(header));
+    return header.count;
+}
+
+const void* dataset_file::find(std::string_view domain, input_distribution distribution, int type) const
+{
+    if(m_data == nullptr)
+        return nullptr;
+    dataset_header header;
+    std::memcpy(&header, m_data, sizeof(header));
+    for(uint32_t d = 0; d < header.domains; ++d)
+    {
+        const auto* entry = reinterpret_cast<const dataset_entry*>(m_data + sizeof(header)) + d;
+        if(domain == entry->name)
+        {
+            const auto offset = entry->offsets[static_cast<uint32_t>(distribution)][type];
+            const size_t size = header.count * (type == 0 ? sizeof(int32_t) : sizeof(int64_t));
+            return offset + size <= m_size ? m_data + offset : nullptr;
+        }
+    }
+    return nullptr;
+}
@@ -1,5 +1,9 @@
 #include <eirin/fixed.hpp>
+#include <cstdint>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #pragma once
 
@@ -13,3 +17,116 @@ eirin::fixed32 f32_identity(eirin::fixed32 val);
 double db_identity(double val);
 
 std::string get_input(std::string input, std::string key);
+
+namespace benchmark
+{
+class State;
+}
+
+// collects the hardware counters of a benchmark loop on linux, with perf_event_open, and adds cycles, instructions,
+// branch-misses and uops per iteration and the IPC to the benchmark output. Construct it just before the loop:
+//
+//     perf_counters counters(state);
+//     for(auto _ : state) { ... }
+//
+// it does nothing on the other platforms, when the counters are not accessible (see /proc/sys/kernel/perf_event_paranoid)
+// or when the environment variable EIRIN_BENCH_COUNTERS is 0.
+// uops have no generic perf event, the raw event of the cpu vendor is used, or EIRIN_BENCH_UOPS_EVENT as a hex config.
+class perf_counters
+{
+public:
+    explicit perf_counters(benchmark::State& state);
+    ~perf_counters();
+    perf_counters(const perf_counters&) = delete;
+    perf_counters& operator=(const perf_counters&) = delete;
+
+private:
+    static constexpr int max_events = 4;
+
+    benchmark::State& m_state;
+    int m_fds[max_events] = {-1, -1, -1, -1};
+    const char* m_names[max_events] = {};
+    int m_count = 0;
+};
+
+// the dataset mode: instead of a single value read from input.in, the benchmarks cycle through N generated values
+// per distribution of a domain, stored in benchmark_input/dataset.bin for fixed32, fixed64 and double.
+enum class input_distribution : uint32_t
+{
+    // uniform over the domain.
+    uniform,
+    // within 1/1024 of the width of the domain from its bounds.
+    boundary,
+    // the smallest magnitudes of the domain, 1 to 256 ULPs away from 0, or from the bound nearest to 0.
+    small,
+    // the top 1/8 of the magnitudes of the domain.
+    large,
+    count
+};
+
+const char* distribution_name(input_distribution distribution);
+
+struct dataset_domain
+{
+    const char* name;
+    double lo;
+    double hi;
+};
+
+extern const std::vector<dataset_domain> dataset_domains;
+
+// writes `count` values, a power of two, per distribution of every domain with a seeded pcg2014_64.
+bool generate_dataset(const std::string& path, uint32_t count, uint64_t seed);
+
+// the dataset file, memory mapped where available and read into memory elsewhere.
+class dataset_file
+{
+public:
+    explicit dataset_file(const std::string& path);
+    ~dataset_file();
+    dataset_file(const dataset_file&) = delete;
+    dataset_file& operator=(const dataset_file&) = delete;
+
+    bool is_open() const noexcept
+    {
+        return m_data != nullptr;
+    }
+
+    uint32_t count() const noexcept;
+
+    // an empty span if the domain does not exist.
+    template <typename V>
+    std::span<const V> values(std::string_view domain, input_distribution distribution) const
+    {
+        static_assert(sizeof(V) == 4 || sizeof(V) == 8);
+        constexpr int type = std::is_same_v<V, double> ? 2 : (sizeof(V) == 4 ? 0 : 1);
+        const void* data = find(domain, distribution, type);
+        return data == nullptr ? std::span<const V>() : std::span<const V>(static_cast<const V*>(data), count());
+    }
+
+private:
+    const void* find(std::string_view domain, input_distribution distribution, int type) const;
+
+    const unsigned char* m_data = nullptr;
+    size_t m_size = 0;
+    std::vector<unsigned char> m_buffer;
+};
+
+// cycles through the values without a branch, the count is a power of two.
+template <typename V>
+class dataset_cycle
+{
+public:
+    explicit dataset_cycle(std::span<const V> values)
+        : m_data(values.data()), m_mask(values.size() - 1) {}
+
+    V next() noexcept
+    {
+        return m_data[m_index++ & m_mask];
+    }
+
+private:
+    const V* m_data;
+    size_t m_mask;
+    size_t m_index = 0;
+};
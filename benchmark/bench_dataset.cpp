@@ -0,0 +1,180 @@
+#include <eirin/fixed.hpp>
+#include <eirin/math.hpp>
+#include <benchmark/benchmark.h>
+#include "bench.hpp"
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// on windows/msvc, -Wmaybe-uninitialized is not available
+// so we can use #pragma to ignore the warning there
+#ifdef _MSC_VER
+// save warning levels, and drop it to level 3
+#    pragma warning(push, 3)
+// turn two warnings off
+#    pragma warning(disable : 4701 4703)
+#endif
+
+using namespace eirin;
+
+// the dataset mode of the benchmarks: every benchmark cycles through the generated values of one distribution
+// of its domain, instead of the single value of input.in, so a lucky value cannot decide the result.
+//
+// usage: eirin_fixed.dataset [--dataset=file] [--dataset_count=n] [--dataset_seed=n] [--regenerate] [benchmark flags]
+//   the dataset is generated if the file does not exist, or with --regenerate.
+
+static std::unique_ptr<dataset_file> dataset;
+
+#define EIRIN_DATASET_UNARY(op_name, expr, domain)                     \
+    struct op_name                                                     \
+    {                                                                  \
+        static constexpr size_t arity = 1;                             \
+        static constexpr const char* domains[] = {domain};             \
+        template <typename V>                                          \
+        static V apply(V x, V)                                         \
+        {                                                              \
+            using namespace std;                                       \
+            return expr;                                               \
+        }                                                              \
+    };
+
+#define EIRIN_DATASET_BINARY(op_name, expr, domain1, domain2)          \
+    struct op_name                                                     \
+    {                                                                  \
+        static constexpr size_t arity = 2;                             \
+        static constexpr const char* domains[] = {domain1, domain2};   \
+        template <typename V>                                          \
+        static V apply(V x, V y)                                       \
+        {                                                              \
+            using namespace std;                                       \
+            return expr;                                               \
+        }                                                              \
+    };
+
+EIRIN_DATASET_BINARY(op_add, x + y, "arith", "arith")
+EIRIN_DATASET_BINARY(op_sub, x - y, "arith", "arith")
+EIRIN_DATASET_BINARY(op_mul, x * y, "mul", "mul")
+EIRIN_DATASET_BINARY(op_div, x / y, "arith", "div_den")
+EIRIN_DATASET_UNARY(op_sqrt, sqrt(x), "sqrt")
+EIRIN_DATASET_UNARY(op_exp, exp(x), "exp")
+EIRIN_DATASET_UNARY(op_log, log(x), "log")
+EIRIN_DATASET_UNARY(op_log2, log2(x), "log")
+EIRIN_DATASET_UNARY(op_sin, sin(x), "trig")
+EIRIN_DATASET_UNARY(op_cos, cos(x), "trig")
+EIRIN_DATASET_UNARY(op_tan, tan(x), "tan")
+EIRIN_DATASET_UNARY(op_atan, atan(x), "trig")
+EIRIN_DATASET_UNARY(op_asin, asin(x), "asin")
+EIRIN_DATASET_UNARY(op_acos, acos(x), "asin")
+EIRIN_DATASET_BINARY(op_pow, pow(x, y), "pow_base", "pow_exp")
+
+#undef EIRIN_DATASET_UNARY
+#undef EIRIN_DATASET_BINARY
+
+// range(0) is the input_distribution, the second operand of the binary operations is drawn from the same one.
+template <typename V, typename Op>
+static void dataset_bench(benchmark::State& state)
+{
+    const auto distribution = static_cast<input_distribution>(state.range(0));
+    dataset_cycle<V> x(dataset->values<V>(Op::domains[0], distribution));
+    dataset_cycle<V> y(dataset->values<V>(Op::domains[Op::arity - 1], distribution));
+    perf_counters counters(state);
+    for(auto _ : state)
+    {
+        if constexpr(Op::arity == 1)
+            benchmark::DoNotOptimize(Op::apply(x.next(), V()));
+        else
+            benchmark::DoNotOptimize(Op::apply(x.next(), y.next()));
+    }
+    state.SetLabel(distribution_name(distribution));
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void distributions(benchmark::internal::Benchmark* b)
+{
+    for(int64_t d = 0; d < static_cast<int64_t>(input_distribution::count); ++d)
+        b->Arg(d);
+}
+
+#ifdef EIRIN_MATH_HAS_INT128
+#    define EIRIN_DATASET_BENCHMARK(op)                                    \
+        BENCHMARK_TEMPLATE(dataset_bench, fixed32, op)->Apply(distributions); \
+        BENCHMARK_TEMPLATE(dataset_bench, fixed64, op)->Apply(distributions); \
+        BENCHMARK_TEMPLATE(dataset_bench, double, op)->Apply(distributions)
+#else
+#    define EIRIN_DATASET_BENCHMARK(op)                                    \
+        BENCHMARK_TEMPLATE(dataset_bench, fixed32, op)->Apply(distributions); \
+        BENCHMARK_TEMPLATE(dataset_bench, double, op)->Apply(distributions)
+#endif
+
+EIRIN_DATASET_BENCHMARK(op_add);
+EIRIN_DATASET_BENCHMARK(op_sub);
+EIRIN_DATASET_BENCHMARK(op_mul);
+EIRIN_DATASET_BENCHMARK(op_div);
+EIRIN_DATASET_BENCHMARK(op_sqrt);
+EIRIN_DATASET_BENCHMARK(op_exp);
+EIRIN_DATASET_BENCHMARK(op_log);
+EIRIN_DATASET_BENCHMARK(op_log2);
+EIRIN_DATASET_BENCHMARK(op_sin);
+EIRIN_DATASET_BENCHMARK(op_cos);
+EIRIN_DATASET_BENCHMARK(op_tan);
+EIRIN_DATASET_BENCHMARK(op_atan);
+EIRIN_DATASET_BENCHMARK(op_asin);
+EIRIN_DATASET_BENCHMARK(op_acos);
+EIRIN_DATASET_BENCHMARK(op_pow);
+
+#ifdef _MSC_VER
+// restore original warning levels.
+#    pragma warning(pop)
+#endif
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    std::string path = "benchmark_input/dataset.bin";
+    uint32_t count = 4096;
+    uint64_t seed = 114514u;
+    bool regenerate = false;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if(arg.rfind("--dataset=", 0) == 0)
+            path = arg.substr(10);
+        else if(arg.rfind("--dataset_count=", 0) == 0)
+            count = static_cast<uint32_t>(std::stoul(arg.substr(16)));
+        else if(arg.rfind("--dataset_seed=", 0) == 0)
+            seed = std::stoull(arg.substr(15));
+        else if(arg == "--regenerate")
+            regenerate = true;
+        else
+        {
+            std::cerr << "unknown argument: " << arg << '\n';
+            return 1;
+        }
+    }
+
+    dataset = std::make_unique<dataset_file>(path);
+    if(regenerate || !dataset->is_open())
+    {
+        dataset.reset();
+        if(!generate_dataset(path, count, seed))
+        {
+            std::cerr << "cannot generate " << path << ", the count must be a power of two.\n";
+            return 1;
+        }
+        dataset = std::make_unique<dataset_file>(path);
+    }
+    for(const auto& domain : dataset_domains)
+    {
+        if(dataset->values<double>(domain.name, input_distribution::uniform).empty())
+        {
+            std::cerr << path << " has no domain " << domain.name << ", run with --regenerate.\n";
+            return 1;
+        }
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,268 @@
+#include <eirin/fixed.hpp>
+#include <eirin/math.hpp>
+#include <eirin/ext/cordic.hpp>
+#include <eirin/policy.hpp>
+#include <eirin/detail/perf.hpp>
+#include <eirin/detail/util.hpp>
+#include <benchmark/benchmark.h>
+#include "bench.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace eirin;
+
+// measures every implementation of every function for every fixed point format, and reports the error in ULPs
+// together with the cost in ns/op, so the implementations on the Pareto front of each function can be picked.
+//
+// usage: eirin_fixed.pareto [--format=csv|json] [--output=file] [--samples=n] [--threads=n]
+
+struct kernel
+{
+    const char* function;
+    const char* implementation;
+    const char* format;
+    double lo;
+    double hi;
+    // the error statistics over `samples` evenly spaced inputs of [lo, hi].
+    std::function<perf::error_stats(uint64_t samples, unsigned int threads)> measure;
+    // the cost of one call in ns, over random inputs of [lo, hi].
+    std::function<double()> time;
+};
+
+struct result
+{
+    const kernel* k;
+    perf::error_stats stats;
+    double ns_per_op;
+    bool pareto;
+};
+
+template <typename Fixed>
+static Fixed from_double(double x)
+{
+    return Fixed::from_internal_value(static_cast<decltype(Fixed().internal_value())>(std::llround(std::ldexp(x, Fixed::precision))));
+}
+
+template <typename Fixed>
+static const char* format_name()
+{
+    if constexpr(std::is_same_v<Fixed, fixed32>)
+        return "fixed32";
+#ifdef EIRIN_MATH_HAS_INT128
+    else if constexpr(std::is_same_v<Fixed, fixed64>)
+        return "fixed64";
+#endif
+    else
+        return "unknown";
+}
+
+// the minimum of several runs over the same 4096 inputs, to filter out the noise of the other threads and the scheduler.
+template <typename Fixed, typename Func>
+static double time_ns(Func func, double lo, double hi)
+{
+    constexpr size_t n = 4096;
+    constexpr int runs = 16;
+    std::mt19937_64 rng(114514u);
+    std::uniform_real_distribution<double> dist(lo, hi);
+    std::vector<Fixed> input(n), output(n);
+    for(auto& x : input)
+        x = from_double<Fixed>(dist(rng));
+
+    double best = HUGE_VAL;
+    for(int run = 0; run < runs; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for(size_t i = 0; i < n; ++i)
+            output[i] = func(input[i]);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+        const auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count() / n);
+    }
+    return best;
+}
+
+template <typename Fixed, typename Func, typename Ref>
+static kernel make_kernel(const char* function, const char* implementation, double lo, double hi, Func func, Ref ref)
+{
+    return {
+        function, implementation, format_name<Fixed>(), lo, hi,
+        [=](uint64_t samples, unsigned int threads)
+        { return perf::measure_error(from_double<Fixed>(lo), from_double<Fixed>(hi), samples, func, ref, threads); },
+        [=] { return time_ns<Fixed>(func, lo, hi); }};
+}
+
+// pow is measured along the base with a fixed exponent.
+static constexpr double pow_exponent = 2.5;
+
+template <typename Fixed>
+static void add_kernels(std::vector<kernel>& kernels)
+{
+    using std::atan, std::cos, std::exp, std::log, std::log2, std::pow, std::sin, std::sqrt;
+    const auto e = from_double<Fixed>(pow_exponent);
+    const auto one = from_double<Fixed>(1);
+
+    kernels.push_back(make_kernel<Fixed>("sin", "math", -10, 10, [](Fixed x) { return eirin::sin(x); }, [](long double x) { return sin(x); }));
+    kernels.push_back(make_kernel<Fixed>("sin", "cordic", -10, 10, [](Fixed x) { return cordic_sine(x); }, [](long double x) { return sin(x); }));
+#ifdef EIRIN_MATH_HAS_INT128
+    if constexpr(std::is_same_v<Fixed, fixed64>)
+        kernels.push_back(make_kernel<Fixed>("sin", "lut", -10, 10, [](Fixed x) { return util::lut::lut_calc_sin(x); }, [](long double x) { return sin(x); }));
+#endif
+    kernels.push_back(make_kernel<Fixed>("sin", "policy::fast", -10, 10, [](Fixed x) { return eirin::sin<policy::fast>(x); }, [](long double x) { return sin(x); }));
+    kernels.push_back(make_kernel<Fixed>("sin", "policy::lut", -10, 10, [](Fixed x) { return eirin::sin<policy::lut<>>(x); }, [](long double x) { return sin(x); }));
+    kernels.push_back(make_kernel<Fixed>("cos", "math", -10, 10, [](Fixed x) { return eirin::cos(x); }, [](long double x) { return cos(x); }));
+    kernels.push_back(make_kernel<Fixed>("cos", "cordic", -10, 10, [](Fixed x) { return cordic_sincos(x).second; }, [](long double x) { return cos(x); }));
+    kernels.push_back(make_kernel<Fixed>("cos", "policy::fast", -10, 10, [](Fixed x) { return eirin::cos<policy::fast>(x); }, [](long double x) { return cos(x); }));
+    kernels.push_back(make_kernel<Fixed>("cos", "policy::lut", -10, 10, [](Fixed x) { return eirin::cos<policy::lut<>>(x); }, [](long double x) { return cos(x); }));
+    kernels.push_back(make_kernel<Fixed>("atan", "math", -100, 100, [](Fixed x) { return eirin::atan(x); }, [](long double x) { return atan(x); }));
+    kernels.push_back(make_kernel<Fixed>("atan", "cordic", -100, 100, [one](Fixed x) { return cordic_atan2(x, one); }, [](long double x) { return atan(x); }));
+    kernels.push_back(make_kernel<Fixed>("atan", "policy::fast", -100, 100, [](Fixed x) { return eirin::atan<policy::fast>(x); }, [](long double x) { return atan(x); }));
+    kernels.push_back(make_kernel<Fixed>("sqrt", "math", 0, 10000, [](Fixed x) { return eirin::sqrt(x); }, [](long double x) { return sqrt(x); }));
+    kernels.push_back(make_kernel<Fixed>("sqrt", "cordic", 0, 10000, [](Fixed x) { return cordic_sqrt(x); }, [](long double x) { return sqrt(x); }));
+    kernels.push_back(make_kernel<Fixed>("log2", "math", 0.01, 10000, [](Fixed x) { return eirin::log2(x); }, [](long double x) { return log2(x); }));
+    kernels.push_back(make_kernel<Fixed>("log2", "fast", 0.01, 10000, [](Fixed x) { return eirin::fast_log2(x); }, [](long double x) { return log2(x); }));
+    kernels.push_back(make_kernel<Fixed>("log", "math", 0.01, 10000, [](Fixed x) { return eirin::log(x); }, [](long double x) { return log(x); }));
+    kernels.push_back(make_kernel<Fixed>("log", "policy::precise", 0.01, 10000, [](Fixed x) { return eirin::log<policy::precise>(x); }, [](long double x) { return log(x); }));
+    kernels.push_back(make_kernel<Fixed>("log", "cordic", 0.01, 10000, [](Fixed x) { return cordic_log(x); }, [](long double x) { return log(x); }));
+    kernels.push_back(make_kernel<Fixed>("exp", "math", -10, 10, [](Fixed x) { return eirin::exp(x); }, [](long double x) { return exp(x); }));
+    kernels.push_back(make_kernel<Fixed>("exp", "cordic", -10, 10, [](Fixed x) { return cordic_exp(x); }, [](long double x) { return exp(x); }));
+    kernels.push_back(make_kernel<Fixed>("pow", "math", 0.1, 10, [e](Fixed x) { return eirin::pow(x, e); }, [](long double x) { return pow(x, static_cast<long double>(pow_exponent)); }));
+}
+
+// an implementation is on the Pareto front if no other implementation of the same function and format
+// is at least as good in both the max error and the cost, and strictly better in one of them.
+static void mark_pareto(std::vector<result>& results)
+{
+    for(auto& a : results)
+    {
+        a.pareto = true;
+        for(const auto& b : results)
+        {
+            if(&a == &b || std::strcmp(a.k->function, b.k->function) != 0 || std::strcmp(a.k->format, b.k->format) != 0)
+                continue;
+            const bool no_worse = b.stats.max_ulp <= a.stats.max_ulp && b.ns_per_op <= a.ns_per_op;
+            const bool better = b.stats.max_ulp < a.stats.max_ulp || b.ns_per_op < a.ns_per_op;
+            if(no_worse && better)
+            {
+                a.pareto = false;
+                break;
+            }
+        }
+    }
+}
+
+static void write_csv(std::ostream& out, const std::vector<result>& results)
+{
+    out << "function,implementation,format,lo,hi,samples,max_ulp,mean_ulp,rms_ulp,max_ulp_input,ns_per_op,pareto";
+    for(size_t i = 0; i < perf::error_stats::histogram_size; ++i)
+        out << ",ulp_ge_" << perf::error_stats::bucket_bound(i);
+    out << '\n';
+    for(const auto& res : results)
+    {
+        char line[512];
+        std::snprintf(line, sizeof(line), "%s,%s,%s,%g,%g,%llu,%.6g,%.6g,%.6g,%.17g,%.4g,%d", res.k->function, res.k->implementation,
+                      res.k->format, res.k->lo, res.k->hi, static_cast<unsigned long long>(res.stats.samples), res.stats.max_ulp,
+                      res.stats.mean_ulp(), res.stats.rms_ulp(), static_cast<double>(res.stats.max_ulp_input), res.ns_per_op, res.pareto);
+        out << line;
+        for(auto count : res.stats.histogram)
+            out << ',' << count;
+        out << '\n';
+    }
+}
+
+static void write_json(std::ostream& out, const std::vector<result>& results)
+{
+    out << "{\n  \"histogram_lower_bounds_ulp\": [";
+    for(size_t i = 0; i < perf::error_stats::histogram_size; ++i)
+        out << (i ? ", " : "") << perf::error_stats::bucket_bound(i);
+    out << "],\n  \"results\": [\n";
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& res = results[i];
+        char line[512];
+        std::snprintf(line, sizeof(line),
+                      "    {\"function\": \"%s\", \"implementation\": \"%s\", \"format\": \"%s\", \"lo\": %g, \"hi\": %g, \"samples\": %llu, "
+                      "\"max_ulp\": %.6g, \"mean_ulp\": %.6g, \"rms_ulp\": %.6g, \"max_ulp_input\": %.17g, \"ns_per_op\": %.4g, \"pareto\": %s, ",
+                      res.k->function, res.k->implementation, res.k->format, res.k->lo, res.k->hi,
+                      static_cast<unsigned long long>(res.stats.samples), res.stats.max_ulp, res.stats.mean_ulp(), res.stats.rms_ulp(),
+                      static_cast<double>(res.stats.max_ulp_input), res.ns_per_op, res.pareto ? "true" : "false");
+        out << line << "\"histogram\": [";
+        for(size_t j = 0; j < res.stats.histogram.size(); ++j)
+            out << (j ? ", " : "") << res.stats.histogram[j];
+        out << "]}" << (i + 1 < results.size() ? "," : "") << '\n';
+    }
+    out << "  ]\n}\n";
+}
+
+int main(int argc, char** argv)
+{
+    std::string format = "csv";
+    std::string output;
+    uint64_t samples = 1 << 20;
+    unsigned int threads = 0;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if(arg.rfind("--format=", 0) == 0)
+            format = arg.substr(9);
+        else if(arg.rfind("--output=", 0) == 0)
+            output = arg.substr(9);
+        else if(arg.rfind("--samples=", 0) == 0)
+            samples = std::stoull(arg.substr(10));
+        else if(arg.rfind("--threads=", 0) == 0)
+            threads = static_cast<unsigned int>(std::stoul(arg.substr(10)));
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--format=csv|json] [--output=file] [--samples=n] [--threads=n]\n";
+            return 1;
+        }
+    }
+    if(format != "csv" && format != "json")
+    {
+        std::cerr << "unknown format: " << format << '\n';
+        return 1;
+    }
+
+    std::vector<kernel> kernels;
+    add_kernels<fixed32>(kernels);
+#ifdef EIRIN_MATH_HAS_INT128
+    add_kernels<fixed64>(kernels);
+#endif
+
+    std::vector<result> results;
+    for(const auto& k : kernels)
+    {
+        std::cerr << "measuring " << k.function << '/' << k.implementation << '/' << k.format << '\n';
+        // the timing runs alone, the error sweep uses all the threads.
+        const double ns = k.time();
+        results.push_back({&k, k.measure(samples, threads), ns, false});
+    }
+    mark_pareto(results);
+
+    std::ofstream file;
+    if(!output.empty())
+    {
+        file.open(output);
+        if(!file)
+        {
+            std::cerr << "cannot open " << output << '\n';
+            return 1;
+        }
+    }
+    std::ostream& out = output.empty() ? std::cout : file;
+    if(format == "csv")
+        write_csv(out, results);
+    else
+        write_json(out, results);
+    return 0;
+}
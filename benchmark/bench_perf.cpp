@@ -3,8 +3,16 @@
 #include <benchmark/benchmark.h>
 #include "bench.hpp"
 #include <eirin/ext/cordic.hpp>
+#include <eirin/poly.hpp>
+#include <eirin/vec.hpp>
+#include <eirin/soa.hpp>
+#include <eirin/matrix.hpp>
+#include <eirin/quaternion.hpp>
+#include <eirin/dsp/fft.hpp>
+#include <eirin/dsp/filter.hpp>
 #include <eirin/detail/util.hpp>
 #include <vector>
+#include <complex>
 #include <random>
 #include <chrono>
 #include <fstream>
@@ -85,10 +93,694 @@ static void double_sin(benchmark::State& state)
     }
 }
 
+static void poly_atan2(benchmark::State& state)
+{
+    auto y = f64_identity("-11.4514"_f64);
+    auto x = f64_identity("19.19810"_f64);
+    for(auto _ : state)
+    {
+        auto result = f64_identity(atan2(y, x));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void cordic_atan2(benchmark::State& state)
+{
+    auto y = f64_identity("-11.4514"_f64);
+    auto x = f64_identity("19.19810"_f64);
+    for(auto _ : state)
+    {
+        auto result = f64_identity(eirin::cordic_atan2(y, x));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void cordic_polar(benchmark::State& state)
+{
+    auto y = f64_identity("-11.4514"_f64);
+    auto x = f64_identity("19.19810"_f64);
+    for(auto _ : state)
+    {
+        auto [magnitude, angle] = eirin::cordic_polar(x, y);
+        benchmark::DoNotOptimize(magnitude);
+        benchmark::DoNotOptimize(angle);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void double_atan2(benchmark::State& state)
+{
+    double y = db_identity(-11.4514), x = db_identity(19.1981);
+    for(auto _ : state)
+    {
+        auto result = db_identity(std::atan2(y, x));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void math_exp(benchmark::State& state)
+{
+    auto x = f64_identity("2.7182"_f64);
+    for(auto _ : state)
+    {
+        auto result = f64_identity(exp(x));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void cordic_exp(benchmark::State& state)
+{
+    auto x = f64_identity("2.7182"_f64);
+    for(auto _ : state)
+    {
+        auto result = f64_identity(eirin::cordic_exp(x));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void math_log(benchmark::State& state)
+{
+    auto x = f64_identity("114.514"_f64);
+    for(auto _ : state)
+    {
+        auto result = f64_identity(log(x));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void cordic_log(benchmark::State& state)
+{
+    auto x = f64_identity("114.514"_f64);
+    for(auto _ : state)
+    {
+        auto result = f64_identity(eirin::cordic_log(x));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void math_sqrt(benchmark::State& state)
+{
+    auto x = f64_identity("114.514"_f64);
+    for(auto _ : state)
+    {
+        auto result = f64_identity(sqrt(x));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void cordic_sqrt(benchmark::State& state)
+{
+    auto x = f64_identity("114.514"_f64);
+    for(auto _ : state)
+    {
+        auto result = f64_identity(eirin::cordic_sqrt(x));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void cordic_sinh(benchmark::State& state)
+{
+    auto x = f64_identity("2.7182"_f64);
+    for(auto _ : state)
+    {
+        auto result = f64_identity(eirin::cordic_sinh(x));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void cordic_tanh(benchmark::State& state)
+{
+    auto x = f64_identity("2.7182"_f64);
+    for(auto _ : state)
+    {
+        auto result = f64_identity(eirin::cordic_tanh(x));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void turner_log2(benchmark::State& state)
+{
+    auto x = f64_identity("114.514"_f64);
+    for(auto _ : state)
+    {
+        auto result = f64_identity(log2(x));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void fast_log2(benchmark::State& state)
+{
+    auto x = f64_identity("114.514"_f64);
+    for(auto _ : state)
+    {
+        auto result = f64_identity(eirin::fast_log2(x));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void double_log2(benchmark::State& state)
+{
+    double x = db_identity(114.514);
+    for(auto _ : state)
+    {
+        auto result = db_identity(std::log2(x));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void math_exp2(benchmark::State& state)
+{
+    auto x = f64_identity("3.1415"_f64);
+    for(auto _ : state)
+    {
+        auto result = f64_identity(exp2(x));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void double_exp(benchmark::State& state)
+{
+    double x = db_identity(2.7182);
+    for(auto _ : state)
+    {
+        auto result = db_identity(std::exp(x));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void math_pow(benchmark::State& state)
+{
+    auto b = f64_identity("114.514"_f64);
+    auto e = f64_identity("1.5"_f64);
+    for(auto _ : state)
+    {
+        auto result = f64_identity(pow(b, e));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void double_pow(benchmark::State& state)
+{
+    double b = db_identity(114.514);
+    double e = db_identity(1.5);
+    for(auto _ : state)
+    {
+        auto result = db_identity(std::pow(b, e));
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+
+// e^x by its first 8 Taylor terms, long enough to make the dependency chain visible.
+template <typename Fixed, poly_scheme scheme>
+static Fixed taylor_exp8(Fixed x)
+{
+    return poly_eval<scheme, Fixed(1), Fixed(1), Fixed(1.0 / 2), Fixed(1.0 / 6), Fixed(1.0 / 24), Fixed(1.0 / 120),
+        Fixed(1.0 / 720), Fixed(1.0 / 5040)>(x);
+}
+
+// every evaluation depends on the previous one, so this measures the latency.
+template <typename Fixed, poly_scheme scheme>
+static void poly_latency(benchmark::State& state)
+{
+    auto x = Fixed(0.25);
+    for(auto _ : state)
+    {
+        // keep the fraction part only, so the input stays in [0, 1).
+        x = Fixed::from_internal_value(taylor_exp8<Fixed, scheme>(x).internal_value() & ((decltype(x.internal_value())(1) << Fixed::precision) - 1));
+        benchmark::DoNotOptimize(x);
+    }
+}
+
+// independent evaluations over an array, so this measures the throughput.
+template <typename Fixed, poly_scheme scheme>
+static void poly_throughput(benchmark::State& state)
+{
+    std::vector<Fixed> xs(1024), ys(1024);
+    for(size_t i = 0; i < xs.size(); ++i)
+        xs[i] = Fixed::from_internal_value(static_cast<decltype(Fixed().internal_value())>(i << (Fixed::precision - 10)));
+    for(auto _ : state)
+    {
+        for(size_t i = 0; i < xs.size(); ++i)
+            ys[i] = taylor_exp8<Fixed, scheme>(xs[i]);
+        benchmark::DoNotOptimize(ys.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(xs.size()));
+}
+
+template <typename Vec>
+static std::vector<Vec> random_vecs(size_t n)
+{
+    std::mt19937_64 rng(114514u);
+    std::vector<Vec> res(n);
+    for(auto& v : res)
+        for(size_t i = 0; i < Vec::size; ++i)
+            v[i] = typename Vec::value_type(static_cast<double>(rng() % 20000) / 1000 - 10);
+    return res;
+}
+
+// dot products summed in the intermediate type with a single shift.
+template <typename Vec>
+static void vec_dot(benchmark::State& state)
+{
+    auto as = random_vecs<Vec>(1024), bs = random_vecs<Vec>(1024);
+    for(auto _ : state)
+    {
+        typename Vec::value_type sum(0);
+        for(size_t i = 0; i < as.size(); ++i)
+            sum += dot(as[i], bs[i]);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(as.size()));
+}
+
+// the hand-rolled dot product with a shift after every multiplication.
+template <typename Vec>
+static void vec_dot_naive(benchmark::State& state)
+{
+    auto as = random_vecs<Vec>(1024), bs = random_vecs<Vec>(1024);
+    for(auto _ : state)
+    {
+        typename Vec::value_type sum(0);
+        for(size_t i = 0; i < as.size(); ++i)
+        {
+            auto d = as[i][0] * bs[i][0];
+            for(size_t j = 1; j < Vec::size; ++j)
+                d += as[i][j] * bs[i][j];
+            sum += d;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(as.size()));
+}
+
+static void vec3_cross(benchmark::State& state)
+{
+    auto as = random_vecs<vec3<fixed64>>(1024), bs = random_vecs<vec3<fixed64>>(1024);
+    for(auto _ : state)
+    {
+        for(size_t i = 0; i < as.size(); ++i)
+            as[i] = cross(as[i], bs[i]);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(as.size()));
+}
+
+static void vec4_add(benchmark::State& state)
+{
+    auto as = random_vecs<vec4<fixed64>>(1024), bs = random_vecs<vec4<fixed64>>(1024);
+    for(auto _ : state)
+    {
+        for(size_t i = 0; i < as.size(); ++i)
+            as[i] += bs[i];
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(as.size()));
+}
+
+// one integration step pos += vel * dt, with an array of structs.
+template <typename Fixed>
+static void aos_integrate(benchmark::State& state)
+{
+    auto pos = random_vecs<vec3<Fixed>>(4096), vel = random_vecs<vec3<Fixed>>(4096);
+    const auto dt = Fixed(0.01);
+    for(auto _ : state)
+    {
+        for(size_t i = 0; i < pos.size(); ++i)
+            pos[i] += vel[i] * dt;
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pos.size()));
+}
+
+// the same step with the structure of arrays and its batch operations.
+template <typename Fixed>
+static void soa_integrate(benchmark::State& state)
+{
+    soa_vec3<Fixed> pos, vel;
+    for(const auto& v : random_vecs<vec3<Fixed>>(4096))
+        pos.push_back(v);
+    for(const auto& v : random_vecs<vec3<Fixed>>(4096))
+        vel.push_back(v);
+    const auto dt = Fixed(0.01);
+    for(auto _ : state)
+    {
+        add_scaled(pos, pos, vel, dt);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pos.size()));
+}
+
+// the naive triple loop over fixed_num products, which shifts after every multiplication.
+template <typename Fixed>
+static void gemm_naive(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(0));
+    auto values = random_vecs<vec4<Fixed>>(n * n / 2);
+    dense_matrix<Fixed> a(n, n), b(n, n), c(n, n);
+    for(size_t i = 0; i < n * n / 2; ++i)
+    {
+        a.data()[2 * i] = values[i].x, a.data()[2 * i + 1] = values[i].y;
+        b.data()[2 * i] = values[i].z, b.data()[2 * i + 1] = values[i].w;
+    }
+    for(auto _ : state)
+    {
+        for(size_t i = 0; i < n; ++i)
+            for(size_t j = 0; j < n; ++j)
+            {
+                Fixed sum(0);
+                for(size_t k = 0; k < n; ++k)
+                    sum += a(i, k) * b(k, j);
+                c(i, j) = sum;
+            }
+        benchmark::DoNotOptimize(c.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n * n * n));
+}
+
+// the cache-blocked multiply, range(1) is the number of threads.
+template <typename Fixed>
+static void gemm_blocked(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(0));
+    auto values = random_vecs<vec4<Fixed>>(n * n / 2);
+    dense_matrix<Fixed> a(n, n), b(n, n);
+    for(size_t i = 0; i < n * n / 2; ++i)
+    {
+        a.data()[2 * i] = values[i].x, a.data()[2 * i + 1] = values[i].y;
+        b.data()[2 * i] = values[i].z, b.data()[2 * i + 1] = values[i].w;
+    }
+    for(auto _ : state)
+    {
+        auto c = multiply(a, b, static_cast<unsigned int>(state.range(1)));
+        benchmark::DoNotOptimize(c.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n * n * n));
+}
+
+template <typename Fixed>
+static void math_rsqrt(benchmark::State& state)
+{
+    auto values = random_vecs<vec4<Fixed>>(1024);
+    for(auto _ : state)
+    {
+        for(const auto& v : values)
+            benchmark::DoNotOptimize(rsqrt(abs(v.x) + Fixed(1)));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+template <typename Fixed>
+static void inverse_sqrt(benchmark::State& state)
+{
+    auto values = random_vecs<vec4<Fixed>>(1024);
+    for(auto _ : state)
+    {
+        for(const auto& v : values)
+            benchmark::DoNotOptimize(Fixed(1) / sqrt(abs(v.x) + Fixed(1)));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+// the Hamilton product composed from 16 fixed_num products, each with its own shift.
+static quaternion<fixed64> naive_quat_mul(const quaternion<fixed64>& a, const quaternion<fixed64>& b)
+{
+    return {a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y, a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+            a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w, a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z};
+}
+
+template <bool naive>
+static void quat_mul(benchmark::State& state)
+{
+    std::vector<quaternion<fixed64>> qs;
+    for(const auto& v : random_vecs<vec4<fixed64>>(1024))
+        qs.push_back(normalize(quaternion<fixed64>{v.x, v.y, v.z, v.w}));
+    for(auto _ : state)
+    {
+        auto acc = quaternion<fixed64>::identity();
+        for(const auto& q : qs)
+            acc = naive ? naive_quat_mul(acc, q) : acc * q;
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(qs.size()));
+}
+
+// v + 2w(u x v) + 2u x (u x v) with fixed_num products, for every vector.
+static void quat_rotate_naive(benchmark::State& state)
+{
+    auto vs = random_vecs<vec3<fixed64>>(4096);
+    const auto q = normalize(quaternion<fixed64>{1_f64, 2_f64, 3_f64, 4_f64});
+    const vec3<fixed64> u{q.x, q.y, q.z};
+    const auto naive_cross = [](const vec3<fixed64>& a, const vec3<fixed64>& b) -> vec3<fixed64>
+    { return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x}; };
+    for(auto _ : state)
+    {
+        for(auto& v : vs)
+        {
+            const auto t = naive_cross(u, v) * 2_f64;
+            v = v + t * q.w + naive_cross(u, t);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(vs.size()));
+}
+
+static void quat_rotate_batch(benchmark::State& state)
+{
+    auto vs = random_vecs<vec3<fixed64>>(4096);
+    const auto q = normalize(quaternion<fixed64>{1_f64, 2_f64, 3_f64, 4_f64});
+    for(auto _ : state)
+    {
+        rotate(q, std::span<vec3<fixed64>>(vs));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(vs.size()));
+}
+
+// the forward transform of fft_plan, range(0) is the size.
+template <typename Fixed>
+static void fft_fixed(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(0));
+    auto values = random_vecs<vec2<Fixed>>(n);
+    std::vector<dsp::complex<Fixed>> input(n), data(n);
+    for(size_t i = 0; i < n; ++i)
+        input[i] = {values[i].x / 32, values[i].y / 32};
+    const dsp::fft_plan<Fixed> plan(n);
+    for(auto _ : state)
+    {
+        std::copy(input.begin(), input.end(), data.begin());
+        plan.forward(data);
+        benchmark::DoNotOptimize(data.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+// the iterative radix-2 float transform with precomputed twiddles, the baseline of fft_fixed.
+static void fft_float(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(0));
+    auto values = random_vecs<vec2<fixed32>>(n);
+    std::vector<std::complex<float>> input(n), data(n), twiddles(n / 2);
+    for(size_t i = 0; i < n; ++i)
+        input[i] = {static_cast<float>(values[i].x), static_cast<float>(values[i].y)};
+    for(size_t k = 0; k < n / 2; ++k)
+        twiddles[k] = std::polar(1.0f, static_cast<float>(-2 * std::numbers::pi * static_cast<double>(k) / static_cast<double>(n)));
+    for(auto _ : state)
+    {
+        std::copy(input.begin(), input.end(), data.begin());
+        for(size_t i = 1, j = 0; i < n; ++i)
+        {
+            size_t bit = n >> 1;
+            for(; j & bit; bit >>= 1)
+                j ^= bit;
+            j |= bit;
+            if(i < j)
+                std::swap(data[i], data[j]);
+        }
+        for(size_t len = 2; len <= n; len *= 2)
+            for(size_t g = 0; g < n; g += len)
+                for(size_t k = 0; k < len / 2; ++k)
+                {
+                    const auto t = twiddles[k * (n / len)] * data[g + k + len / 2];
+                    data[g + k + len / 2] = data[g + k] - t;
+                    data[g + k] += t;
+                }
+        benchmark::DoNotOptimize(data.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+// a 32 tap FIR filter with a fixed_num product and shift per tap.
+static void fir_naive(benchmark::State& state)
+{
+    auto values = random_vecs<vec4<fixed32>>(1024);
+    std::array<fixed32, 32> taps;
+    for(size_t k = 0; k < taps.size(); ++k)
+        taps[k] = values[k].x / 256;
+    std::vector<fixed32> input(4096 + taps.size() - 1, 0_f32), output(4096);
+    for(size_t i = 0; i < output.size(); ++i)
+        input[taps.size() - 1 + i] = values[i / 4][i % 4];
+    for(auto _ : state)
+    {
+        for(size_t n = 0; n < output.size(); ++n)
+        {
+            fixed32 sum(0);
+            for(size_t k = 0; k < taps.size(); ++k)
+                sum += taps[k] * input[taps.size() - 1 + n - k];
+            output[n] = sum;
+        }
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(output.size()));
+}
+
+static void fir_block(benchmark::State& state)
+{
+    auto values = random_vecs<vec4<fixed32>>(1024);
+    std::array<fixed32, 32> taps;
+    for(size_t k = 0; k < taps.size(); ++k)
+        taps[k] = values[k].x / 256;
+    std::vector<fixed32> input(4096), output(4096);
+    for(size_t i = 0; i < input.size(); ++i)
+        input[i] = values[i / 4][i % 4];
+    dsp::fir_filter<fixed32, 32> fir(taps);
+    for(auto _ : state)
+    {
+        fir.process(input, output);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(output.size()));
+}
+
+// a biquad over 256 interleaved channels with fixed_num products.
+static void iir_naive(benchmark::State& state)
+{
+    constexpr size_t channels = 256;
+    auto values = random_vecs<vec4<fixed32>>(channels * 64);
+    std::vector<fixed32> input(channels * 256), output(input.size());
+    for(size_t i = 0; i < input.size(); ++i)
+        input[i] = values[i / 4][i % 4];
+    const dsp::biquad_coefficients<fixed32> c{1_f32 / 16, 1_f32 / 8, 1_f32 / 16, -1_f32, 1_f32 / 4};
+    std::vector<fixed32> x1(channels), x2(channels), y1(channels), y2(channels);
+    for(auto _ : state)
+    {
+        for(size_t n = 0; n < input.size() / channels; ++n)
+            for(size_t ch = 0; ch < channels; ++ch)
+            {
+                const auto x = input[n * channels + ch];
+                const auto y = c.b0 * x + c.b1 * x1[ch] + c.b2 * x2[ch] - c.a1 * y1[ch] - c.a2 * y2[ch];
+                output[n * channels + ch] = y;
+                x2[ch] = x1[ch], x1[ch] = x, y2[ch] = y1[ch], y1[ch] = y;
+            }
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+static void iir_block(benchmark::State& state)
+{
+    constexpr size_t channels = 256;
+    auto values = random_vecs<vec4<fixed32>>(channels * 64);
+    std::vector<fixed32> input(channels * 256), output(input.size());
+    for(size_t i = 0; i < input.size(); ++i)
+        input[i] = values[i / 4][i % 4];
+    dsp::iir_filter<fixed32> iir({1_f32 / 16, 1_f32 / 8, 1_f32 / 16, -1_f32, 1_f32 / 4}, channels);
+    for(auto _ : state)
+    {
+        iir.process(input, output);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
 BENCHMARK(taylor_sin);
 BENCHMARK(cordic_sin);
 BENCHMARK(lut_sin);
 BENCHMARK(double_sin);
+BENCHMARK(poly_atan2);
+BENCHMARK(cordic_atan2);
+BENCHMARK(cordic_polar);
+BENCHMARK(double_atan2);
+BENCHMARK(math_exp);
+BENCHMARK(cordic_exp);
+BENCHMARK(math_log);
+BENCHMARK(cordic_log);
+BENCHMARK(math_sqrt);
+BENCHMARK(cordic_sqrt);
+BENCHMARK(cordic_sinh);
+BENCHMARK(cordic_tanh);
+BENCHMARK(turner_log2);
+BENCHMARK(fast_log2);
+BENCHMARK(double_log2);
+BENCHMARK(math_exp2);
+BENCHMARK(double_exp);
+BENCHMARK(math_pow);
+BENCHMARK(double_pow);
+BENCHMARK_TEMPLATE(poly_latency, fixed32, poly_scheme::horner);
+BENCHMARK_TEMPLATE(poly_latency, fixed32, poly_scheme::estrin);
+BENCHMARK_TEMPLATE(poly_latency, fixed64, poly_scheme::horner);
+BENCHMARK_TEMPLATE(poly_latency, fixed64, poly_scheme::estrin);
+BENCHMARK_TEMPLATE(poly_throughput, fixed32, poly_scheme::horner);
+BENCHMARK_TEMPLATE(poly_throughput, fixed32, poly_scheme::estrin);
+BENCHMARK_TEMPLATE(poly_throughput, fixed64, poly_scheme::horner);
+BENCHMARK_TEMPLATE(poly_throughput, fixed64, poly_scheme::estrin);
+BENCHMARK_TEMPLATE(vec_dot, vec3<fixed32>);
+BENCHMARK_TEMPLATE(vec_dot_naive, vec3<fixed32>);
+BENCHMARK_TEMPLATE(vec_dot, vec4<fixed32>);
+BENCHMARK_TEMPLATE(vec_dot_naive, vec4<fixed32>);
+BENCHMARK_TEMPLATE(vec_dot, vec3<fixed64>);
+BENCHMARK_TEMPLATE(vec_dot_naive, vec3<fixed64>);
+BENCHMARK(vec3_cross);
+BENCHMARK(vec4_add);
+BENCHMARK_TEMPLATE(aos_integrate, fixed32);
+BENCHMARK_TEMPLATE(soa_integrate, fixed32);
+BENCHMARK_TEMPLATE(aos_integrate, fixed64);
+BENCHMARK_TEMPLATE(soa_integrate, fixed64);
+BENCHMARK_TEMPLATE(gemm_naive, fixed32)->Arg(64)->Arg(256)->Arg(512)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(gemm_blocked, fixed32)->Args({64, 1})->Args({256, 1})->Args({512, 1})->Args({512, 0})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(gemm_naive, fixed64)->Arg(64)->Arg(256)->Arg(512)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(gemm_blocked, fixed64)->Args({64, 1})->Args({256, 1})->Args({512, 1})->Args({512, 0})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(math_rsqrt, fixed32);
+BENCHMARK_TEMPLATE(inverse_sqrt, fixed32);
+BENCHMARK_TEMPLATE(math_rsqrt, fixed64);
+BENCHMARK_TEMPLATE(inverse_sqrt, fixed64);
+BENCHMARK_TEMPLATE(quat_mul, true);
+BENCHMARK_TEMPLATE(quat_mul, false);
+BENCHMARK(quat_rotate_naive);
+BENCHMARK(quat_rotate_batch);
+BENCHMARK_TEMPLATE(fft_fixed, fixed32)->RangeMultiplier(4)->Range(256, 1 << 20);
+BENCHMARK_TEMPLATE(fft_fixed, fixed64)->RangeMultiplier(4)->Range(256, 1 << 20);
+BENCHMARK(fft_float)->RangeMultiplier(4)->Range(256, 1 << 20);
+BENCHMARK(fir_naive);
+BENCHMARK(fir_block);
+BENCHMARK(iir_naive);
+BENCHMARK(iir_block);
 
 // 参数化基准测试模板
 template <typename SinFunc>
@@ -0,0 +1,370 @@
+#include <eirin/fixed.hpp>
+#include <eirin/math.hpp>
+#include <eirin/convert.hpp>
+#include <eirin/algorithm.hpp>
+#include <eirin/angle.hpp>
+#include <benchmark/benchmark.h>
+#include "bench.hpp"
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+// on windows/msvc, -Wmaybe-uninitialized is not available
+// so we can use #pragma to ignore the warning there
+#ifdef _MSC_VER
+// save warning levels, and drop it to level 3
+#    pragma warning(push, 3)
+// turn two warnings off
+#    pragma warning(disable : 4701 4703)
+#endif
+
+using namespace eirin;
+
+// every benchmark applies one operation to whole arrays of random inputs, instead of a single value read from input.in,
+// so the results are the throughput of the operation with the working set in L1, L2, L3 and the main memory.
+
+template <typename V>
+static V from_double(double x)
+{
+    if constexpr(std::floating_point<V>)
+        return x;
+    else
+        return V::from_internal_value(static_cast<decltype(V().internal_value())>(std::llround(std::ldexp(x, V::precision))));
+}
+
+template <typename V>
+static std::vector<V> random_values(size_t n, double lo, double hi)
+{
+    std::mt19937_64 rng(114514u);
+    std::uniform_real_distribution<double> dist(lo, hi);
+    std::vector<V> res(n);
+    for(auto& v : res)
+        v = from_double<V>(dist(rng));
+    return res;
+}
+
+// the operations with the ranges of their random inputs, inside the domains of fixed32.
+#define EIRIN_THROUGHPUT_UNARY(op_name, expr, lo, hi)     \
+    struct op_name                                        \
+    {                                                     \
+        static constexpr size_t arity = 1;                \
+        static constexpr double range[][2] = {{lo, hi}};  \
+        template <typename V>                             \
+        static V apply(V x)                               \
+        {                                                 \
+            using namespace std;                          \
+            return expr;                                  \
+        }                                                 \
+    };
+
+#define EIRIN_THROUGHPUT_BINARY(op_name, expr, lo1, hi1, lo2, hi2) \
+    struct op_name                                                 \
+    {                                                              \
+        static constexpr size_t arity = 2;                         \
+        static constexpr double range[][2] = {{lo1, hi1}, {lo2, hi2}}; \
+        template <typename V>                                      \
+        static V apply(V x, V y)                                   \
+        {                                                          \
+            using namespace std;                                   \
+            return expr;                                           \
+        }                                                          \
+    };
+
+EIRIN_THROUGHPUT_BINARY(op_add, x + y, -1000, 1000, -1000, 1000)
+EIRIN_THROUGHPUT_BINARY(op_sub, x - y, -1000, 1000, -1000, 1000)
+EIRIN_THROUGHPUT_BINARY(op_mul, x * y, -100, 100, -100, 100)
+EIRIN_THROUGHPUT_BINARY(op_div, x / y, -1000, 1000, 1, 100)
+EIRIN_THROUGHPUT_UNARY(op_sqrt, sqrt(x), 0, 30000)
+EIRIN_THROUGHPUT_UNARY(op_exp, exp(x), -10, 10)
+EIRIN_THROUGHPUT_UNARY(op_log, log(x), 0.001, 30000)
+EIRIN_THROUGHPUT_UNARY(op_log2, log2(x), 0.001, 30000)
+EIRIN_THROUGHPUT_UNARY(op_sin, sin(x), -1000, 1000)
+EIRIN_THROUGHPUT_UNARY(op_cos, cos(x), -1000, 1000)
+EIRIN_THROUGHPUT_UNARY(op_tan, tan(x), -1.5, 1.5)
+EIRIN_THROUGHPUT_UNARY(op_atan, atan(x), -1000, 1000)
+EIRIN_THROUGHPUT_UNARY(op_asin, asin(x), -1, 1)
+EIRIN_THROUGHPUT_UNARY(op_acos, acos(x), -1, 1)
+EIRIN_THROUGHPUT_BINARY(op_atan2, atan2(x, y), -1000, 1000, -1000, 1000)
+EIRIN_THROUGHPUT_BINARY(op_pow, pow(x, y), 0.1, 10, -4, 4)
+
+#undef EIRIN_THROUGHPUT_UNARY
+#undef EIRIN_THROUGHPUT_BINARY
+
+static const char* const level_names[] = {"L1", "L2", "L3", "DRAM"};
+
+// range(0) is the size of the inputs and the outputs in bytes, range(1) is the index in level_names.
+template <typename V, typename Op>
+static void throughput(benchmark::State& state)
+{
+    const auto bytes_per_item = static_cast<int64_t>((Op::arity + 1) * sizeof(V));
+    const auto n = static_cast<size_t>(state.range(0) / bytes_per_item);
+    const auto x = random_values<V>(n, Op::range[0][0], Op::range[0][1]);
+    const auto y = random_values<V>(Op::arity == 2 ? n : 0, Op::range[Op::arity - 1][0], Op::range[Op::arity - 1][1]);
+    std::vector<V> out(n);
+    perf_counters counters(state);
+    for(auto _ : state)
+    {
+        for(size_t i = 0; i < n; ++i)
+        {
+            if constexpr(Op::arity == 1)
+                out[i] = Op::apply(x[i]);
+            else
+                out[i] = Op::apply(x[i], y[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(level_names[state.range(1)]);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(n) * bytes_per_item);
+}
+
+// the working set of a cache level is half of its size, and the one of the main memory is 4 times the last level,
+// clamped to [64 MiB, 512 MiB]. The sizes fall back to 32 KiB, 1 MiB and 16 MiB if the caches are unknown.
+static void cache_sizes(benchmark::internal::Benchmark* b)
+{
+    int64_t sizes[] = {32 << 10, 1 << 20, 16 << 20};
+    for(const auto& cache : benchmark::CPUInfo::Get().caches)
+        if(cache.type != "Instruction" && cache.level >= 1 && cache.level <= 3)
+            sizes[cache.level - 1] = cache.size;
+    for(int64_t level = 0; level < 3; ++level)
+        b->Args({sizes[level] / 2, level});
+    b->Args({std::clamp<int64_t>(4 * sizes[2], int64_t(64) << 20, int64_t(512) << 20), 3});
+}
+
+// the span conversions of convert.hpp against the scalar conversions, range(0) and range(1) as above.
+template <typename Fixed, typename F, bool to_floating, bool bulk>
+static void conversion(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(0) / static_cast<int64_t>(sizeof(Fixed) + sizeof(F)));
+    const auto fixed_values = random_values<Fixed>(n, -1000, 1000);
+    const auto floating_values = random_values<F>(n, -1000, 1000);
+    std::vector<Fixed> fixed_out(n);
+    std::vector<F> floating_out(n);
+    perf_counters counters(state);
+    for(auto _ : state)
+    {
+        if constexpr(to_floating && bulk)
+            eirin::to_floating(std::span<const Fixed>(fixed_values), std::span<F>(floating_out));
+        else if constexpr(to_floating)
+            for(size_t i = 0; i < n; ++i)
+                floating_out[i] = static_cast<F>(fixed_values[i]);
+        else if constexpr(bulk)
+            eirin::from_floating(std::span<const F>(floating_values), std::span<Fixed>(fixed_out));
+        else
+            for(size_t i = 0; i < n; ++i)
+                fixed_out[i] = Fixed(floating_values[i]);
+        benchmark::DoNotOptimize(floating_out.data());
+        benchmark::DoNotOptimize(fixed_out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(level_names[state.range(1)]);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+BENCHMARK_TEMPLATE(conversion, fixed32, float, true, false)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(conversion, fixed32, float, true, true)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(conversion, fixed32, float, false, false)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(conversion, fixed32, float, false, true)->Apply(cache_sizes);
+#ifdef EIRIN_MATH_HAS_INT128
+BENCHMARK_TEMPLATE(conversion, fixed64, double, true, false)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(conversion, fixed64, double, true, true)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(conversion, fixed64, double, false, false)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(conversion, fixed64, double, false, true)->Apply(cache_sizes);
+
+// the repacking of fixed64 arrays into fixed32 ones and back, with the scalar or the span conversions.
+template <typename From, typename To, bool saturate, bool bulk>
+static void format_conversion(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(0) / static_cast<int64_t>(sizeof(From) + sizeof(To)));
+    const auto values = random_values<From>(n, -30000, 30000);
+    std::vector<To> out(n);
+    perf_counters counters(state);
+    for(auto _ : state)
+    {
+        if constexpr(bulk && saturate)
+            convert_saturate(std::span<const From>(values), std::span<To>(out));
+        else if constexpr(bulk)
+            convert(std::span<const From>(values), std::span<To>(out));
+        else if constexpr(saturate)
+            for(size_t i = 0; i < n; ++i)
+                out[i] = convert_saturate<To>(values[i]);
+        else
+            for(size_t i = 0; i < n; ++i)
+                out[i] = To(values[i]);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(level_names[state.range(1)]);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+BENCHMARK_TEMPLATE(format_conversion, fixed64, fixed32, false, false)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(format_conversion, fixed64, fixed32, false, true)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(format_conversion, fixed64, fixed32, true, false)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(format_conversion, fixed64, fixed32, true, true)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(format_conversion, fixed32, fixed64, false, false)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(format_conversion, fixed32, fixed64, false, true)->Apply(cache_sizes);
+#endif
+
+#ifdef EIRIN_MATH_HAS_INT128
+#    define EIRIN_THROUGHPUT_BENCHMARK(op)                               \
+        BENCHMARK_TEMPLATE(throughput, fixed32, op)->Apply(cache_sizes); \
+        BENCHMARK_TEMPLATE(throughput, fixed64, op)->Apply(cache_sizes); \
+        BENCHMARK_TEMPLATE(throughput, double, op)->Apply(cache_sizes)
+#else
+#    define EIRIN_THROUGHPUT_BENCHMARK(op)                               \
+        BENCHMARK_TEMPLATE(throughput, fixed32, op)->Apply(cache_sizes); \
+        BENCHMARK_TEMPLATE(throughput, double, op)->Apply(cache_sizes)
+#endif
+
+EIRIN_THROUGHPUT_BENCHMARK(op_add);
+EIRIN_THROUGHPUT_BENCHMARK(op_sub);
+EIRIN_THROUGHPUT_BENCHMARK(op_mul);
+EIRIN_THROUGHPUT_BENCHMARK(op_div);
+EIRIN_THROUGHPUT_BENCHMARK(op_sqrt);
+EIRIN_THROUGHPUT_BENCHMARK(op_exp);
+EIRIN_THROUGHPUT_BENCHMARK(op_log);
+EIRIN_THROUGHPUT_BENCHMARK(op_log2);
+EIRIN_THROUGHPUT_BENCHMARK(op_sin);
+EIRIN_THROUGHPUT_BENCHMARK(op_cos);
+EIRIN_THROUGHPUT_BENCHMARK(op_tan);
+EIRIN_THROUGHPUT_BENCHMARK(op_atan);
+EIRIN_THROUGHPUT_BENCHMARK(op_asin);
+EIRIN_THROUGHPUT_BENCHMARK(op_acos);
+EIRIN_THROUGHPUT_BENCHMARK(op_atan2);
+EIRIN_THROUGHPUT_BENCHMARK(op_pow);
+
+enum class sort_kind
+{
+    std_sort,
+    radix,
+    parallel_radix
+};
+
+// the sorts of algorithm.hpp against std::sort, on random prices with cents. Every iteration sorts a fresh copy,
+// the copy is included in the times of all the sorts. range(0) and range(1) as above, for the input only.
+template <typename Fixed, sort_kind kind>
+static void sort_throughput(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(0) / static_cast<int64_t>(sizeof(Fixed)));
+    auto values = random_values<Fixed>(n, 0, 30000);
+    for(auto& x : values)
+        x = from_double<Fixed>(std::round(static_cast<double>(x) * 100) / 100);
+    std::vector<Fixed> data(n);
+    perf_counters counters(state);
+    for(auto _ : state)
+    {
+        std::copy(values.begin(), values.end(), data.begin());
+        if constexpr(kind == sort_kind::std_sort)
+            std::sort(data.begin(), data.end());
+        else if constexpr(kind == sort_kind::radix)
+            radix_sort(std::span<Fixed>(data));
+        else
+            parallel_radix_sort(std::span<Fixed>(data));
+        benchmark::DoNotOptimize(data.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(level_names[state.range(1)]);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+// lower_bound and linear_search of algorithm.hpp against std::lower_bound, with random values to search.
+template <typename Fixed, int kind>
+static void search_throughput(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(0) / static_cast<int64_t>(sizeof(Fixed)));
+    auto data = random_values<Fixed>(n, -30000, 30000);
+    std::sort(data.begin(), data.end());
+    const auto queries = random_values<Fixed>(4096, -30000, 30000);
+    const std::span<const Fixed> sorted(data);
+    perf_counters counters(state);
+    for(auto _ : state)
+    {
+        size_t sum = 0;
+        for(const auto& q : queries)
+        {
+            if constexpr(kind == 0)
+                sum += static_cast<size_t>(std::lower_bound(sorted.begin(), sorted.end(), q) - sorted.begin());
+            else if constexpr(kind == 1)
+                sum += eirin::lower_bound(sorted, q);
+            else
+                sum += linear_search(sorted, q);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetLabel(level_names[state.range(1)]);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+}
+
+// sincos of radians, with the range reduction, against sincos of binary angles, scalar and on spans.
+template <typename Fixed, int kind>
+static void angle_throughput(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(0) / static_cast<int64_t>(3 * sizeof(Fixed)));
+    const auto radians = random_values<Fixed>(n, -1000, 1000);
+    std::vector<angle<32>> angles(n);
+    for(size_t i = 0; i < n; ++i)
+        angles[i] = angle<32>::from_radians(radians[i]);
+    std::vector<Fixed> sin_out(n), cos_out(n);
+    perf_counters counters(state);
+    for(auto _ : state)
+    {
+        if constexpr(kind == 2)
+            sincos(std::span<const angle<32>>(angles), std::span<Fixed>(sin_out), std::span<Fixed>(cos_out));
+        else
+        {
+            for(size_t i = 0; i < n; ++i)
+            {
+                const auto [s, c] = kind == 0 ? sincos(radians[i]) : sincos<Fixed>(angles[i]);
+                sin_out[i] = s;
+                cos_out[i] = c;
+            }
+        }
+        benchmark::DoNotOptimize(sin_out.data());
+        benchmark::DoNotOptimize(cos_out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(level_names[state.range(1)]);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+BENCHMARK_TEMPLATE(angle_throughput, fixed32, 0)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(angle_throughput, fixed32, 1)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(angle_throughput, fixed32, 2)->Apply(cache_sizes);
+#ifdef EIRIN_MATH_HAS_INT128
+BENCHMARK_TEMPLATE(angle_throughput, fixed64, 0)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(angle_throughput, fixed64, 1)->Apply(cache_sizes);
+#endif
+
+// linear_search only pays off on short arrays.
+static void short_arrays(benchmark::internal::Benchmark* b)
+{
+    for(int64_t bytes : {64, 256, 1024})
+        b->Args({bytes, 0});
+}
+
+BENCHMARK_TEMPLATE(sort_throughput, fixed32, sort_kind::std_sort)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(sort_throughput, fixed32, sort_kind::radix)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(search_throughput, fixed32, 0)->Apply(cache_sizes)->Apply(short_arrays);
+BENCHMARK_TEMPLATE(search_throughput, fixed32, 1)->Apply(cache_sizes)->Apply(short_arrays);
+BENCHMARK_TEMPLATE(search_throughput, fixed32, 2)->Apply(short_arrays);
+#ifdef EIRIN_MATH_HAS_INT128
+BENCHMARK_TEMPLATE(sort_throughput, fixed64, sort_kind::std_sort)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(sort_throughput, fixed64, sort_kind::radix)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(sort_throughput, fixed64, sort_kind::parallel_radix)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(search_throughput, fixed64, 0)->Apply(cache_sizes)->Apply(short_arrays);
+BENCHMARK_TEMPLATE(search_throughput, fixed64, 1)->Apply(cache_sizes)->Apply(short_arrays);
+BENCHMARK_TEMPLATE(search_throughput, fixed64, 2)->Apply(short_arrays);
+#endif
+
+#ifdef _MSC_VER
+// restore original warning levels.
+#    pragma warning(pop)
+#endif
+
+BENCHMARK_MAIN();
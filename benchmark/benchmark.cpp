@@ -21,6 +21,7 @@ using namespace eirin;
 {
     auto str = get_input("input", "test_key");
     fixed32 fp = 0_f32;
+    perf_counters counters(state);
     for(auto _ : state)
     {
         fixed_from_cstring(str.c_str(), str.size(), fp);
@@ -36,6 +37,7 @@ static void f32_create(benchmark::State& state)
     #ifdef EIRIN_BENCHMARK_FILE_INPUT_MODE
     auto value = get_input("input", "test_create");
     #endif
+    perf_counters counters(state);
     for(auto _ : state)
     {
         #ifdef EIRIN_BENCHMARK_FILE_INPUT_MODE
@@ -58,6 +60,7 @@ static void f32_divide(benchmark::State& state)
     auto fp1 = f32_identity("4.95"_f32);
     auto fp2 = f32_identity("1145.14"_f32);
     #endif
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(fp1 /= fp2);
@@ -75,6 +78,7 @@ static void f32_multiple(benchmark::State& state)
     auto fp1 = "4.95"_f32;
     auto fp2 = f32_identity("1145.14"_f32);
     #endif
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(fp1 *= fp2);
@@ -85,6 +89,7 @@ static void f32_add(benchmark::State& state)
 {
     auto fp1 = "4.95"_f32;
     auto fp2 = f32_identity("1145.14"_f32);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(fp1 += fp2);
@@ -95,6 +100,7 @@ static void f32_minus(benchmark::State& state)
 {
     auto fp1 = "4.95"_f32;
     auto fp2 = f32_identity("1145.14"_f32);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(fp1 -= fp2);
@@ -104,6 +110,7 @@ static void f32_minus(benchmark::State& state)
 static void f32_sqrt(benchmark::State& state)
 {
     auto fp1 = f32_identity("1145.14"_f32);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(sqrt(fp1));
@@ -113,6 +120,7 @@ static void f32_sqrt(benchmark::State& state)
 static void f32_log2(benchmark::State& state)
 {
     auto fp1 = f32_identity("1145.14"_f32);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(log2(fp1));
@@ -122,6 +130,7 @@ static void f32_log2(benchmark::State& state)
 static void f32_log(benchmark::State& state)
 {
     auto fp1 = f32_identity("1145.14"_f32);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(log(fp1));
@@ -131,6 +140,7 @@ static void f32_log(benchmark::State& state)
 static void f32_log10(benchmark::State& state)
 {
     auto fp1 = f32_identity("1145.14"_f32);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(log10(fp1));
@@ -140,6 +150,7 @@ static void f32_log10(benchmark::State& state)
 static void f32_exp(benchmark::State& state)
 {
     auto fp1 = f32_identity("11.4514"_f32);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(exp(fp1));
@@ -150,6 +161,7 @@ static void f32_pow(benchmark::State& state)
 {
     auto fp1 = f32_identity("11.4514"_f32);
     auto fp2 = f32_identity("3.5"_f32);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(pow(fp1, fp2));
@@ -165,6 +177,7 @@ static void f32_sin(benchmark::State& state)
     #else
     auto fp1 = f32_identity("1145.14"_f32);
     #endif
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(sin(fp1));
@@ -174,6 +187,7 @@ static void f32_sin(benchmark::State& state)
 static void f32_cos(benchmark::State& state)
 {
     auto fp1 = f32_identity("1145.14"_f32);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(cos(fp1));
@@ -183,6 +197,7 @@ static void f32_cos(benchmark::State& state)
 static void f32_tan(benchmark::State& state)
 {
     auto fp1 = f32_identity("1145.14"_f32);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(tan(fp1));
@@ -197,6 +212,7 @@ static void f32_atan(benchmark::State& state)
     #else
     auto fp1 = f32_identity("1145.14"_f32);
     #endif
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(atan(fp1));
@@ -206,6 +222,7 @@ static void f32_atan(benchmark::State& state)
 static void f32_asin(benchmark::State& state)
 {
     auto fp1 = f32_identity("0.5"_f32);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(asin(fp1));
@@ -215,6 +232,7 @@ static void f32_asin(benchmark::State& state)
 static void f32_acos(benchmark::State& state)
 {
     auto fp1 = f32_identity("0.5"_f32);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(acos(fp1));
@@ -224,6 +242,7 @@ static void f32_acos(benchmark::State& state)
 static void f32_cordic_sin(benchmark::State& state)
 {
     auto fp1 = f32_identity("1145.14"_f32);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f32_identity(cordic_sine(fp1));
@@ -233,6 +252,7 @@ static void f32_cordic_sin(benchmark::State& state)
 #ifdef EIRIN_MATH_HAS_INT128
 static void f64_create(benchmark::State& state)
 {
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto fp1 = f64_identity(1145.14_f64);
@@ -244,6 +264,7 @@ static void f64_divide(benchmark::State& state)
 {
     auto fp1 = 1145.14_f64;
     auto fp2 = f64_identity("4.95"_f64);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(fp1 /= fp2);
@@ -254,6 +275,7 @@ static void f64_multiple(benchmark::State& state)
 {
     auto fp1 = "1145.14"_f64;
     auto fp2 = f64_identity("4.95"_f64);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(fp1 *= fp2);
@@ -264,6 +286,7 @@ static void f64_add(benchmark::State& state)
 {
     auto fp1 = "1145.14"_f64;
     auto fp2 = f64_identity("4.95"_f64);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(fp1 += fp2);
@@ -274,6 +297,7 @@ static void f64_minus(benchmark::State& state)
 {
     auto fp1 = "1145.14"_f64;
     auto fp2 = f64_identity("4.95"_f64);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(fp1 -= fp2);
@@ -283,6 +307,7 @@ static void f64_minus(benchmark::State& state)
 static void f64_sqrt(benchmark::State& state)
 {
     auto fp1 = f64_identity("1145.14"_f64);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(sqrt(fp1));
@@ -292,6 +317,7 @@ static void f64_sqrt(benchmark::State& state)
 static void f64_log2(benchmark::State& state)
 {
     auto fp1 = f64_identity("1145.14"_f64);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(log2(fp1));
@@ -301,6 +327,7 @@ static void f64_log2(benchmark::State& state)
 static void f64_log(benchmark::State& state)
 {
     auto fp1 = f64_identity("1145.14"_f64);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(log(fp1));
@@ -310,6 +337,7 @@ static void f64_log(benchmark::State& state)
 static void f64_log10(benchmark::State& state)
 {
     auto fp1 = f64_identity("1145.14"_f64);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(log10(fp1));
@@ -319,6 +347,7 @@ static void f64_log10(benchmark::State& state)
 static void f64_exp(benchmark::State& state)
 {
     auto fp1 = f64_identity("11.4514"_f64);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(exp(fp1));
@@ -329,6 +358,7 @@ static void f64_pow(benchmark::State& state)
 {
     auto fp1 = f64_identity("11.4514"_f64);
     auto fp2 = "3.5"_f64;
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(pow(fp1, fp2));
@@ -338,6 +368,7 @@ static void f64_pow(benchmark::State& state)
 static void f64_sin(benchmark::State& state)
 {
     auto fp1 = f64_identity("1145.14"_f64);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(sin(fp1));
@@ -347,6 +378,7 @@ static void f64_sin(benchmark::State& state)
 static void f64_cos(benchmark::State& state)
 {
     auto fp1 = f64_identity("1145.14"_f64);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(cos(fp1));
@@ -356,6 +388,7 @@ static void f64_cos(benchmark::State& state)
 static void f64_tan(benchmark::State& state)
 {
     auto fp1 = f64_identity("1145.14"_f64);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(tan(fp1));
@@ -370,6 +403,7 @@ static void f64_atan(benchmark::State& state)
     #else
     auto fp1 = f64_identity("0.5"_f64);
     #endif
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(atan(fp1));
@@ -379,6 +413,7 @@ static void f64_atan(benchmark::State& state)
 static void f64_asin(benchmark::State& state)
 {
     auto fp1 = f64_identity("0.5"_f64);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(asin(fp1));
@@ -388,6 +423,7 @@ static void f64_asin(benchmark::State& state)
 static void f64_acos(benchmark::State& state)
 {
     auto fp1 = f64_identity("0.5"_f64);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(acos(fp1));
@@ -397,6 +433,7 @@ static void f64_acos(benchmark::State& state)
 static void f64_cordic_sin(benchmark::State& state)
 {
     auto fp1 = f64_identity("1145.14"_f64);
+    perf_counters counters(state);
     for(auto _ : state)
     {
         f64_identity(cordic_sine(fp1));
@@ -6,6 +6,7 @@ using namespace std;
 
 static void double_create(benchmark::State& state)
 {
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto fp1 = db_identity(1145.14);
@@ -16,6 +17,7 @@ static void double_create(benchmark::State& state)
 static void double_divide(benchmark::State& state)
 {
     auto d2 = 4.95;
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto d1 = 1145.14;
@@ -26,6 +28,7 @@ static void double_divide(benchmark::State& state)
 static void double_multiple(benchmark::State& state)
 {
     auto d2 = 4.95;
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto d1 = 1145.14;
@@ -36,6 +39,7 @@ static void double_multiple(benchmark::State& state)
 static void double_add(benchmark::State& state)
 {
     auto d2 = 4.95;
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto d1 = 1145.14;
@@ -46,6 +50,7 @@ static void double_add(benchmark::State& state)
 static void double_minus(benchmark::State& state)
 {
     auto d2 = 4.95;
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto d1 = 1145.14;
@@ -55,6 +60,7 @@ static void double_minus(benchmark::State& state)
 
 static void double_sqrt(benchmark::State& state)
 {
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto d1 = 1145.14;
@@ -64,6 +70,7 @@ static void double_sqrt(benchmark::State& state)
 
 static void double_log2(benchmark::State& state)
 {
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto d1 = 1145.14;
@@ -73,6 +80,7 @@ static void double_log2(benchmark::State& state)
 
 static void double_log(benchmark::State& state)
 {
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto d1 = 1145.14;
@@ -82,6 +90,7 @@ static void double_log(benchmark::State& state)
 
 static void double_log10(benchmark::State& state)
 {
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto d1 = 1145.14;
@@ -91,6 +100,7 @@ static void double_log10(benchmark::State& state)
 
 static void double_exp(benchmark::State& state)
 {
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto d1 = 1145.14;
@@ -100,6 +110,7 @@ static void double_exp(benchmark::State& state)
 
 static void double_pow(benchmark::State& state)
 {
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto d1 = 1145.14;
@@ -109,6 +120,7 @@ static void double_pow(benchmark::State& state)
 
 static void double_sin(benchmark::State& state)
 {
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto d1 = 1145.14;
@@ -119,6 +131,7 @@ static void double_sin(benchmark::State& state)
 
 static void double_cos(benchmark::State& state)
 {
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto d1 = 1145.14;
@@ -129,6 +142,7 @@ static void double_cos(benchmark::State& state)
 
 static void double_tan(benchmark::State& state)
 {
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto d1 = 1145.14;
@@ -139,6 +153,7 @@ static void double_tan(benchmark::State& state)
 
 static void double_asin(benchmark::State& state)
 {
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto d1 = 1145.14;
@@ -149,6 +164,7 @@ static void double_asin(benchmark::State& state)
 
 static void double_acos(benchmark::State& state)
 {
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto d1 = 1145.14;
@@ -159,6 +175,7 @@ static void double_acos(benchmark::State& state)
 
 static void double_atan(benchmark::State& state)
 {
+    perf_counters counters(state);
     for(auto _ : state)
     {
         auto d1 = 1145.14;
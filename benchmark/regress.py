@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+"""Performance regression tracking for the Google Benchmark targets.
+
+record:  runs the benchmarks with repetitions and stores the per repetition times as a JSON baseline,
+         keyed by the cpu, the compiler and the compiler flags.
+compare: runs the benchmarks again (or loads a recorded run) and compares every benchmark with the baseline
+         of the same key, with a two sided Mann-Whitney U test on the repetitions. A benchmark regresses if its
+         median is slower than the threshold and the difference is significant, and then the exit code is 1.
+
+Everything is local, only the python standard library is used.
+
+    python3 benchmark/regress.py record build/linux/x86_64/release/eirin_fixed.benchmark
+    python3 benchmark/regress.py compare build/linux/x86_64/release/eirin_fixed.benchmark --threshold 5
+"""
+
+import argparse
+import hashlib
+import json
+import math
+import os
+import platform
+import re
+import shlex
+import statistics
+import subprocess
+import sys
+
+TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def cpu_name():
+    try:
+        with open("/proc/cpuinfo") as f:
+            for line in f:
+                if line.startswith("model name"):
+                    return line.split(":", 1)[1].strip()
+    except OSError:
+        pass
+    return platform.processor() or platform.machine()
+
+
+def compiler_name(cxx):
+    try:
+        out = subprocess.run([cxx, "--version"], capture_output=True, text=True, check=True).stdout
+        return out.splitlines()[0].strip()
+    except (OSError, subprocess.CalledProcessError, IndexError):
+        return cxx
+
+
+def baseline_key(cpu, compiler, flags):
+    slug = re.sub(r"[^A-Za-z0-9.]+", "-", f"{cpu}_{compiler}").strip("-").lower()
+    digest = hashlib.sha1(" ".join(sorted(shlex.split(flags))).encode()).hexdigest()[:8]
+    return f"{slug}-{digest}"
+
+
+def run_benchmarks(binaries, repetitions, metric, extra_args):
+    """Returns {name: [ns per iteration of every repetition]}, the names are prefixed by the binary."""
+    results = {}
+    context = None
+    for binary in binaries:
+        binary = os.path.abspath(binary)
+        command = [binary, f"--benchmark_repetitions={repetitions}", "--benchmark_format=json"] + extra_args
+        print("running", " ".join(command), file=sys.stderr)
+        # the binaries read benchmark_input/ next to them.
+        out = subprocess.run(command, capture_output=True, text=True, check=True, cwd=os.path.dirname(binary)).stdout
+        report = json.loads(out)
+        context = context or report.get("context", {})
+        prefix = os.path.basename(binary)
+        for bench in report.get("benchmarks", []):
+            if bench.get("run_type", "iteration") != "iteration" or "error_occurred" in bench:
+                continue
+            name = f"{prefix}/{bench.get('run_name', bench['name'])}"
+            results.setdefault(name, []).append(bench[metric] * TIME_UNITS[bench.get("time_unit", "ns")])
+    return results, context or {}
+
+
+def mann_whitney_p(a, b):
+    """Two sided p value of the Mann-Whitney U test, normal approximation with tie and continuity corrections."""
+    n1, n2 = len(a), len(b)
+    if n1 == 0 or n2 == 0:
+        return 1.0
+    values = sorted([(x, 0) for x in a] + [(x, 1) for x in b])
+    ranks = [0.0] * len(values)
+    ties = 0.0
+    i = 0
+    while i < len(values):
+        j = i
+        while j + 1 < len(values) and values[j + 1][0] == values[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2 + 1
+        t = j - i + 1
+        ties += t ** 3 - t
+        i = j + 1
+    r1 = sum(rank for rank, (_, group) in zip(ranks, values) if group == 0)
+    u = r1 - n1 * (n1 + 1) / 2
+    n = n1 + n2
+    variance = n1 * n2 / 12 * ((n + 1) - ties / (n * (n - 1)))
+    if variance <= 0:
+        return 1.0
+    z = (abs(u - n1 * n2 / 2) - 0.5) / math.sqrt(variance)
+    return math.erfc(max(z, 0) / math.sqrt(2))
+
+
+def load(path):
+    with open(path) as f:
+        return json.load(f)
+
+
+def measure(args):
+    flags = args.flags if args.flags is not None else os.environ.get("CXXFLAGS", "")
+    compiler = compiler_name(args.cxx)
+    cpu = cpu_name()
+    benchmarks, context = run_benchmarks(args.binaries, args.repetitions, args.metric, args.benchmark_arg or [])
+    return {
+        "key": baseline_key(cpu, compiler, flags),
+        "cpu": cpu,
+        "compiler": compiler,
+        "flags": flags,
+        "metric": args.metric,
+        "context": context,
+        "benchmarks": benchmarks,
+    }
+
+
+def record(args):
+    run = measure(args)
+    path = args.output or os.path.join(args.baseline_dir, run["key"] + ".json")
+    os.makedirs(os.path.dirname(os.path.abspath(path)), exist_ok=True)
+    with open(path, "w") as f:
+        json.dump(run, f, indent=2)
+    print(f"recorded {len(run['benchmarks'])} benchmarks to {path}")
+    return 0
+
+
+def compare(args):
+    contender = load(args.contender) if args.contender else measure(args)
+    baseline_path = args.baseline or os.path.join(args.baseline_dir, contender["key"] + ".json")
+    if not os.path.exists(baseline_path):
+        print(f"no baseline {baseline_path} for {contender['cpu']}, {contender['compiler']}, flags '{contender['flags']}'",
+              file=sys.stderr)
+        return 2
+    baseline = load(baseline_path)
+    if baseline.get("metric") != contender.get("metric"):
+        print(f"the baseline measures {baseline.get('metric')}, the contender {contender.get('metric')}", file=sys.stderr)
+        return 2
+
+    regressions = 0
+    print(f"{'benchmark':<60} {'baseline':>12} {'contender':>12} {'change':>9} {'p':>8}  result")
+    for name in sorted(set(baseline["benchmarks"]) | set(contender["benchmarks"])):
+        old = baseline["benchmarks"].get(name)
+        new = contender["benchmarks"].get(name)
+        if old is None or new is None:
+            print(f"{name:<60} {'only in the baseline' if new is None else 'new':>25}")
+            continue
+        old_median, new_median = statistics.median(old), statistics.median(new)
+        change = (new_median / old_median - 1) * 100 if old_median > 0 else 0.0
+        p = mann_whitney_p(old, new)
+        result = ""
+        # even fully separated samples are not significant with too few repetitions.
+        if mann_whitney_p(range(len(old)), range(len(old), len(old) + len(new))) >= args.alpha:
+            result = "too few repetitions"
+        if p < args.alpha and change > args.threshold:
+            result = "REGRESSION"
+            regressions += 1
+        elif p < args.alpha and change < -args.threshold:
+            result = "improved"
+        print(f"{name:<60} {old_median:>10.3f}ns {new_median:>10.3f}ns {change:>+8.2f}% {p:>8.4f}  {result}")
+    print(f"{regressions} regression(s) beyond {args.threshold}% at p < {args.alpha}")
+    return 1 if regressions else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    commands = parser.add_subparsers(dest="command", required=True)
+    for name, func in (("record", record), ("compare", compare)):
+        sub = commands.add_parser(name)
+        sub.set_defaults(func=func)
+        sub.add_argument("binaries", nargs="*", help="the benchmark executables")
+        sub.add_argument("--baseline-dir", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "baselines"))
+        sub.add_argument("--repetitions", type=int, default=10)
+        sub.add_argument("--metric", choices=("cpu_time", "real_time"), default="cpu_time")
+        sub.add_argument("--cxx", default=os.environ.get("CXX", "c++"), help="the compiler, a part of the baseline key")
+        sub.add_argument("--flags", help="the compiler flags, a part of the baseline key, CXXFLAGS by default")
+        sub.add_argument("--benchmark-arg", action="append", help="passed to the benchmark executables")
+        if name == "record":
+            sub.add_argument("--output", help="write the run here instead of the baseline of its key")
+        else:
+            sub.add_argument("--baseline", help="the baseline file, instead of the one of the key")
+            sub.add_argument("--contender", help="a recorded run, instead of running the binaries")
+            sub.add_argument("--threshold", type=float, default=5.0, help="the slowdown in percent")
+            sub.add_argument("--alpha", type=float, default=0.01, help="the significance level")
+    args = parser.parse_args()
+    if not args.binaries and not getattr(args, "contender", None):
+        parser.error("no benchmark executables")
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
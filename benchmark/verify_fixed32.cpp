@@ -0,0 +1,117 @@
+#include <eirin/fixed.hpp>
+#include <eirin/math.hpp>
+#include <eirin/detail/perf.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace eirin;
+
+// fixed32 has 2^32 inputs only, so every unary function is checked against the long double reference on every input
+// of its domain, split across all the cores. The process exits with 1 if any function exceeds its error bound,
+// so a faster kernel has to pass this before replacing the current one.
+//
+// usage: eirin_fixed.verify [--function=name] [--threads=n] [--stride=n]
+//   --stride=n checks every n-th input only, for a quick run.
+
+struct verified_function
+{
+    const char* name;
+    // the raw values of the domain, both inclusive.
+    int32_t lo;
+    int32_t hi;
+    // the max error in ULPs, the worst case of the current kernels.
+    double bound;
+    fixed32 (*func)(fixed32);
+    long double (*ref)(long double);
+};
+
+static constexpr int32_t raw_min = std::numeric_limits<int32_t>::min();
+static constexpr int32_t raw_max = std::numeric_limits<int32_t>::max();
+
+static constexpr int32_t raw(double x)
+{
+    return static_cast<int32_t>(x * 65536);
+}
+
+// the reference saturates like the fixed point results, so the overflow of exp is not reported as an error.
+static long double saturate(long double x)
+{
+    return std::clamp(x, std::ldexp(static_cast<long double>(raw_min), -16), std::ldexp(static_cast<long double>(raw_max), -16));
+}
+
+// -x overflows at the min value, so the odd functions start one ULP above it. The bounds of sin and cos are
+// dominated by the range reduction of the large arguments with the fixed32 pi.
+static const verified_function functions[] = {
+    {"sin", raw_min + 1, raw_max, 4400, [](fixed32 x) { return sin(x); }, [](long double x) { return std::sin(x); }},
+    {"cos", raw_min + 1, raw_max, 4400, [](fixed32 x) { return cos(x); }, [](long double x) { return std::cos(x); }},
+    {"tan", raw(-1.4), raw(1.4), 89, [](fixed32 x) { return tan(x); }, [](long double x) { return std::tan(x); }},
+    {"atan", raw_min + 1, raw_max, 1.5, [](fixed32 x) { return atan(x); }, [](long double x) { return std::atan(x); }},
+    {"asin", raw(-1), raw(1), 6, [](fixed32 x) { return asin(x); }, [](long double x) { return std::asin(x); }},
+    {"acos", raw(-1), raw(1), 7, [](fixed32 x) { return acos(x); }, [](long double x) { return std::acos(x); }},
+    {"sqrt", 0, raw_max, 1, [](fixed32 x) { return sqrt(x); }, [](long double x) { return std::sqrt(x); }},
+    {"cbrt", raw_min, raw_max, 0.5, [](fixed32 x) { return cbrt(x); }, [](long double x) { return std::cbrt(x); }},
+    {"exp", raw_min, raw(10.5), 16, [](fixed32 x) { return exp(x); }, [](long double x) { return saturate(std::exp(x)); }},
+    {"exp2", raw_min, raw(15), 16, [](fixed32 x) { return exp2(x); }, [](long double x) { return saturate(std::exp2(x)); }},
+    {"log", 1, raw_max, 4, [](fixed32 x) { return log(x); }, [](long double x) { return std::log(x); }},
+    {"log2", 1, raw_max, 4, [](fixed32 x) { return log2(x); }, [](long double x) { return std::log2(x); }},
+    {"log10", 1, raw_max, 2, [](fixed32 x) { return log10(x); }, [](long double x) { return std::log10(x); }},
+    {"fast_log2", 1, raw_max, 1, [](fixed32 x) { return fast_log2(x); }, [](long double x) { return std::log2(x); }},
+};
+
+int main(int argc, char** argv)
+{
+    std::string only;
+    unsigned int threads = 0;
+    uint64_t stride = 1;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if(arg.rfind("--function=", 0) == 0)
+            only = arg.substr(11);
+        else if(arg.rfind("--threads=", 0) == 0)
+            threads = static_cast<unsigned int>(std::stoul(arg.substr(10)));
+        else if(arg.rfind("--stride=", 0) == 0)
+            stride = std::max<uint64_t>(1, std::stoull(arg.substr(9)));
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--function=name] [--threads=n] [--stride=n]\n";
+            return 1;
+        }
+    }
+
+    bool passed = true, found = false;
+    std::printf("%-10s %12s %12s %10s %10s %22s %8s %8s\n", "function", "samples", "max_ulp", "mean_ulp", "rms_ulp", "worst_input", "bound",
+                "result");
+    for(const auto& fn : functions)
+    {
+        if(!only.empty() && only != fn.name)
+            continue;
+        found = true;
+        const auto start = std::chrono::steady_clock::now();
+        // with stride 1 the evenly spaced inputs are every raw value of the domain.
+        const uint64_t count = static_cast<uint64_t>(static_cast<int64_t>(fn.hi) - fn.lo) / stride + 1;
+        const auto lo = fixed32::from_internal_value(fn.lo);
+        const auto hi = fixed32::from_internal_value(static_cast<int32_t>(fn.lo + static_cast<int64_t>((count - 1) * stride)));
+        const auto stats = perf::measure_error(lo, hi, count, fn.func, fn.ref, threads);
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const bool ok = stats.max_ulp <= fn.bound;
+        passed = passed && ok;
+        std::printf("%-10s %12llu %12.6g %10.4g %10.4g %22.10Lf %8g %8s (%.1fs)\n", fn.name, static_cast<unsigned long long>(stats.samples),
+                    stats.max_ulp, stats.mean_ulp(), stats.rms_ulp(), stats.max_ulp_input, fn.bound, ok ? "PASS" : "FAIL", seconds);
+        std::fflush(stdout);
+    }
+    if(!found)
+    {
+        std::cerr << "unknown function: " << only << '\n';
+        return 1;
+    }
+    return passed ? 0 : 1;
+}
@@ -34,6 +34,50 @@ if has_config("eirin_build_advanced_benchmark") and get_config("eirin_build_adva
             os.cp("$(scriptdir)/*.in", target:targetdir() .. "/benchmark_input/")
         end)
 
+    target("eirin_fixed.throughput")
+        set_kind("binary")
+        add_includedirs(".", {public = true})
+        add_files("./bench_throughput.cpp", "./bench.cpp")
+        add_deps("eirin_fixed")
+        add_packages("benchmark")
+        -- add -Wmaybe-uninitialized on linux to catch uninitialized variable usage
+        -- to be noticed that in windows/msvc this flag is not available
+        if is_os("linux") then
+            add_cxxflags("-Wmaybe-uninitialized", {force = true})
+        end
+
+    target("eirin_fixed.dataset")
+        set_kind("binary")
+        add_includedirs(".", {public = true})
+        add_files("./bench_dataset.cpp", "./bench.cpp")
+        add_deps("eirin_fixed")
+        add_packages("benchmark")
+        -- add -Wmaybe-uninitialized on linux to catch uninitialized variable usage
+        -- to be noticed that in windows/msvc this flag is not available
+        if is_os("linux") then
+            add_cxxflags("-Wmaybe-uninitialized", {force = true})
+        end
+
+    target("eirin_fixed.pareto")
+        set_kind("binary")
+        add_includedirs(".", {public = true})
+        add_files("./bench_pareto.cpp", "./bench.cpp")
+        add_deps("eirin_fixed")
+        add_packages("benchmark")
+        -- add -Wmaybe-uninitialized on linux to catch uninitialized variable usage
+        -- to be noticed that in windows/msvc this flag is not available
+        if is_os("linux") then
+            add_cxxflags("-Wmaybe-uninitialized", {force = true})
+        end
+
+    target("eirin_fixed.verify")
+        set_kind("binary")
+        add_files("./verify_fixed32.cpp")
+        add_deps("eirin_fixed")
+        if is_os("linux") then
+            add_syslinks("pthread")
+        end
+
     target("eirin_fixed.accuracy")
         set_kind("binary")
         add_includedirs(".", {public = true})
@@ -0,0 +1,419 @@
+#ifndef EIRIN_MATH_ALGORITHM_HPP
+#define EIRIN_MATH_ALGORITHM_HPP
+
+#pragma once
+
+#include "fixed.hpp"
+#include "error.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+#    include <immintrin.h>
+#endif
+
+namespace eirin
+{
+namespace detail
+{
+    // the raw values are sorted as unsigned keys of 8 bits digits, with the sign bit flipped so the negative values come first.
+    inline constexpr unsigned int radix_bits = 8;
+    inline constexpr size_t radix_buckets = size_t(1) << radix_bits;
+    // below this size the histograms cost more than an insertion sort.
+    inline constexpr size_t radix_min_size = 64;
+    // below this size the partition is not worth the threads.
+    inline constexpr size_t radix_parallel_min_size = size_t(1) << 16;
+
+    template <typename Fixed>
+    concept radix_sortable = std::is_integral_v<typename Fixed::value_type> && sizeof(typename Fixed::value_type) <= sizeof(uint64_t);
+
+    template <typename Fixed>
+    inline constexpr unsigned int radix_passes = sizeof(typename Fixed::value_type) * 8 / radix_bits;
+
+    template <typename Fixed>
+    EIRIN_ALWAYS_INLINE constexpr size_t radix_digit(Fixed x, unsigned int pass) noexcept
+    {
+        using key = std::make_unsigned_t<typename Fixed::value_type>;
+        constexpr key sign = key(1) << (sizeof(key) * 8 - 1);
+        return static_cast<size_t>(((static_cast<key>(x.internal_value()) ^ sign) >> (pass * radix_bits)) & (radix_buckets - 1));
+    }
+
+    // marks the keys only sorts, so the same kernels serve the key-value sorts.
+    struct no_values
+    {
+    };
+
+    template <typename Fixed, typename V>
+    void insertion_sort(Fixed* keys, V* values, size_t n)
+    {
+        for(size_t i = 1; i < n; ++i)
+        {
+            const Fixed key = keys[i];
+            size_t j = i;
+            if constexpr(std::is_same_v<V, no_values>)
+            {
+                for(; j > 0 && key < keys[j - 1]; --j)
+                    keys[j] = keys[j - 1];
+            }
+            else
+            {
+                V value = std::move(values[i]);
+                for(; j > 0 && key < keys[j - 1]; --j)
+                {
+                    keys[j] = keys[j - 1];
+                    values[j] = std::move(values[j - 1]);
+                }
+                values[j] = std::move(value);
+            }
+            keys[j] = key;
+        }
+    }
+
+    /**
+     * @brief Stable LSD radix sort of keys[0, n) and their values by the digits [0, passes), the higher digits must be equal.
+     * The passes with a single used bucket are skipped, the others move the elements between the arrays and the buffers.
+     *
+     * @return true if the sorted elements end up in the buffers, false if they are in keys and values.
+     */
+    template <typename Fixed, typename V>
+    bool radix_sort_passes(Fixed* keys, Fixed* key_buffer, V* values, V* value_buffer, size_t n, unsigned int passes)
+    {
+        constexpr bool has_values = !std::is_same_v<V, no_values>;
+        if(n < radix_min_size)
+        {
+            insertion_sort(keys, values, n);
+            return false;
+        }
+
+        // the histograms of all the digits in one read of the keys.
+        std::array<std::array<size_t, radix_buckets>, radix_passes<Fixed>> counts{};
+        for(size_t i = 0; i < n; ++i)
+            for(unsigned int p = 0; p < passes; ++p)
+                ++counts[p][radix_digit(keys[i], p)];
+
+        bool swapped = false;
+        for(unsigned int p = 0; p < passes; ++p)
+        {
+            auto& offsets = counts[p];
+            if(offsets[radix_digit(keys[0], p)] == n)
+                continue;
+            size_t sum = 0;
+            for(auto& c : offsets)
+            {
+                const size_t count = c;
+                c = sum;
+                sum += count;
+            }
+            for(size_t i = 0; i < n; ++i)
+            {
+                const size_t dst = offsets[radix_digit(keys[i], p)]++;
+                key_buffer[dst] = keys[i];
+                if constexpr(has_values)
+                    value_buffer[dst] = std::move(values[i]);
+            }
+            std::swap(keys, key_buffer);
+            if constexpr(has_values)
+                std::swap(values, value_buffer);
+            swapped = !swapped;
+        }
+        return swapped;
+    }
+
+    template <typename Fixed, typename V>
+    void radix_sort(Fixed* keys, V* values, size_t n)
+    {
+        constexpr bool has_values = !std::is_same_v<V, no_values>;
+        if(n < radix_min_size)
+        {
+            insertion_sort(keys, values, n);
+            return;
+        }
+        std::vector<Fixed> key_buffer(n);
+        std::vector<std::conditional_t<has_values, V, no_values>> value_buffer(has_values ? n : 0);
+        if(radix_sort_passes(keys, key_buffer.data(), values, value_buffer.data(), n, radix_passes<Fixed>))
+        {
+            std::copy(key_buffer.begin(), key_buffer.end(), keys);
+            if constexpr(has_values)
+                std::move(value_buffer.begin(), value_buffer.end(), values);
+        }
+    }
+
+    /**
+     * @brief Partitions the elements by their highest digit which is not the same for all of them, in parallel over contiguous chunks,
+     *        then sorts the buckets by the lower digits, every thread taking the next unsorted bucket.
+     * The scatter keeps the order of the chunks, so the result is the same as the one of the sequential sort.
+     */
+    template <typename Fixed, typename V>
+    void parallel_radix_sort(Fixed* keys, V* values, size_t n, unsigned int threads)
+    {
+        constexpr bool has_values = !std::is_same_v<V, no_values>;
+        constexpr unsigned int passes = radix_passes<Fixed>;
+        if(threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        if(threads == 1 || n < radix_parallel_min_size)
+        {
+            radix_sort(keys, values, n);
+            return;
+        }
+
+        const size_t workers = std::min<size_t>(threads, n / radix_min_size);
+        auto run = [workers](auto&& task)
+        {
+            std::vector<std::thread> pool;
+            pool.reserve(workers - 1);
+            for(size_t w = 1; w < workers; ++w)
+                pool.emplace_back(task, w);
+            task(size_t(0));
+            for(auto& t : pool)
+                t.join();
+        };
+        auto chunk_begin = [n, workers](size_t w) { return n * w / workers; };
+
+        // the histograms of every chunk, for all the digits.
+        std::vector<std::array<std::array<size_t, radix_buckets>, passes>> counts(workers);
+        run(
+            [&](size_t w)
+            {
+                auto& count = counts[w];
+                for(auto& c : count)
+                    c.fill(0);
+                for(size_t i = chunk_begin(w), end = chunk_begin(w + 1); i < end; ++i)
+                    for(unsigned int p = 0; p < passes; ++p)
+                        ++count[p][radix_digit(keys[i], p)];
+            });
+
+        // the highest digit used by more than one bucket, the digits above it are the same for all the elements.
+        unsigned int digit = passes;
+        while(digit > 0)
+        {
+            --digit;
+            size_t total = 0;
+            for(size_t w = 0; w < workers; ++w)
+                total += counts[w][digit][radix_digit(keys[0], digit)];
+            if(total != n)
+                break;
+            if(digit == 0)
+                return;
+        }
+
+        // the offsets of every chunk in every bucket, and the bounds of the buckets.
+        std::array<size_t, radix_buckets + 1> bounds{};
+        size_t sum = 0;
+        for(size_t b = 0; b < radix_buckets; ++b)
+        {
+            bounds[b] = sum;
+            for(size_t w = 0; w < workers; ++w)
+            {
+                const size_t count = counts[w][digit][b];
+                counts[w][digit][b] = sum;
+                sum += count;
+            }
+        }
+        bounds[radix_buckets] = n;
+
+        std::vector<Fixed> key_buffer(n);
+        std::vector<std::conditional_t<has_values, V, no_values>> value_buffer(has_values ? n : 0);
+        run(
+            [&](size_t w)
+            {
+                auto& offsets = counts[w][digit];
+                for(size_t i = chunk_begin(w), end = chunk_begin(w + 1); i < end; ++i)
+                {
+                    const size_t dst = offsets[radix_digit(keys[i], digit)]++;
+                    key_buffer[dst] = keys[i];
+                    if constexpr(has_values)
+                        value_buffer[dst] = std::move(values[i]);
+                }
+            });
+
+        // the buckets are sorted in the buffers with the arrays as their scratch space, then moved back if needed.
+        std::atomic<size_t> next_bucket = 0;
+        run(
+            [&](size_t)
+            {
+                for(size_t b = next_bucket++; b < radix_buckets; b = next_bucket++)
+                {
+                    const size_t begin = bounds[b], size = bounds[b + 1] - begin;
+                    if(size == 0)
+                        continue;
+                    auto* bucket_values = has_values ? value_buffer.data() + begin : value_buffer.data();
+                    auto* scratch_values = has_values ? values + begin : values;
+                    if(!radix_sort_passes(key_buffer.data() + begin, keys + begin, bucket_values, scratch_values, size, digit))
+                    {
+                        std::copy_n(key_buffer.data() + begin, size, keys + begin);
+                        if constexpr(has_values)
+                            std::move(bucket_values, bucket_values + size, values + begin);
+                    }
+                }
+            });
+    }
+
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+    template <typename Fixed>
+    inline constexpr bool avx_searchable =
+        std::is_same_v<typename Fixed::value_type, int32_t> || std::is_same_v<typename Fixed::value_type, int64_t>;
+
+    // the mask of the lanes of data[0, lanes) less than the value, one bit per lane.
+    template <typename Fixed>
+    EIRIN_ALWAYS_INLINE unsigned int avx_less_mask(const Fixed* data, __m256i value) noexcept
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        if constexpr(std::is_same_v<typename Fixed::value_type, int32_t>)
+            return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(value, v))));
+        else
+            return static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(value, v))));
+    }
+
+    template <typename Fixed>
+    EIRIN_ALWAYS_INLINE __m256i avx_broadcast(Fixed value) noexcept
+    {
+        if constexpr(std::is_same_v<typename Fixed::value_type, int32_t>)
+            return _mm256_set1_epi32(value.internal_value());
+        else
+            return _mm256_set1_epi64x(value.internal_value());
+    }
+#endif
+
+    // the number of elements of data[0, n) less than the value.
+    template <typename Fixed>
+    EIRIN_ALWAYS_INLINE size_t count_less(const Fixed* data, size_t n, Fixed value) noexcept
+    {
+        size_t count = 0, i = 0;
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+        if constexpr(avx_searchable<Fixed>)
+        {
+            constexpr size_t lanes = 32 / sizeof(Fixed);
+            const __m256i v = avx_broadcast(value);
+            for(; i + lanes <= n; i += lanes)
+                count += static_cast<size_t>(std::popcount(avx_less_mask(data + i, v)));
+        }
+#endif
+        for(; i < n; ++i)
+            count += data[i] < value;
+        return count;
+    }
+} // namespace detail
+
+/**
+ * @brief Sort the fixed numbers in ascending order with a LSD radix sort of their raw values,
+ *        which skips the digits shared by all of them, e.g. the high bytes of small prices.
+ * It allocates a buffer of the same size as data.
+ */
+template <typename T, typename I, unsigned int f, bool r>
+    requires detail::radix_sortable<fixed_num<T, I, f, r>>
+inline void radix_sort(std::span<fixed_num<T, I, f, r>> data)
+{
+    detail::radix_sort(data.data(), static_cast<detail::no_values*>(nullptr), data.size());
+}
+
+/**
+ * @brief Sort the keys in ascending order and apply the same permutation to the values.
+ * The sort is stable, the values of equal keys keep their order.
+ *
+ * @throw std::invalid_argument if keys.size() != values.size().
+ */
+template <typename T, typename I, unsigned int f, bool r, typename V>
+    requires detail::radix_sortable<fixed_num<T, I, f, r>>
+inline void radix_sort(std::span<fixed_num<T, I, f, r>> keys, std::span<V> values)
+{
+    if(keys.size() != values.size())
+        EIRIN_THROW_EXCEPTION(std::invalid_argument, "radix_sort() requires keys.size() == values.size()");
+    detail::radix_sort(keys.data(), values.data(), keys.size());
+}
+
+/**
+ * @brief radix_sort() with the elements partitioned by their highest distinct digit over a number of threads,
+ *        and the partitions sorted by the lower digits in parallel. The result is the same as the one of radix_sort().
+ * Small inputs are sorted in the calling thread.
+ *
+ * @param threads the number of threads, 0 uses std::thread::hardware_concurrency().
+ */
+template <typename T, typename I, unsigned int f, bool r>
+    requires detail::radix_sortable<fixed_num<T, I, f, r>>
+inline void parallel_radix_sort(std::span<fixed_num<T, I, f, r>> data, unsigned int threads = 0)
+{
+    detail::parallel_radix_sort(data.data(), static_cast<detail::no_values*>(nullptr), data.size(), threads);
+}
+
+/**
+ * @brief The key-value radix_sort() over a number of threads, stable like the sequential one.
+ *
+ * @param threads the number of threads, 0 uses std::thread::hardware_concurrency().
+ * @throw std::invalid_argument if keys.size() != values.size().
+ */
+template <typename T, typename I, unsigned int f, bool r, typename V>
+    requires detail::radix_sortable<fixed_num<T, I, f, r>>
+inline void parallel_radix_sort(std::span<fixed_num<T, I, f, r>> keys, std::span<V> values, unsigned int threads = 0)
+{
+    if(keys.size() != values.size())
+        EIRIN_THROW_EXCEPTION(std::invalid_argument, "parallel_radix_sort() requires keys.size() == values.size()");
+    detail::parallel_radix_sort(keys.data(), values.data(), keys.size(), threads);
+}
+
+/**
+ * @brief The index of the first element of the sorted data which is not less than the value, or data.size() if there is none.
+ * A branchless binary search narrows the range down to a few vectors, which are compared all at once with AVX2.
+ * With AVX2 both possible next midpoints are prefetched, so the searches of large arrays wait for one cache miss per step at most.
+ */
+template <typename T, typename I, unsigned int f, bool r>
+inline size_t lower_bound(std::span<const fixed_num<T, I, f, r>> data, fixed_num<T, I, f, r> value) noexcept
+{
+    constexpr size_t window = 64 / sizeof(T);
+    const fixed_num<T, I, f, r>* base = data.data();
+    size_t len = data.size();
+    // the result stays in [base, base + len].
+    while(len > window)
+    {
+        const size_t half = len / 2;
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+        // the midpoints of both halves, one of them is read by the next step.
+        _mm_prefetch(reinterpret_cast<const char*>(base + half / 2), _MM_HINT_T0);
+        _mm_prefetch(reinterpret_cast<const char*>(base + half + half / 2), _MM_HINT_T0);
+#endif
+        base = base[half] < value ? base + half : base;
+        len -= half;
+    }
+    return static_cast<size_t>(base - data.data()) + detail::count_less(base, len, value);
+}
+
+/**
+ * @brief The index of the first element of the sorted data which is not less than the value, or data.size() if there is none,
+ *        found by a linear scan, a vector at a time with AVX2. It beats lower_bound() on short arrays only.
+ */
+template <typename T, typename I, unsigned int f, bool r>
+inline size_t linear_search(std::span<const fixed_num<T, I, f, r>> data, fixed_num<T, I, f, r> value) noexcept
+{
+    const size_t n = data.size();
+    size_t i = 0;
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+    if constexpr(detail::avx_searchable<fixed_num<T, I, f, r>>)
+    {
+        constexpr size_t lanes = 32 / sizeof(T);
+        constexpr unsigned int all = (1u << lanes) - 1;
+        const __m256i v = detail::avx_broadcast(value);
+        for(; i + lanes <= n; i += lanes)
+        {
+            const unsigned int less = detail::avx_less_mask(data.data() + i, v);
+            if(less != all)
+                return i + static_cast<size_t>(std::countr_zero(~less));
+        }
+    }
+#endif
+    for(; i < n && data[i] < value; ++i)
+    {
+    }
+    return i;
+}
+} // namespace eirin
+
+#endif
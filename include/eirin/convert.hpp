@@ -0,0 +1,338 @@
+#ifndef EIRIN_CONVERT_HPP
+#define EIRIN_CONVERT_HPP
+
+#pragma once
+
+#include "fixed.hpp"
+#include "error.hpp"
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+#    include <immintrin.h>
+#endif
+
+namespace eirin
+{
+namespace detail
+{
+    // the AVX2 kernels convert 32 bits raw values from and to float, and 64 bits raw values from and to double.
+    template <typename Fixed, typename F>
+    inline constexpr bool avx_convertible =
+        (std::is_same_v<typename Fixed::value_type, int32_t> && std::is_same_v<F, float>) ||
+        (std::is_same_v<typename Fixed::value_type, int64_t> && std::is_same_v<F, double>);
+
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+    /**
+     * @brief int64 to double of 4 lanes, rounded to nearest like the scalar conversion.
+     * hi * 2^32 and lo are built exactly with magic exponents, so their sum is the only rounding.
+     */
+    EIRIN_ALWAYS_INLINE __m256d avx_mm256_cvtepi64_pd(__m256i v)
+    {
+        // 2^52 + lo, and 2^84 + 2^63 + hi * 2^32, where the xor turns the unsigned hi into a signed one.
+        const __m256i lo = _mm256_blend_epi32(_mm256_set1_epi64x(0x4330000000000000), v, 0x55);
+        const __m256i hi = _mm256_xor_si256(_mm256_srli_epi64(v, 32), _mm256_set1_epi64x(0x4530000080000000));
+        const __m256d hi_d = _mm256_sub_pd(_mm256_castsi256_pd(hi), _mm256_castsi256_pd(_mm256_set1_epi64x(0x4530000080100000)));
+        return _mm256_add_pd(hi_d, _mm256_castsi256_pd(lo));
+    }
+
+    /**
+     * @brief Integral doubles in [-2^63, 2^63) to int64 of 4 lanes, exactly, as AVX2 has no such conversion.
+     * Below 2^51 in magnitude, the mantissa of x + 1.5 * 2^52 is x offset by the same bits of the magic number,
+     * and the larger values are split into hi * 2^32 + lo with |lo| <= 2^31, and both parts are converted this way.
+     */
+    EIRIN_ALWAYS_INLINE __m256i avx_mm256_cvtintpd_epi64(__m256d t)
+    {
+        const __m256d magic = _mm256_set1_pd(0x1.8p52);
+        const __m256d abs_t = _mm256_andnot_pd(_mm256_set1_pd(-0.0), t);
+        if(_mm256_movemask_pd(_mm256_cmp_pd(abs_t, _mm256_set1_pd(0x1p51), _CMP_GE_OQ)) == 0) [[likely]]
+            return _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(t, magic)), _mm256_castpd_si256(magic));
+        const __m256d hi_magic = _mm256_add_pd(_mm256_mul_pd(t, _mm256_set1_pd(0x1p-32)), magic);
+        const __m256d hi = _mm256_sub_pd(hi_magic, magic);
+        // exact, the difference is an integer below 2^31 in magnitude.
+        const __m256d lo = _mm256_sub_pd(t, _mm256_mul_pd(hi, _mm256_set1_pd(0x1p32)));
+        const __m256i hi_i = _mm256_sub_epi64(_mm256_castpd_si256(hi_magic), _mm256_castpd_si256(magic));
+        const __m256i lo_i = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(lo, magic)), _mm256_castpd_si256(magic));
+        return _mm256_add_epi64(_mm256_slli_epi64(hi_i, 32), lo_i);
+    }
+
+    template <typename Fixed, typename F>
+    EIRIN_ALWAYS_INLINE void avx_to_floating(const Fixed* in, F* out, size_t n, size_t& i)
+    {
+        if constexpr(std::is_same_v<F, float>)
+        {
+            const __m256 scale = _mm256_set1_ps(static_cast<float>(Fixed::from_internal_value(1)));
+            for(; i + 8 <= n; i += 8)
+            {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+            }
+        }
+        else
+        {
+            const __m256d scale = _mm256_set1_pd(static_cast<double>(Fixed::from_internal_value(1)));
+            for(; i + 4 <= n; i += 4)
+            {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                _mm256_storeu_pd(out + i, _mm256_mul_pd(avx_mm256_cvtepi64_pd(v), scale));
+            }
+        }
+    }
+
+    template <typename Fixed, typename F, bool rounding>
+    EIRIN_ALWAYS_INLINE void avx_from_floating(const F* in, Fixed* out, size_t n, size_t& i)
+    {
+        // the truncation toward zero of the scalar constructor, then +-1 where the dropped fraction is at least one half.
+        // the compare masks are -1, so they are subtracted for the round up.
+        if constexpr(std::is_same_v<F, float>)
+        {
+            const __m256 scale = _mm256_set1_ps(1.0f / static_cast<float>(Fixed::from_internal_value(1)));
+            for(; i + 8 <= n; i += 8)
+            {
+                const __m256 s = _mm256_mul_ps(_mm256_loadu_ps(in + i), scale);
+                __m256i v = _mm256_cvttps_epi32(s);
+                if constexpr(rounding)
+                {
+                    const __m256 dropped = _mm256_sub_ps(s, _mm256_round_ps(s, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+                    v = _mm256_sub_epi32(v, _mm256_castps_si256(_mm256_cmp_ps(dropped, _mm256_set1_ps(0.5f), _CMP_GE_OQ)));
+                    v = _mm256_add_epi32(v, _mm256_castps_si256(_mm256_cmp_ps(dropped, _mm256_set1_ps(-0.5f), _CMP_LE_OQ)));
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+            }
+        }
+        else
+        {
+            const __m256d scale = _mm256_set1_pd(1.0 / static_cast<double>(Fixed::from_internal_value(1)));
+            for(; i + 4 <= n; i += 4)
+            {
+                const __m256d s = _mm256_mul_pd(_mm256_loadu_pd(in + i), scale);
+                const __m256d t = _mm256_round_pd(s, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+                __m256i v = avx_mm256_cvtintpd_epi64(t);
+                if constexpr(rounding)
+                {
+                    const __m256d dropped = _mm256_sub_pd(s, t);
+                    v = _mm256_sub_epi64(v, _mm256_castpd_si256(_mm256_cmp_pd(dropped, _mm256_set1_pd(0.5), _CMP_GE_OQ)));
+                    v = _mm256_add_epi64(v, _mm256_castpd_si256(_mm256_cmp_pd(dropped, _mm256_set1_pd(-0.5), _CMP_LE_OQ)));
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+            }
+        }
+    }
+
+    /**
+     * @brief The arithmetic shift right of int64 lanes, which AVX2 lacks, the sign bits are or-ed in from a compare.
+     */
+    template <unsigned int k>
+    EIRIN_ALWAYS_INLINE __m256i avx_mm256_srai_epi64(__m256i v)
+    {
+        if constexpr(k == 0)
+            return v;
+        else
+            return _mm256_or_si256(_mm256_srli_epi64(v, k), _mm256_slli_epi64(_mm256_cmpgt_epi64(_mm256_setzero_si256(), v), 64 - k));
+    }
+
+    /**
+     * @brief ``shift_right_trunc`` or ``shift_right_round`` of int64 lanes.
+     */
+    template <unsigned int k, bool rounding>
+    EIRIN_ALWAYS_INLINE __m256i avx_mm256_shift_right_epi64(__m256i v)
+    {
+        constexpr unsigned int t = rounding ? k - 1 : k;
+        const __m256i zero = _mm256_setzero_si256();
+        if constexpr(t > 0)
+        {
+            const __m256i bias = _mm256_and_si256(_mm256_cmpgt_epi64(zero, v), _mm256_set1_epi64x(~(int64_t(-1) << t)));
+            v = avx_mm256_srai_epi64<t>(_mm256_add_epi64(v, bias));
+        }
+        if constexpr(rounding)
+        {
+            const __m256i odd = _mm256_and_si256(_mm256_and_si256(v, _mm256_set1_epi64x(1)), _mm256_cmpgt_epi64(v, zero));
+            v = _mm256_add_epi64(avx_mm256_srai_epi64<1>(v), odd);
+        }
+        return v;
+    }
+
+    /**
+     * @brief Fixed to fixed conversions of whole arrays, int32 raw values widened to int64, and int64 raw values
+     *        narrowed to int32 with fewer fraction bits, optionally saturated. The other formats are left to the scalar loop.
+     */
+    template <typename To, typename From, bool saturate>
+    EIRIN_ALWAYS_INLINE void avx_convert(const From* in, To* out, size_t n, size_t& i)
+    {
+        using from_value = typename From::value_type;
+        using to_value = typename To::value_type;
+        constexpr unsigned int f = From::precision, f2 = To::precision;
+        // the shift is exact in int64, and the widened value cannot leave the range below 32 more fraction bits.
+        if constexpr(std::is_same_v<from_value, int32_t> && std::is_same_v<to_value, int64_t> && f2 >= f && (!saturate || f2 - f <= 32))
+        {
+            for(; i + 4 <= n; i += 4)
+            {
+                const __m256i v = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_slli_epi64(v, f2 - f));
+            }
+        }
+        else if constexpr(std::is_same_v<from_value, int64_t> && std::is_same_v<to_value, int32_t> && f >= f2)
+        {
+            const __m256i max = _mm256_set1_epi64x(std::numeric_limits<int32_t>::max());
+            const __m256i min = _mm256_set1_epi64x(std::numeric_limits<int32_t>::min());
+            const __m256i low_halves = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+            for(; i + 4 <= n; i += 4)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                if constexpr(f > f2)
+                    v = avx_mm256_shift_right_epi64<f - f2, To::is_rounding>(v);
+                if constexpr(saturate)
+                {
+                    v = _mm256_blendv_epi8(v, max, _mm256_cmpgt_epi64(v, max));
+                    v = _mm256_blendv_epi8(v, min, _mm256_cmpgt_epi64(min, v));
+                }
+                // the static_cast to int32 keeps the low halves.
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(v, low_halves)));
+            }
+        }
+    }
+#endif
+} // namespace detail
+
+/**
+ * @brief out[i] = static_cast<F>(in[i]), bit-identical to the scalar conversion.
+ * With AVX2, fixed numbers with 32 bits store types are converted 8 lanes at a time to float,
+ * and the ones with 64 bits store types 4 lanes at a time to double.
+ *
+ * @throw std::invalid_argument if in.size() != out.size().
+ */
+template <std::floating_point F, typename T, typename I, unsigned int f, bool r>
+inline void to_floating(std::span<const fixed_num<T, I, f, r>> in, std::span<F> out)
+{
+    if(in.size() != out.size())
+        EIRIN_THROW_EXCEPTION(std::invalid_argument, "to_floating() requires in.size() == out.size()");
+    const size_t n = in.size();
+    size_t i = 0;
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+    if constexpr(detail::avx_convertible<fixed_num<T, I, f, r>, F>)
+        detail::avx_to_floating<fixed_num<T, I, f, r>, F>(in.data(), out.data(), n, i);
+#endif
+    for(; i < n; ++i)
+        out[i] = static_cast<F>(in[i]);
+}
+
+/**
+ * @brief out[i] = fixed(in[i]), bit-identical to the scalar constructor, truncated toward zero
+ *        or rounded half away from zero if the rounding of the fixed number is enabled.
+ * The values must be in the range of the fixed number, like the scalar constructor.
+ *
+ * @throw std::invalid_argument if in.size() != out.size().
+ */
+template <std::floating_point F, typename T, typename I, unsigned int f, bool r>
+inline void from_floating(std::span<const F> in, std::span<fixed_num<T, I, f, r>> out)
+{
+    using fixed = fixed_num<T, I, f, r>;
+    if(in.size() != out.size())
+        EIRIN_THROW_EXCEPTION(std::invalid_argument, "from_floating() requires in.size() == out.size()");
+    const size_t n = in.size();
+    size_t i = 0;
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+    if constexpr(detail::avx_convertible<fixed, F>)
+        detail::avx_from_floating<fixed, F, r>(in.data(), out.data(), n, i);
+#endif
+    for(; i < n; ++i)
+        out[i] = fixed(in[i]);
+}
+
+inline void to_float(std::span<const fixed32> in, std::span<float> out)
+{
+    to_floating(in, out);
+}
+
+inline void from_float(std::span<const float> in, std::span<fixed32> out)
+{
+    from_floating(in, out);
+}
+
+#ifdef EIRIN_MATH_HAS_INT128
+inline void to_double(std::span<const fixed64> in, std::span<double> out)
+{
+    to_floating(in, out);
+}
+
+inline void from_double(std::span<const double> in, std::span<fixed64> out)
+{
+    from_floating(in, out);
+}
+#endif
+
+/**
+ * @brief Convert to another fixed point format like the converting constructor, but the values out of the range of To
+ *        saturate to its min and max values instead of wrapping.
+ *
+ * @tparam To the target fixed point type.
+ */
+template <typename To, typename T, typename I, unsigned int f, bool r>
+EIRIN_ALWAYS_INLINE constexpr To convert_saturate(fixed_num<T, I, f, r> x) noexcept
+{
+    using to_value = typename To::value_type;
+    constexpr unsigned int f2 = To::precision;
+    // wide enough for the raw value shifted left by the whole fraction of To, a shift right fits the wider store type.
+    using wide_intermediate = std::conditional_t<(sizeof(I) >= sizeof(typename To::intermediate_type)), I, typename To::intermediate_type>;
+    using wide_value = std::conditional_t<(sizeof(T) >= sizeof(to_value)), T, to_value>;
+    using wide = std::conditional_t<(f2 > f), wide_intermediate, wide_value>;
+    wide v = static_cast<wide>(x.internal_value());
+    if constexpr(f2 >= f)
+        v = v << (f2 - f);
+    else if constexpr(To::is_rounding)
+        v = detail::shift_right_round<f - f2>(v);
+    else
+        v = detail::shift_right_trunc<f - f2>(v);
+    if(v > static_cast<wide>(std::numeric_limits<to_value>::max()))
+        return To::from_internal_value(std::numeric_limits<to_value>::max());
+    if(v < static_cast<wide>(std::numeric_limits<to_value>::min()))
+        return To::from_internal_value(std::numeric_limits<to_value>::min());
+    return To::from_internal_value(static_cast<to_value>(v));
+}
+
+/**
+ * @brief out[i] = To(in[i]), bit-identical to the converting constructor, which wraps the values out of the range of To.
+ * With AVX2, fixed32 like formats are widened to fixed64 like formats, and the other way around, 4 lanes at a time.
+ *
+ * @throw std::invalid_argument if in.size() != out.size().
+ */
+template <typename To, typename T, typename I, unsigned int f, bool r>
+inline void convert(std::span<const fixed_num<T, I, f, r>> in, std::span<To> out)
+{
+    if(in.size() != out.size())
+        EIRIN_THROW_EXCEPTION(std::invalid_argument, "convert() requires in.size() == out.size()");
+    const size_t n = in.size();
+    size_t i = 0;
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+    detail::avx_convert<To, fixed_num<T, I, f, r>, false>(in.data(), out.data(), n, i);
+#endif
+    for(; i < n; ++i)
+        out[i] = To(in[i]);
+}
+
+/**
+ * @brief out[i] = convert_saturate<To>(in[i]), e.g. to repack fixed64 values into fixed32 ones.
+ *
+ * @throw std::invalid_argument if in.size() != out.size().
+ */
+template <typename To, typename T, typename I, unsigned int f, bool r>
+inline void convert_saturate(std::span<const fixed_num<T, I, f, r>> in, std::span<To> out)
+{
+    if(in.size() != out.size())
+        EIRIN_THROW_EXCEPTION(std::invalid_argument, "convert_saturate() requires in.size() == out.size()");
+    const size_t n = in.size();
+    size_t i = 0;
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+    detail::avx_convert<To, fixed_num<T, I, f, r>, true>(in.data(), out.data(), n, i);
+#endif
+    for(; i < n; ++i)
+        out[i] = convert_saturate<To>(in[i]);
+}
+} // namespace eirin
+
+#endif
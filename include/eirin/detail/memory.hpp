@@ -0,0 +1,54 @@
+#ifndef EIRIN_MATH_DETAIL_MEMORY_HPP
+#define EIRIN_MATH_DETAIL_MEMORY_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace eirin
+{
+namespace detail
+{
+    /**
+     * @brief Allocator with an over-aligned first element, so the columns of ``soa_vec3`` and the storage of ``dense_matrix`` start on a cache line.
+     */
+    template <typename T, size_t Align>
+    struct aligned_allocator
+    {
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = aligned_allocator<U, Align>;
+        };
+
+        constexpr aligned_allocator() noexcept = default;
+
+        template <typename U>
+        constexpr aligned_allocator(const aligned_allocator<U, Align>&) noexcept
+        {
+        }
+
+        [[nodiscard]]
+        T* allocate(size_t n)
+        {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Align}));
+        }
+
+        void deallocate(T* p, size_t) noexcept
+        {
+            ::operator delete(p, std::align_val_t{Align});
+        }
+
+        template <typename U>
+        constexpr bool operator==(const aligned_allocator<U, Align>&) const noexcept
+        {
+            return true;
+        }
+    };
+} // namespace detail
+} // namespace eirin
+
+#endif
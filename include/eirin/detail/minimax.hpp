@@ -0,0 +1,65 @@
+// This file is generated by tools/remez.cpp, do not edit it by hand.
+#ifndef EIRIN_DETAIL_MINIMAX_HPP
+#define EIRIN_DETAIL_MINIMAX_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace eirin::detail
+{
+/**
+ * @brief An odd minimax polynomial x * (c[0] + c[1] * x^2 + ...) on [0, 1].
+ * The coefficients have 61 fraction bits, and the max absolute error of the polynomial is below 2^-error_bits.
+ */
+struct minimax_poly
+{
+    size_t terms;
+    unsigned int error_bits;
+    std::array<int64_t, 12> coeffs;
+};
+
+inline constexpr unsigned int minimax_fraction = 61;
+
+// sin(pi / 2 * x) = x * P(x^2) for x in [0, 1].
+inline constexpr minimax_poly minimax_sin_quarter[] = {
+    {1, 2, {0x246C45BF94333F60}},
+    {2, 7, {0x3189C21930712E58, -0x11AE8DF2F9F18BFF}},
+    {3, 13, {0x32400FC4D1798E98, -0x148C30E994928833, 0x24CAF225BEF82BF}},
+    {4, 20, {0x3243EB82AD7D43F5, -0x14AB277B31394085, 0x28AB9E50A5DDA2D, -0x237F28D292E54B}},
+    {5, 28, {0x3243F694CA60243D, -0x14ABBB5A213BC6AA, 0x28CCEDB3944A76A, -0x26465F4431D1B6, 0x13C4B2C922855}},
+    {6, 36, {0x3243F6A8709294F9, -0x14ABBCE38AAD496B, 0x28CD7780ACDAC7E, -0x265A11C99155E6, 0x14FFFFAAA7582, -0x72B239FF1AB}},
+    {7, 44, {0x3243F6A8884572EF, -0x14ABBCE622B70CA2, 0x28CD78CCDF4EECB, -0x265A59008C4117, 0x15076B5C3A30E, -0x78A2655FABB, 0x1D3D9CA56F}},
+    {8, 51, {0x3243F6A8885A2FCC, -0x14ABBCE625BDF068, 0x28CD78CEEAB673E, -0x265A599C66F1D5, 0x1507832E270BD, -0x78C1964FAE3, 0x1E8A6255B9, -0x58C08065}},
+};
+
+// atan(x) = x * P(x^2) for x in [0, 1].
+inline constexpr minimax_poly minimax_atan[] = {
+    {1, 4, {0x1AAA386FAEE13CEE}},
+    {2, 7, {0x1F1DDA44ED844A60, -0x62470096671BC5F}},
+    {3, 10, {0x1FD9F8ECF219AE0A, -0x93CF34F683B6FF1, 0x289F2078CA3C544}},
+    {4, 13, {0x1FF98F3ED8AC28C4, -0xA4710BABE2D9DEB, 0x4AE32D010530F9E, -0x13F60A5771E7070}},
+    {5, 16, {0x1FFEE7AC2E292229, -0xA91DB5773222D3A, 0x5C3DD6CDDE88DA9, -0x2B999CFC9D43E52, 0xAAC35F7A3B9286}},
+    {6, 19, {0x1FFFD039963F59D3, -0xAA4D8A0F080A50B, 0x6317B961208C3CF, -0x3B9C4072B797885, 0x1AF497F2A67033C, -0x6000CEEB8C5D50}},
+    {7, 21, {0x1FFFF7D867679E70, -0xAA95BD9B9B9168E, 0x656A80008A2A260, -0x43C134C421597AD, 0x28C46F158029BD7, -0x11349285032A3D5, 0x37CD5D99301CFF}},
+    {8, 24, {0x1FFFFE9B4A987CB0, -0xAAA61D790073FDE, 0x66205CCEFE35270, -0x473651A5BB87C1B, 0x315E388D33681CE, -0x1CA08A5F76C5FCA, 0xB319F230D5A3A5, -0x21370B35ECCA99}},
+    {9, 27, {0x1FFFFFC3009D69DB, -0xAAA9B39A9C6155D, 0x6653ED8032ED2D3, -0x4881680EABEE1CF, 0x35C12DDAA805F0A, -0x250ADF8E639B0F2, 0x145E34A66A809DB, -0x75F9D8DC73D4ED, 0x1420209D8C9BEC}},
+    {10, 30, {0x1FFFFFF5903B1770, -0xAAAA7757CF41B6B, 0x6661BACAF5DAA2E, -0x48F21EA5355AABB, 0x37B206722CED482, -0x2A0DF1176DD1251, 0x1C2CA4B15E1B395, -0xE9657D491A09C6, 0x4E602AE6AE6CAD, -0xC5D3D0567286B}},
+    {11, 32, {0x1FFFFFFE36AA6D16, -0xAAAAA02EDBDCCC4, 0x66654268E8B895D, -0x4915C8A30923964, 0x3877795666430C0, -0x2C9D6ECCF29381A, 0x217DEB82EC66401, -0x158C944C84FA9B3, 0xA7AC4514851CA7, -0x3462DB2D9DAE83, 0x7AE36CBEF3448}},
+    {12, 35, {0x1FFFFFFFB1B0B367, -0xAAAAA88E228DE8F, 0x6666211F9C226EE, -0x49206CFE6EBFFAE, 0x38BF96E1C1A9DF1, -0x2DC74D813BA4505, 0x2492921F290E5B9, -0x1AE33023F2E27F9, 0x1080C97A56F2C4C, -0x7898A0E24935DE, 0x232C6DE2548E9F, -0x4D07F0278CF63}},
+};
+
+/**
+ * @brief The lowest degree polynomial in the table with an error below 2^-bits, or the most precise one.
+ */
+template <size_t N>
+constexpr const minimax_poly& minimax_select(const minimax_poly (&table)[N], unsigned int bits) noexcept
+{
+    for(const auto& poly : table)
+        if(poly.error_bits >= bits)
+            return poly;
+    return table[N - 1];
+}
+} // namespace eirin::detail
+
+#endif
@@ -3,8 +3,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <cstdio>
+#include <thread>
+#include <vector>
 #include "int128.hpp"
 #include "../eirin.hpp"
 
@@ -47,6 +52,112 @@ namespace perf
         }
         return {max_esp, min_esp, max_input, min_input};
     }
+    /**
+     * @brief Error statistics of an approximation, in ULPs of the fixed point format.
+     */
+    struct error_stats
+    {
+        // histogram[0] counts the errors below 0.5 ULP, histogram[i] the errors in [2^(i - 2), 2^(i - 1)),
+        // and the last bucket everything above.
+        static constexpr size_t histogram_size = 16;
+
+        uint64_t samples = 0;
+        double max_ulp = 0;
+        long double max_ulp_input = 0;
+        long double sum_ulp = 0;
+        long double sum_squared_ulp = 0;
+        std::array<uint64_t, histogram_size> histogram{};
+
+        double mean_ulp() const noexcept
+        {
+            return samples == 0 ? 0 : static_cast<double>(sum_ulp / samples);
+        }
+
+        double rms_ulp() const noexcept
+        {
+            return samples == 0 ? 0 : static_cast<double>(std::sqrt(sum_squared_ulp / samples));
+        }
+
+        // the lower bound of histogram[i] in ULPs.
+        static constexpr double bucket_bound(size_t i) noexcept
+        {
+            return i == 0 ? 0 : (i == 1 ? 0.5 : static_cast<double>(uint64_t(1) << (i - 2)));
+        }
+
+        void add(long double input, double ulp) noexcept
+        {
+            ++samples;
+            if(ulp > max_ulp)
+            {
+                max_ulp = ulp;
+                max_ulp_input = input;
+            }
+            sum_ulp += ulp;
+            sum_squared_ulp += static_cast<long double>(ulp) * ulp;
+            size_t bucket = 0;
+            if(ulp >= 0.5)
+                bucket = static_cast<size_t>(std::clamp(std::ilogb(ulp) + 2, 1, static_cast<int>(histogram_size) - 1));
+            ++histogram[bucket];
+        }
+
+        void merge(const error_stats& other) noexcept
+        {
+            samples += other.samples;
+            if(other.max_ulp > max_ulp)
+            {
+                max_ulp = other.max_ulp;
+                max_ulp_input = other.max_ulp_input;
+            }
+            sum_ulp += other.sum_ulp;
+            sum_squared_ulp += other.sum_squared_ulp;
+            for(size_t i = 0; i < histogram_size; ++i)
+                histogram[i] += other.histogram[i];
+        }
+    };
+
+    /**
+     * @brief Measures |func(x) - ref(x)| in ULPs of Fixed for ``samples`` evenly spaced inputs of [start, end],
+     *        the inputs are split into contiguous ranges over ``threads`` threads.
+     * Unlike ``measure_esp``, the reference is computed in long double and the error is not rounded to Fixed.
+     *
+     * @param func the approximation, Fixed -> Fixed.
+     * @param ref the reference, long double -> long double.
+     * @param threads the number of threads, 0 for std::thread::hardware_concurrency().
+     */
+    template <typename Fixed, typename Func, typename Ref>
+    error_stats measure_error(Fixed start, Fixed end, uint64_t samples, Func func, Ref ref, unsigned int threads = 0)
+    {
+        using raw = decltype(start.internal_value());
+        constexpr int f = static_cast<int>(Fixed::precision);
+        const auto to_long_double = [](Fixed x) { return std::ldexp(static_cast<long double>(x.internal_value()), -f); };
+        const long double span = static_cast<long double>(end.internal_value()) - static_cast<long double>(start.internal_value());
+        const auto measure = [&](uint64_t first, uint64_t last)
+        {
+            error_stats stats;
+            for(uint64_t i = first; i < last; ++i)
+            {
+                const auto offset = samples > 1 ? std::llround(span * i / (samples - 1)) : 0;
+                const auto x = Fixed::from_internal_value(static_cast<raw>(start.internal_value() + offset));
+                const auto input = to_long_double(x);
+                stats.add(input, static_cast<double>(std::ldexp(std::abs(to_long_double(func(x)) - ref(input)), f)));
+            }
+            return stats;
+        };
+
+        if(threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = static_cast<unsigned int>(std::min<uint64_t>(threads, std::max<uint64_t>(samples, 1)));
+        std::vector<error_stats> partial(threads);
+        std::vector<std::thread> workers;
+        for(unsigned int t = 1; t < threads; ++t)
+            workers.emplace_back([&, t] { partial[t] = measure(samples * t / threads, samples * (t + 1) / threads); });
+        partial[0] = measure(0, samples / threads);
+        for(auto& worker : workers)
+            worker.join();
+        for(unsigned int t = 1; t < threads; ++t)
+            partial[0].merge(partial[t]);
+        return partial[0];
+    }
 } // namespace perf
 } // namespace eirin
 
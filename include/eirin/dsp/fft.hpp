@@ -0,0 +1,422 @@
+#ifndef EIRIN_DSP_FFT_HPP
+#define EIRIN_DSP_FFT_HPP
+
+#pragma once
+
+#include "../error.hpp"
+#include "../fixed.hpp"
+#include "../math.hpp"
+#include "../vec.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+#    include <immintrin.h>
+#endif
+
+namespace eirin::dsp
+{
+/**
+ * @brief Complex number of fixed point numbers, laid out as {re, im} like ``std::complex``,
+ *        so a span of them can be reinterpreted as interleaved real and imaginary parts.
+ *
+ * @tparam Fixed the fixed point type of the parts.
+ */
+template <typename Fixed>
+struct complex
+{
+    using value_type = Fixed;
+
+    Fixed re, im;
+
+    constexpr bool operator==(const complex&) const noexcept = default;
+};
+
+template <typename Fixed>
+EIRIN_ALWAYS_INLINE constexpr complex<Fixed> operator+(const complex<Fixed>& a, const complex<Fixed>& b) noexcept
+{
+    return {a.re + b.re, a.im + b.im};
+}
+
+template <typename Fixed>
+EIRIN_ALWAYS_INLINE constexpr complex<Fixed> operator-(const complex<Fixed>& a, const complex<Fixed>& b) noexcept
+{
+    return {a.re - b.re, a.im - b.im};
+}
+
+template <typename Fixed>
+EIRIN_ALWAYS_INLINE constexpr complex<Fixed> operator-(const complex<Fixed>& a) noexcept
+{
+    return {-a.re, -a.im};
+}
+
+template <typename Fixed>
+EIRIN_ALWAYS_INLINE constexpr complex<Fixed> operator*(const complex<Fixed>& a, Fixed s) noexcept
+{
+    return {a.re * s, a.im * s};
+}
+
+template <typename Fixed>
+EIRIN_ALWAYS_INLINE constexpr complex<Fixed> operator*(Fixed s, const complex<Fixed>& a) noexcept
+{
+    return a * s;
+}
+
+/**
+ * @brief Complex product, both parts sum their two products in the intermediate type and shift once.
+ */
+template <typename T, typename I, unsigned int f, bool r>
+EIRIN_ALWAYS_INLINE constexpr complex<fixed_num<T, I, f, r>> operator*(const complex<fixed_num<T, I, f, r>>& a,
+                                                                       const complex<fixed_num<T, I, f, r>>& b) noexcept
+{
+    using eirin::detail::narrow_product;
+    using eirin::detail::wide_product;
+    return {narrow_product<T, I, f, r>(wide_product(a.re, b.re) - wide_product(a.im, b.im)),
+            narrow_product<T, I, f, r>(wide_product(a.re, b.im) + wide_product(a.im, b.re))};
+}
+
+template <typename Fixed>
+EIRIN_ALWAYS_INLINE constexpr complex<Fixed>& operator*=(complex<Fixed>& a, const complex<Fixed>& b) noexcept
+{
+    return a = a * b;
+}
+
+template <typename Fixed>
+EIRIN_ALWAYS_INLINE constexpr complex<Fixed> conj(const complex<Fixed>& a) noexcept
+{
+    return {a.re, -a.im};
+}
+
+namespace detail
+{
+    // the twiddles are products of a coarse table with 2^fft_coarse_bits steps per turn and a fine table
+    // for the steps in between, so the largest transform has 2^fft_max_bits points.
+    inline constexpr unsigned int fft_coarse_bits = 10;
+    inline constexpr unsigned int fft_max_bits = 2 * fft_coarse_bits;
+
+    /**
+     * @brief The compile-time twiddle tables, evaluated with the ``sin`` kernel of the library on exact arguments
+     *        and kept with P = W - 2 fraction bits, 2 bits more than the error of the polynomial.
+     * ``coarse[j]`` is cos(2 pi j / 2^10) for a quarter turn, ``fine[j]`` is {cos, sin}(2 pi j / 2^20) for one coarse step.
+     */
+    template <typename T, typename I, unsigned int f, bool r>
+    struct fft_tables
+    {
+        static constexpr unsigned int P = sizeof(T) * 8 - 2;
+        static constexpr size_t quarter = (size_t(1) << fft_coarse_bits) / 4;
+        static constexpr size_t steps = size_t(1) << (fft_max_bits - fft_coarse_bits);
+
+        // sin(pi / 2 * num / den) with P fraction bits, num / den is exact as den divides 2^P.
+        static constexpr T sin_quarter_turn(size_t num, size_t den) noexcept
+        {
+            using wide = fixed_num<T, I, P, r>;
+            return eirin::detail::sin_quarter<T, I, P, r, f + 2>(wide::from_internal_value(static_cast<T>((T(1) << P) / T(den) * T(num))))
+                .internal_value();
+        }
+
+        static constexpr std::array<T, quarter + 1> coarse = []
+        {
+            std::array<T, quarter + 1> res{};
+            for(size_t j = 0; j <= quarter; ++j)
+                res[j] = sin_quarter_turn(quarter - j, quarter);
+            return res;
+        }();
+
+        static constexpr std::array<std::pair<T, T>, steps> fine = []
+        {
+            std::array<std::pair<T, T>, steps> res{};
+            for(size_t j = 0; j < steps; ++j)
+                res[j] = {sin_quarter_turn(quarter * steps - j, quarter * steps), sin_quarter_turn(j, quarter * steps)};
+            return res;
+        }();
+
+        /**
+         * @brief e^(-2 pi i j / 2^20) rounded to f fraction bits, one complex product of a coarse and a fine entry.
+         */
+        static constexpr std::pair<T, T> twiddle(size_t j) noexcept
+        {
+            const size_t hi = (j >> (fft_max_bits - fft_coarse_bits)) & ((size_t(1) << fft_coarse_bits) - 1);
+            const auto [fc, fs] = fine[j & (steps - 1)];
+            const size_t rem = hi & (quarter - 1);
+            const T qc = coarse[rem], qs = coarse[quarter - rem];
+            // rotate {cos, sin} of the remainder by the quarter turns.
+            const size_t turns = hi / quarter;
+            const T c = turns == 0 ? qc : (turns == 1 ? -qs : (turns == 2 ? -qc : qs));
+            const T s = turns == 0 ? qs : (turns == 1 ? qc : (turns == 2 ? -qs : -qc));
+            constexpr unsigned int shift = 2 * P - f;
+            constexpr I half = I(1) << (shift - 1);
+            const I re = static_cast<I>(c) * fc - static_cast<I>(s) * fs;
+            const I im = static_cast<I>(s) * fc + static_cast<I>(c) * fs;
+            return {static_cast<T>((re + half) >> shift), static_cast<T>(-((im + half) >> shift))};
+        }
+    };
+
+    /**
+     * @brief v >> shift rounded half to even, rounding the ties up would add a bias to every stage
+     *        that grows with the size after the inverse transform.
+     */
+    template <unsigned int shift, typename I>
+    EIRIN_ALWAYS_INLINE constexpr I fft_round(I v) noexcept
+    {
+        return (v + ((I(1) << (shift - 1)) - 1) + ((v >> shift) & 1)) >> shift;
+    }
+
+    /**
+     * @brief (w * b) >> (f + s) with a single rounding, conj(w) for the inverse transform.
+     */
+    template <bool inverse, unsigned int s, typename T, typename I, unsigned int f, bool r>
+    EIRIN_ALWAYS_INLINE constexpr complex<fixed_num<T, I, f, r>> fft_twiddle_mul(const complex<fixed_num<T, I, f, r>>& w,
+                                                                                  const complex<fixed_num<T, I, f, r>>& b) noexcept
+    {
+        using fixed = fixed_num<T, I, f, r>;
+        const I wr = w.re.internal_value(), wi = inverse ? -I(w.im.internal_value()) : I(w.im.internal_value());
+        const I br = b.re.internal_value(), bi = b.im.internal_value();
+        return {fixed::from_internal_value(static_cast<T>(fft_round<f + s>(wr * br - wi * bi))),
+                fixed::from_internal_value(static_cast<T>(fft_round<f + s>(wr * bi + wi * br)))};
+    }
+
+    template <unsigned int s, typename T, typename I, unsigned int f, bool r>
+    EIRIN_ALWAYS_INLINE constexpr complex<fixed_num<T, I, f, r>> fft_scale(const complex<fixed_num<T, I, f, r>>& b) noexcept
+    {
+        using fixed = fixed_num<T, I, f, r>;
+        if constexpr(s == 0)
+            return b;
+        else
+            return {fixed::from_internal_value(static_cast<T>(fft_round<s>(static_cast<I>(b.re.internal_value())))),
+                    fixed::from_internal_value(static_cast<T>(fft_round<s>(static_cast<I>(b.im.internal_value()))))};
+    }
+
+    // -i * a for the forward transform, i * a for the inverse.
+    template <bool inverse, typename Fixed>
+    EIRIN_ALWAYS_INLINE constexpr complex<Fixed> fft_rotate(const complex<Fixed>& a) noexcept
+    {
+        if constexpr(inverse)
+            return {-a.im, a.re};
+        else
+            return {a.im, -a.re};
+    }
+
+    /**
+     * @brief One radix-4 butterfly over the quarters b0..b3 of a block, b1 and b2 are swapped because
+     *        the quarters hold the transforms of the inputs with the bit reversed residues mod 4.
+     */
+    template <bool inverse, unsigned int s, typename Fixed>
+    EIRIN_ALWAYS_INLINE constexpr void fft_butterfly4(complex<Fixed>& b0, complex<Fixed>& b1, complex<Fixed>& b2, complex<Fixed>& b3,
+                                                      const complex<Fixed>& w1, const complex<Fixed>& w2, const complex<Fixed>& w3) noexcept
+    {
+        const auto a0 = fft_scale<s>(b0);
+        const auto a1 = fft_twiddle_mul<inverse, s>(w1, b2);
+        const auto a2 = fft_twiddle_mul<inverse, s>(w2, b1);
+        const auto a3 = fft_twiddle_mul<inverse, s>(w3, b3);
+        const auto t0 = a0 + a2, t1 = a0 - a2, t2 = a1 + a3, t3 = fft_rotate<inverse>(a1 - a3);
+        b0 = t0 + t2;
+        b1 = t1 + t3;
+        b2 = t0 - t2;
+        b3 = t1 - t3;
+    }
+
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+    // (v >> shift) rounded half to even in every 64 bit lane, only the low 32 bits of the result are valid.
+    template <unsigned int shift>
+    EIRIN_ALWAYS_INLINE __m256i avx_mm256_round_epi64(__m256i v) noexcept
+    {
+        const __m256i odd = _mm256_and_si256(_mm256_srli_epi64(v, shift), _mm256_set1_epi64x(1));
+        return _mm256_add_epi64(_mm256_add_epi64(v, _mm256_set1_epi64x((int64_t(1) << (shift - 1)) - 1)), odd);
+    }
+
+    // (w * b) >> shift for 4 complex fixed32 numbers, the products are the even lanes of _mm256_mul_epi32
+    // and only the low 32 bits of every shifted product are kept, so a logical shift is enough.
+    template <bool inverse, unsigned int shift>
+    EIRIN_ALWAYS_INLINE __m256i avx_mm256_cmul_epi32(__m256i w, __m256i b) noexcept
+    {
+        static_assert(shift <= 32);
+        const __m256i wi = _mm256_srli_epi64(w, 32), bi = _mm256_srli_epi64(b, 32);
+        const __m256i rr = _mm256_mul_epi32(w, b), ii = _mm256_mul_epi32(wi, bi);
+        const __m256i ri = _mm256_mul_epi32(w, bi), ir = _mm256_mul_epi32(wi, b);
+        const __m256i re = avx_mm256_round_epi64<shift>(inverse ? _mm256_add_epi64(rr, ii) : _mm256_sub_epi64(rr, ii));
+        const __m256i im = avx_mm256_round_epi64<shift>(inverse ? _mm256_sub_epi64(ri, ir) : _mm256_add_epi64(ri, ir));
+        return _mm256_blend_epi32(_mm256_srli_epi64(re, shift), _mm256_slli_epi64(im, 32 - shift), 0xAA);
+    }
+
+    /**
+     * @brief ``fft_butterfly4`` on 4 consecutive butterflies of fixed32, bit-identical to the scalar version.
+     */
+    template <bool inverse, unsigned int s, unsigned int f>
+    EIRIN_ALWAYS_INLINE void avx_mm256_butterfly4_epi32(int32_t* b0, int32_t* b1, int32_t* b2, int32_t* b3,
+                                                       const int32_t* w1, const int32_t* w2, const int32_t* w3) noexcept
+    {
+        const auto load = [](const int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); };
+        __m256i a0 = load(b0);
+        if constexpr(s > 0)
+        {
+            const __m256i odd = _mm256_and_si256(_mm256_srai_epi32(a0, s), _mm256_set1_epi32(1));
+            a0 = _mm256_srai_epi32(_mm256_add_epi32(_mm256_add_epi32(a0, _mm256_set1_epi32((1 << (s - 1)) - 1)), odd), s);
+        }
+        const __m256i a1 = avx_mm256_cmul_epi32<inverse, f + s>(load(w1), load(b2));
+        const __m256i a2 = avx_mm256_cmul_epi32<inverse, f + s>(load(w2), load(b1));
+        const __m256i a3 = avx_mm256_cmul_epi32<inverse, f + s>(load(w3), load(b3));
+        const __m256i t0 = _mm256_add_epi32(a0, a2), t1 = _mm256_sub_epi32(a0, a2), t2 = _mm256_add_epi32(a1, a3);
+        // swap the parts of a1 - a3 and negate the imaginary part for -i, the real part for i.
+        const __m256i sign = inverse ? _mm256_set_epi32(1, -1, 1, -1, 1, -1, 1, -1) : _mm256_set_epi32(-1, 1, -1, 1, -1, 1, -1, 1);
+        const __m256i t3 = _mm256_sign_epi32(_mm256_shuffle_epi32(_mm256_sub_epi32(a1, a3), 0xB1), sign);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(b0), _mm256_add_epi32(t0, t2));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(b1), _mm256_add_epi32(t1, t3));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(b2), _mm256_sub_epi32(t0, t2));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(b3), _mm256_sub_epi32(t1, t3));
+    }
+#endif
+} // namespace detail
+
+/**
+ * @brief In-place radix-4 FFT of a power of two size, with a radix-2 first stage for the odd powers.
+ * The twiddles are computed once by the constructor from compile-time tables of the library's ``sin``,
+ * so the results are bit-identical on every platform, with or without SIMD.
+ * The forward transform divides by 4 (2 for the radix-2 stage) before every butterfly, so the result is the DFT
+ * divided by the size and never overflows when the parts of the inputs are below half of the max value.
+ * The inverse transform does not scale, so ``inverse(forward(x))`` is x again.
+ *
+ * @tparam Fixed the fixed point type of the samples.
+ */
+template <typename Fixed>
+class fft_plan;
+
+template <typename T, typename I, unsigned int f, bool r>
+class fft_plan<fixed_num<T, I, f, r>>
+{
+public:
+    using value_type = complex<fixed_num<T, I, f, r>>;
+
+    // the largest size of a transform, 2^20 points.
+    static constexpr size_t max_size = size_t(1) << detail::fft_max_bits;
+
+    /**
+     * @brief Creates the plan of a transform with n points.
+     * @throw std::invalid_argument if n is not a power of two between 2 and ``max_size``.
+     */
+    explicit fft_plan(size_t n)
+        : m_size(n)
+    {
+        if(n < 2 || n > max_size || !std::has_single_bit(n))
+            EIRIN_THROW_EXCEPTION(std::invalid_argument, "fft_plan() requires a power of two size between 2 and 2^20");
+
+        using tables = detail::fft_tables<T, I, f, r>;
+        const size_t step = max_size / n;
+        m_twiddles.reserve(n);
+        for(size_t m = (std::countr_zero(n) % 2) ? 2 : 1; 4 * m <= n; m *= 4)
+            for(size_t p = 1; p <= 3; ++p)
+                for(size_t k = 0; k < m; ++k)
+                {
+                    const auto [re, im] = tables::twiddle(p * k * (n / (4 * m)) * step);
+                    m_twiddles.push_back({fixed::from_internal_value(re), fixed::from_internal_value(im)});
+                }
+    }
+
+    size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief The forward transform divided by ``size()``.
+     * @throw std::invalid_argument if data.size() != size().
+     */
+    void forward(std::span<value_type> data) const
+    {
+        transform<false>(data);
+    }
+
+    /**
+     * @brief The inverse transform without scaling.
+     * @throw std::invalid_argument if data.size() != size().
+     */
+    void inverse(std::span<value_type> data) const
+    {
+        transform<true>(data);
+    }
+
+private:
+    using fixed = fixed_num<T, I, f, r>;
+
+    size_t m_size;
+    std::vector<value_type> m_twiddles;
+
+    template <bool inverse>
+    void transform(std::span<value_type> data) const
+    {
+        if(data.size() != m_size)
+            EIRIN_THROW_EXCEPTION(std::invalid_argument, "fft_plan requires data.size() == size()");
+
+        const size_t n = m_size;
+        for(size_t i = 1, j = 0; i < n; ++i)
+        {
+            size_t bit = n >> 1;
+            for(; j & bit; bit >>= 1)
+                j ^= bit;
+            j |= bit;
+            if(i < j)
+                std::swap(data[i], data[j]);
+        }
+
+        constexpr unsigned int s2 = inverse ? 0 : 1;
+        constexpr unsigned int s4 = inverse ? 0 : 2;
+        size_t m = 1;
+        if(std::countr_zero(n) % 2)
+        {
+            for(size_t i = 0; i < n; i += 2)
+            {
+                const auto a0 = detail::fft_scale<s2>(data[i]), a1 = detail::fft_scale<s2>(data[i + 1]);
+                data[i] = a0 + a1;
+                data[i + 1] = a0 - a1;
+            }
+            m = 2;
+        }
+
+        const value_type* w = m_twiddles.data();
+        for(; 4 * m <= n; w += 3 * m, m *= 4)
+            for(size_t g = 0; g < n; g += 4 * m)
+            {
+                value_type* b = data.data() + g;
+                size_t k = 0;
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+                if constexpr(std::is_same_v<T, int32_t> && std::is_same_v<I, int64_t>)
+                {
+                    // every complex number is two int32_t.
+                    auto* raw = reinterpret_cast<int32_t*>(b);
+                    const auto* raw_w = reinterpret_cast<const int32_t*>(w);
+                    for(; k + 4 <= m; k += 4)
+                        detail::avx_mm256_butterfly4_epi32<inverse, s4, f>(raw + 2 * k, raw + 2 * (m + k), raw + 2 * (2 * m + k), raw + 2 * (3 * m + k),
+                                                                           raw_w + 2 * k, raw_w + 2 * (m + k), raw_w + 2 * (2 * m + k));
+                }
+#endif
+                for(; k < m; ++k)
+                    detail::fft_butterfly4<inverse, s4>(b[k], b[m + k], b[2 * m + k], b[3 * m + k], w[k], w[m + k], w[2 * m + k]);
+            }
+    }
+};
+
+/**
+ * @brief The forward transform of ``fft_plan`` in place, the plan is created on every call.
+ */
+template <typename Fixed>
+void fft(std::span<complex<Fixed>> data)
+{
+    fft_plan<Fixed>(data.size()).forward(data);
+}
+
+/**
+ * @brief The inverse transform of ``fft_plan`` in place, the plan is created on every call.
+ */
+template <typename Fixed>
+void ifft(std::span<complex<Fixed>> data)
+{
+    fft_plan<Fixed>(data.size()).inverse(data);
+}
+} // namespace eirin::dsp
+
+#endif
@@ -0,0 +1,295 @@
+#ifndef EIRIN_DSP_FILTER_HPP
+#define EIRIN_DSP_FILTER_HPP
+
+#pragma once
+
+#include "../error.hpp"
+#include "../fixed.hpp"
+#include "../vec.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+#    include <immintrin.h>
+#endif
+
+namespace eirin::dsp
+{
+namespace detail
+{
+    // the number of samples a fir_filter copies behind its delay line at once.
+    inline constexpr size_t fir_block = 256;
+
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+    // the low 32 bits of every 64 bit lane, packed into 4 int32_t.
+    EIRIN_ALWAYS_INLINE __m128i avx_mm256_pack_epi64_epi32(__m256i v) noexcept
+    {
+        return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7)));
+    }
+
+    EIRIN_ALWAYS_INLINE __m256i avx_mm256_load_epi32_epi64(const int32_t* p) noexcept
+    {
+        return _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+    }
+#endif
+} // namespace detail
+
+/**
+ * @brief Finite impulse response filter y[n] = c[0] * x[n] + c[1] * x[n - 1] + ... + c[Taps - 1] * x[n - Taps + 1].
+ * The products of every output are summed in the intermediate type and shifted once like ``dot``, and the last
+ * Taps - 1 inputs are kept between the calls of ``process``, so a stream can be filtered block by block.
+ * With AVX2, fixed32 computes 8 outputs at once with 64 bit accumulators for the even and the odd ones,
+ * the results are the same as the scalar code.
+ *
+ * @tparam Fixed the fixed point type of the samples and the coefficients.
+ * @tparam Taps the number of coefficients.
+ */
+template <typename Fixed, size_t Taps>
+class fir_filter;
+
+template <typename T, typename I, unsigned int f, bool r, size_t Taps>
+class fir_filter<fixed_num<T, I, f, r>, Taps>
+{
+    static_assert(Taps > 0, "fir_filter requires at least one tap");
+
+public:
+    using value_type = fixed_num<T, I, f, r>;
+    static constexpr size_t taps = Taps;
+
+    constexpr explicit fir_filter(const std::array<value_type, Taps>& coeffs) noexcept
+        : m_coeffs(coeffs), m_buffer{} {}
+
+    constexpr const std::array<value_type, Taps>& coefficients() const noexcept
+    {
+        return m_coeffs;
+    }
+
+    /**
+     * @brief Clears the delay line, as if the previous inputs were all zero.
+     */
+    constexpr void reset() noexcept
+    {
+        std::fill(m_buffer.begin(), m_buffer.begin() + history, T(0));
+    }
+
+    /**
+     * @brief Filters the next block of the stream, in and out may be the same span.
+     * @throw std::invalid_argument if in.size() != out.size().
+     */
+    constexpr void process(std::span<const value_type> in, std::span<value_type> out)
+    {
+        if(in.size() != out.size())
+            EIRIN_THROW_EXCEPTION(std::invalid_argument, "fir_filter::process() requires in.size() == out.size()");
+
+        for(size_t start = 0; start < in.size(); start += detail::fir_block)
+        {
+            const size_t count = std::min(detail::fir_block, in.size() - start);
+            for(size_t n = 0; n < count; ++n)
+                m_buffer[history + n] = in[start + n].internal_value();
+            filter(out.data() + start, count);
+            std::copy(m_buffer.begin() + count, m_buffer.begin() + count + history, m_buffer.begin());
+        }
+    }
+
+    constexpr value_type process(value_type x) noexcept
+    {
+        value_type y{};
+        process(std::span<const value_type>(&x, 1), std::span<value_type>(&y, 1));
+        return y;
+    }
+
+private:
+    static constexpr size_t history = Taps - 1;
+
+    std::array<value_type, Taps> m_coeffs;
+    // the last Taps - 1 inputs, followed by the block being filtered.
+    std::array<T, history + detail::fir_block> m_buffer;
+
+    constexpr void filter(value_type* out, size_t count) const noexcept
+    {
+        size_t n = 0;
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+        if constexpr(std::is_same_v<value_type, fixed32>)
+        {
+            if(!std::is_constant_evaluated())
+            {
+                // 16 outputs share every broadcast coefficient, and x is loaded once per tap for 8 of them.
+                const auto accumulate = [this](size_t n, size_t k, __m256i c, __m256i& even, __m256i& odd)
+                {
+                    const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m_buffer.data() + history + n - k));
+                    even = _mm256_add_epi64(even, _mm256_mul_epi32(c, x));
+                    odd = _mm256_add_epi64(odd, _mm256_mul_epi32(c, _mm256_srli_epi64(x, 32)));
+                };
+                // the low 32 bits of sum >> f do not depend on the kind of the shift.
+                const auto store = [out](size_t n, __m256i even, __m256i odd)
+                {
+                    const __m256i y = _mm256_blend_epi32(_mm256_srli_epi64(even, f), _mm256_slli_epi64(odd, 32 - f), 0xAA);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + n), y);
+                };
+                for(; n + 16 <= count; n += 16)
+                {
+                    __m256i even0 = _mm256_setzero_si256(), odd0 = even0, even1 = even0, odd1 = even0;
+                    for(size_t k = 0; k < Taps; ++k)
+                    {
+                        const __m256i c = _mm256_set1_epi64x(m_coeffs[k].internal_value());
+                        accumulate(n, k, c, even0, odd0);
+                        accumulate(n + 8, k, c, even1, odd1);
+                    }
+                    store(n, even0, odd0);
+                    store(n + 8, even1, odd1);
+                }
+                for(; n + 8 <= count; n += 8)
+                {
+                    __m256i even = _mm256_setzero_si256(), odd = even;
+                    for(size_t k = 0; k < Taps; ++k)
+                        accumulate(n, k, _mm256_set1_epi64x(m_coeffs[k].internal_value()), even, odd);
+                    store(n, even, odd);
+                }
+            }
+        }
+#endif
+        for(; n < count; ++n)
+        {
+            I sum = 0;
+            for(size_t k = 0; k < Taps; ++k)
+                sum += static_cast<I>(m_coeffs[k].internal_value()) * m_buffer[history + n - k];
+            out[n] = eirin::detail::narrow_product<T, I, f, r>(sum);
+        }
+    }
+};
+
+/**
+ * @brief The coefficients of the biquad y[n] = b0 * x[n] + b1 * x[n - 1] + b2 * x[n - 2] - a1 * y[n - 1] - a2 * y[n - 2],
+ *        normalized so that a0 is 1.
+ */
+template <typename Fixed>
+struct biquad_coefficients
+{
+    Fixed b0, b1, b2, a1, a2;
+
+    constexpr bool operator==(const biquad_coefficients&) const noexcept = default;
+};
+
+/**
+ * @brief Biquad infinite impulse response filter in the direct form I, the five products of every output are summed
+ *        in the intermediate type and shifted once, so the only rounding is the one of the output.
+ * The filter runs over interleaved channels with the same coefficients, the sample n of the channel c is
+ * ``in[n * channels() + c]``. Every output depends on the previous one, so with AVX2, fixed32 filters 4 channels
+ * at once instead of 4 samples, and the results are the same as the scalar code.
+ *
+ * @tparam Fixed the fixed point type of the samples and the coefficients.
+ */
+template <typename Fixed>
+class iir_filter;
+
+template <typename T, typename I, unsigned int f, bool r>
+class iir_filter<fixed_num<T, I, f, r>>
+{
+public:
+    using value_type = fixed_num<T, I, f, r>;
+
+    /**
+     * @throw std::invalid_argument if channels is 0.
+     */
+    explicit iir_filter(const biquad_coefficients<value_type>& coeffs, size_t channels = 1)
+        : m_coeffs(coeffs), m_channels(channels)
+    {
+        if(channels == 0)
+            EIRIN_THROW_EXCEPTION(std::invalid_argument, "iir_filter() requires at least one channel");
+        for(auto* state : {&m_x1, &m_x2, &m_y1, &m_y2})
+            state->assign(channels, T(0));
+    }
+
+    const biquad_coefficients<value_type>& coefficients() const noexcept
+    {
+        return m_coeffs;
+    }
+
+    size_t channels() const noexcept
+    {
+        return m_channels;
+    }
+
+    /**
+     * @brief Clears the previous inputs and outputs of every channel.
+     */
+    void reset() noexcept
+    {
+        for(auto* state : {&m_x1, &m_x2, &m_y1, &m_y2})
+            std::fill(state->begin(), state->end(), T(0));
+    }
+
+    /**
+     * @brief Filters the next frames of the stream, in and out may be the same span.
+     * @throw std::invalid_argument if in.size() != out.size() or the size is not a multiple of channels().
+     */
+    void process(std::span<const value_type> in, std::span<value_type> out)
+    {
+        if(in.size() != out.size() || in.size() % m_channels != 0)
+            EIRIN_THROW_EXCEPTION(std::invalid_argument, "iir_filter::process() requires in.size() == out.size() and whole frames");
+
+        const size_t frames = in.size() / m_channels;
+        size_t c = 0;
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+        if constexpr(std::is_same_v<value_type, fixed32>)
+        {
+            const auto* src = reinterpret_cast<const int32_t*>(in.data());
+            auto* dst = reinterpret_cast<int32_t*>(out.data());
+            for(; c + 4 <= m_channels; c += 4)
+                avx_process(src + c, dst + c, frames, c);
+        }
+#endif
+        for(; c < m_channels; ++c)
+        {
+            T x1 = m_x1[c], x2 = m_x2[c], y1 = m_y1[c], y2 = m_y2[c];
+            for(size_t n = 0; n < frames; ++n)
+            {
+                const T x = in[n * m_channels + c].internal_value();
+                const I sum = static_cast<I>(m_coeffs.b0.internal_value()) * x + static_cast<I>(m_coeffs.b1.internal_value()) * x1 +
+                              static_cast<I>(m_coeffs.b2.internal_value()) * x2 - static_cast<I>(m_coeffs.a1.internal_value()) * y1 -
+                              static_cast<I>(m_coeffs.a2.internal_value()) * y2;
+                const auto y = eirin::detail::narrow_product<T, I, f, r>(sum);
+                out[n * m_channels + c] = y;
+                x2 = x1, x1 = x, y2 = y1, y1 = y.internal_value();
+            }
+            m_x1[c] = x1, m_x2[c] = x2, m_y1[c] = y1, m_y2[c] = y2;
+        }
+    }
+
+private:
+    biquad_coefficients<value_type> m_coeffs;
+    size_t m_channels;
+    std::vector<T> m_x1, m_x2, m_y1, m_y2;
+
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+    // the channels c..c + 3 of fixed32, the states are kept in the low 32 bits of the lanes, which is all _mm256_mul_epi32 reads.
+    void avx_process(const int32_t* in, int32_t* out, size_t frames, size_t c) noexcept
+    {
+        const __m256i b0 = _mm256_set1_epi64x(m_coeffs.b0.internal_value()), b1 = _mm256_set1_epi64x(m_coeffs.b1.internal_value());
+        const __m256i b2 = _mm256_set1_epi64x(m_coeffs.b2.internal_value()), a1 = _mm256_set1_epi64x(m_coeffs.a1.internal_value());
+        const __m256i a2 = _mm256_set1_epi64x(m_coeffs.a2.internal_value());
+        __m256i x1 = detail::avx_mm256_load_epi32_epi64(m_x1.data() + c), x2 = detail::avx_mm256_load_epi32_epi64(m_x2.data() + c);
+        __m256i y1 = detail::avx_mm256_load_epi32_epi64(m_y1.data() + c), y2 = detail::avx_mm256_load_epi32_epi64(m_y2.data() + c);
+        for(size_t n = 0; n < frames; ++n)
+        {
+            const __m256i x = detail::avx_mm256_load_epi32_epi64(in + n * m_channels);
+            const __m256i feed = _mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epi32(b0, x), _mm256_mul_epi32(b1, x1)), _mm256_mul_epi32(b2, x2));
+            const __m256i back = _mm256_add_epi64(_mm256_mul_epi32(a1, y1), _mm256_mul_epi32(a2, y2));
+            const __m256i y = _mm256_srli_epi64(_mm256_sub_epi64(feed, back), f);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + n * m_channels), detail::avx_mm256_pack_epi64_epi32(y));
+            x2 = x1, x1 = x, y2 = y1, y1 = y;
+        }
+        const auto store = [](int32_t* p, __m256i v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), detail::avx_mm256_pack_epi64_epi32(v)); };
+        store(m_x1.data() + c, x1), store(m_x2.data() + c, x2), store(m_y1.data() + c, y1), store(m_y2.data() + c, y2);
+    }
+#endif
+};
+} // namespace eirin::dsp
+
+#endif
@@ -5,6 +5,8 @@
 
 #include "fixed.hpp"
 #include "math.hpp"
+#include "poly.hpp"
+#include "vec.hpp"
 #include "io/parse.hpp"
 #include "macro.hpp"
 #include "numbers.hpp"
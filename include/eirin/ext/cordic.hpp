@@ -4,60 +4,146 @@
 #include "../fixed.hpp"
 #include "../numbers.hpp"
 #include "../math.hpp"
+#include <bit>
+#include <limits>
+#include <type_traits>
+#include <utility>
 
 namespace eirin
 {
 namespace detail
 {
+    // the number of entries of the CORDIC angle tables, enough for every shift of a 64 bits store type.
+    inline constexpr size_t cordic_table_size = 64;
+
+    /**
+     * @brief Shift the value right to nearest, or left when the shift is negative.
+     */
+    template <typename I>
+    constexpr I cordic_round(I value, int shift) noexcept
+    {
+        if(shift <= 0)
+            return value << -shift;
+        return (value + (I(1) << (shift - 1))) >> shift;
+    }
+
+    /**
+     * @brief atan(2^-i) or atanh(2^-i) for i > 0 with P fraction bits, by the power series
+     *        sum of (+-1)^k * 2^(-i * (2k + 1)) / (2k + 1), which only needs shifts and small divisions.
+     */
+    template <typename I, unsigned int P, bool hyperbolic>
+    constexpr I cordic_arctan_series(unsigned int i) noexcept
+    {
+        I sum = I(0);
+        for(unsigned int k = 0; i * (2 * k + 1) < P; ++k)
+        {
+            I term = (I(1) << (P - i * (2 * k + 1))) / static_cast<I>(2 * k + 1);
+            sum += (hyperbolic || k % 2 == 0) ? term : -term;
+        }
+        return sum;
+    }
+
+    /**
+     * @brief The product of sqrt(1 + 2^-2i) for the circular gain, or sqrt(1 - 2^-2i) for the hyperbolic gain,
+     *        with P fraction bits. The hyperbolic iterations start from 1 and repeat the 4, 13, 40, ... steps.
+     */
+    template <typename I, unsigned int P, bool hyperbolic>
+    constexpr I cordic_gain_product(size_t count) noexcept
+    {
+        static_assert(2 * P + 2 < sizeof(I) * 8, "the squared gain must fit in the intermediate type");
+        auto factor = [](size_t i) -> I
+        {
+            constexpr I one = I(1) << (2 * P);
+            const I delta = i <= P ? one >> (2 * i) : I(0);
+            return isqrt<I>(hyperbolic ? one - delta : one + delta);
+        };
+        I product = I(1) << P;
+        size_t repeat = 4;
+        for(size_t i = hyperbolic ? 1 : 0; i < count + (hyperbolic ? 1 : 0); ++i)
+        {
+            product = (product * factor(i)) >> P;
+            if(hyperbolic && i == repeat)
+            {
+                product = (product * factor(i)) >> P;
+                repeat = 3 * repeat + 1;
+            }
+        }
+        return product;
+    }
+
+    template <fixed_point FP>
+    struct cordic_constants;
+
+    template <typename T, typename I, unsigned int f, bool r>
+    struct cordic_constants<fixed_num<T, I, f, r>>
+    {
+        using fixed = fixed_num<T, I, f, r>;
+        // the precision of the series and the gain products.
+        static constexpr unsigned int series_bits = sizeof(I) * 8 - 3;
+        static constexpr unsigned int gain_bits = (sizeof(I) * 8 - 4) / 2;
+
+        static constexpr fixed circular_gain()
+        {
+            static_assert(f <= gain_bits, "fraction is too large for the gain precision");
+            constexpr I product = cordic_gain_product<I, gain_bits, false>(cordic_table_size);
+            return fixed::from_internal_value(static_cast<T>(cordic_round<I>((I(1) << (2 * gain_bits)) / product, gain_bits - f)));
+        }
+
+        template <size_t count>
+        static constexpr fixed hyperbolic_inverse_gain()
+        {
+            static_assert(f <= gain_bits, "fraction is too large for the gain precision");
+            constexpr I product = cordic_gain_product<I, gain_bits, true>(count);
+            return fixed::from_internal_value(static_cast<T>(cordic_round<I>((I(1) << (2 * gain_bits)) / product, gain_bits - f)));
+        }
+
+        template <bool hyperbolic>
+        static constexpr std::array<fixed, cordic_table_size> generate_angles()
+        {
+            static_assert(f < series_bits, "fraction is too large for the series precision");
+            std::array<fixed, cordic_table_size> arr{};
+            for(unsigned int i = 0; i < cordic_table_size; ++i)
+            {
+                I value = I(0);
+                if(i == 0)
+                    // atan(1) converges too slow, and atanh(1) is never used.
+                    value = hyperbolic ? I(0) : static_cast<I>(numbers::pi_v<fixed_num<T, I, f, r>>().internal_value()) >> 2;
+                else if(i * 1u < series_bits)
+                    value = cordic_round<I>(cordic_arctan_series<I, series_bits, hyperbolic>(i), series_bits - f);
+                arr[i] = fixed::from_internal_value(static_cast<T>(value));
+            }
+            return arr;
+        }
+    };
+
     // CORDIC constants for fixed-point calculations.
     template <fixed_point T>
     EIRIN_ALWAYS_INLINE constexpr T cordic_k()
     {
-        T val;
-        fixed_from_cstring("0.6072529350088812561694", 22, val);
-        return val;
+        return cordic_constants<T>::circular_gain();
     }
 
     template <fixed_point T>
-    const T K = cordic_k<T>();
+    constexpr T K = cordic_k<T>();
 
+    // atan(1), atan(1/2), atan(1/4), etc.
     template <typename T, typename I, unsigned int f, bool r>
     struct cordic_angels
     {
-        using fixed = fixed_num<T, I, f, r>;
-        static constexpr std::array<fixed, 41> generate_values()
-        {
-            std::array<fixed, 41> arr;
-            const char* angle_strs[41] = {
-                "0.785398163397448", "0.463647609000806", "0.244978663126864", 
-                "0.124354994546761", "0.062418809995957", "0.031239833430268", 
-                "0.015623728620477", "0.007812341060101", "0.003906230131967", 
-                "0.001953122516479", "0.000976562189559", "0.000488281211195", 
-                "0.000244140620149", "0.000122070311894", "0.000061035156174", 
-                "0.000030517578116", "0.000015258789061", "0.000007629394531", 
-                "0.000003814697266", "0.000001907348633", "0.000000953674316", 
-                "0.000000476837158", "0.000000238418579", "0.000000119209290", 
-                "0.000000059604645", "0.000000029802322", "0.000000014901161", 
-                "0.000000007450581", "0.000000003725290", "0.000000001862645", 
-                "0.000000000931323", "0.000000000465661", "0.000000000232831", 
-                "0.000000000116415", "0.000000000058208", "0.000000000029104", 
-                "0.000000000014552", "0.000000000007276", "0.000000000003638", 
-                "0.000000000001819", "0.000000000000909"
-            };
-            for (size_t i = 0; i < 41; ++i) {
-                fixed_from_cstring(angle_strs[i], 22, arr[i]);
-            }
-            return arr;
-        }
+        static constexpr auto values = cordic_constants<fixed_num<T, I, f, r>>::template generate_angles<false>();
+    };
 
-        static constexpr std::array<fixed, 41> values = generate_values();
+    // unused, atanh(1/2), atanh(1/4), etc.
+    template <typename T, typename I, unsigned int f, bool r>
+    struct cordic_hyperbolic_angels
+    {
+        static constexpr auto values = cordic_constants<fixed_num<T, I, f, r>>::template generate_angles<true>();
     };
 
-    // atan1, atan(1/2), atan(1/4), etc.
     template <typename T, typename I, unsigned int f, bool r, size_t count>
     EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> angel(size_t index)
     {
-        static_assert(count > 0 && count <= 41, "count must be in (0, 41]");
+        static_assert(count > 0 && count <= cordic_table_size, "count must be in (0, cordic_table_size]");
         return cordic_angels<T, I, f, r>::values[index];
     }
 
@@ -81,10 +167,8 @@ namespace detail
 
         sin_sign = Q < const_0 ? -1 : 1;
 
-        // abs Q with signbit mask.
-        auto sign_mask = Q.signbit_mask();
-        auto abs_value = Q.m_value & ~sign_mask;
-        Q = FP::from_internal_value(abs_value);
+        // clearing the sign bit is not the absolute value in two's complement.
+        Q = abs(Q);
 
         // scale angel into [-2*pi, 2*pi].
         Q %= double_pi;
@@ -103,12 +187,17 @@ namespace detail
         return Q;
     }
 
-    template <typename T, typename I, unsigned int f, bool r, size_t count, bool sine = true>
-    EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> cordic(fixed_num<T, I, f, r> Q)
+    /**
+     * @brief CORDIC rotation mode, computes both sine and cosine of the angle Q.
+     * 
+     * @return {sin(Q), cos(Q)}
+     */
+    template <typename T, typename I, unsigned int f, bool r, size_t count>
+    EIRIN_ALWAYS_INLINE constexpr std::pair<fixed_num<T, I, f, r>, fixed_num<T, I, f, r>> cordic_rotate(fixed_num<T, I, f, r> Q)
     {
         using fixed = fixed_num<T, I, f, r>;
         int8_t sin_sign = 1, cos_sign = 1;
-        Q = cordic_optimize_angel<fixed, sine>(Q, sin_sign, cos_sign);
+        Q = cordic_optimize_angel<fixed>(Q, sin_sign, cos_sign);
 
         I x = static_cast<I>(K<fixed>.m_value), y = I(0), temp = I(0);
         fixed q = fixed(0);
@@ -129,15 +218,368 @@ namespace detail
                 q -= angel<T, I, f, r, count>(i);
             }
         }
+        return {fixed::from_internal_value(static_cast<T>(y) * sin_sign), fixed::from_internal_value(static_cast<T>(x) * cos_sign)};
+    }
+
+    template <typename T, typename I, unsigned int f, bool r, size_t count, bool sine = true>
+    EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> cordic(fixed_num<T, I, f, r> Q)
+    {
+        auto [sin_res, cos_res] = cordic_rotate<T, I, f, r, count>(Q);
         if constexpr(sine)
         {
-            return fixed::from_internal_value(static_cast<T>(y) * sin_sign);
+            return sin_res;
         }
         else
         {
-            return fixed::from_internal_value(static_cast<T>(x) * cos_sign);
+            return cos_res;
         }
     }
+
+    /**
+     * @brief Saturate a raw value of the intermediate type into the store type.
+     */
+    template <typename T, typename I>
+    EIRIN_ALWAYS_INLINE constexpr T cordic_saturate(I value) noexcept
+    {
+        if(value > static_cast<I>(std::numeric_limits<T>::max()))
+            return std::numeric_limits<T>::max();
+        if(value < static_cast<I>(std::numeric_limits<T>::min()))
+            return std::numeric_limits<T>::min();
+        return static_cast<T>(value);
+    }
+
+    /**
+     * @brief CORDIC vectoring mode, rotates (x, y) onto the positive x axis with shifts and adds only.
+     * The vector is normalized to the full width of the store type before the iterations, so the loop
+     * never touches the intermediate type and small inputs keep their precision. The angle is accumulated
+     * with W - 3 fraction bits, and the CORDIC gain is compensated with a single multiplication at the end.
+     * 
+     * @return {atan2(y, x), hypot(x, y)}
+     */
+    template <typename T, typename I, unsigned int f, bool r, size_t count>
+    EIRIN_ALWAYS_INLINE constexpr std::pair<fixed_num<T, I, f, r>, fixed_num<T, I, f, r>> cordic_vectoring(fixed_num<T, I, f, r> x, fixed_num<T, I, f, r> y)
+    {
+        using fixed = fixed_num<T, I, f, r>;
+        using U = std::make_unsigned_t<T>;
+        constexpr int width = sizeof(T) * 8;
+        constexpr unsigned int work_f = width - 3;
+        using work = fixed_num<T, I, work_f, r>;
+        constexpr auto pi = numbers::pi_v<work>();
+        // the gain compensation with W - 2 fraction bits.
+        constexpr auto gain = static_cast<I>(cordic_k<fixed_num<T, I, width - 2, r>>().internal_value());
+
+        I wx = static_cast<I>(x.internal_value()), wy = static_cast<I>(y.internal_value());
+        if(wx == I(0) && wy == I(0))
+            return {fixed(0), fixed(0)};
+
+        // rotate the left half plane by pi, so the remaining angle is in [-pi/2, pi/2].
+        work z = work(0);
+        if(wx < I(0))
+        {
+            z = wy < I(0) ? -pi : pi;
+            wx = -wx;
+            wy = -wy;
+        }
+
+        // move the highest bit of max(|x|, |y|) to bit W - 4, which leaves room for the gain and the sqrt(2) growth.
+        const U bits = static_cast<U>(wx) | static_cast<U>(wy < I(0) ? -wy : wy);
+        const int shift = std::countl_zero(bits) - 3;
+        T cx = static_cast<T>(shift >= 0 ? wx << shift : wx >> -shift);
+        T cy = static_cast<T>(shift >= 0 ? wy << shift : wy >> -shift);
+        T temp = T(0);
+
+        // shifting by the width or more is undefined, and those steps would not change x or y anyway.
+        constexpr size_t iterations = count < width - 1 ? count : width - 1;
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            if(cy > T(0))
+            {
+                temp = cx + (cy >> i);
+                cy = cy - (cx >> i);
+                cx = temp;
+                z += angel<T, I, work_f, r, count>(i);
+            }
+            else
+            {
+                temp = cx - (cy >> i);
+                cy = cy + (cx >> i);
+                cx = temp;
+                z -= angel<T, I, work_f, r, count>(i);
+            }
+        }
+
+        // x times the gain, then scale back from 2^shift, the magnitude of (max, max) is above the max value and saturates.
+        const I magnitude = (static_cast<I>(cx) * gain) >> (width - 2 + shift);
+        return {fixed::template from_fixed_num_value<work_f>(z.internal_value()), fixed::from_internal_value(cordic_saturate<T>(magnitude))};
+    }
+
+    // the fraction bits of the hyperbolic kernels, the values are in (-4, 4).
+    template <typename T>
+    inline constexpr unsigned int cordic_work_bits = sizeof(T) * 8 - 3;
+
+    /**
+     * @brief Hyperbolic CORDIC rotation mode on raw values with W - 3 fraction bits.
+     * The iterations run from 1 to count and repeat the 4, 13, 40, ... steps, which is required for convergence.
+     * 
+     * @param z the angle, |z| must not be greater than 1.118.
+     * @return {cosh(z), sinh(z)}
+     */
+    template <typename T, typename I, bool r, size_t count>
+    EIRIN_ALWAYS_INLINE constexpr std::pair<T, T> cordic_hyperbolic_rotate(T z) noexcept
+    {
+        constexpr unsigned int work_f = cordic_work_bits<T>;
+        using work = fixed_num<T, I, work_f, r>;
+        using angles = cordic_hyperbolic_angels<T, I, work_f, r>;
+        static_assert(count > 0 && count <= work_f, "count must be in (0, W - 3]");
+
+        T x = cordic_constants<work>::template hyperbolic_inverse_gain<count>().internal_value(), y = T(0), temp = T(0);
+        auto step = [&](size_t i)
+        {
+            const T angle = angles::values[i].internal_value();
+            if(z >= T(0))
+            {
+                temp = x + (y >> i);
+                y = y + (x >> i);
+                z -= angle;
+            }
+            else
+            {
+                temp = x - (y >> i);
+                y = y - (x >> i);
+                z += angle;
+            }
+            x = temp;
+        };
+        for(size_t i = 1, repeat = 4; i <= count; ++i)
+        {
+            step(i);
+            if(i == repeat)
+            {
+                step(i);
+                repeat = 3 * repeat + 1;
+            }
+        }
+        return {x, y};
+    }
+
+    /**
+     * @brief Hyperbolic CORDIC vectoring mode on raw values with W - 3 fraction bits.
+     * 
+     * @param x must be positive.
+     * @param y |y / x| must not be greater than 0.806.
+     * @return {atanh(y / x), sqrt(x^2 - y^2)}, the magnitude is not compensated by the gain.
+     */
+    template <typename T, typename I, bool r, size_t count>
+    EIRIN_ALWAYS_INLINE constexpr std::pair<T, T> cordic_hyperbolic_vectoring(T x, T y) noexcept
+    {
+        constexpr unsigned int work_f = cordic_work_bits<T>;
+        using angles = cordic_hyperbolic_angels<T, I, work_f, r>;
+        static_assert(count > 0 && count <= work_f, "count must be in (0, W - 3]");
+
+        T z = T(0), temp = T(0);
+        auto step = [&](size_t i)
+        {
+            const T angle = angles::values[i].internal_value();
+            if(y > T(0))
+            {
+                temp = x - (y >> i);
+                y = y - (x >> i);
+                z += angle;
+            }
+            else
+            {
+                temp = x + (y >> i);
+                y = y + (x >> i);
+                z -= angle;
+            }
+            x = temp;
+        };
+        for(size_t i = 1, repeat = 4; i <= count; ++i)
+        {
+            step(i);
+            if(i == repeat)
+            {
+                step(i);
+                repeat = 3 * repeat + 1;
+            }
+        }
+        return {z, x};
+    }
+
+    /**
+     * @brief Linear CORDIC vectoring mode, y / x on raw values with W - 3 fraction bits.
+     * 
+     * @param x must be positive.
+     * @param y |y / x| must be less than 2.
+     */
+    template <typename T>
+    EIRIN_ALWAYS_INLINE constexpr T cordic_linear_divide(T x, T y) noexcept
+    {
+        constexpr unsigned int work_f = cordic_work_bits<T>;
+        T z = T(0);
+        for(unsigned int i = 0; i <= work_f; ++i)
+        {
+            if(y > T(0))
+            {
+                y -= x >> i;
+                z += T(1) << (work_f - i);
+            }
+            else
+            {
+                y += x >> i;
+                z -= T(1) << (work_f - i);
+            }
+        }
+        return z;
+    }
+
+    /**
+     * @brief Split x into n * ln2 + t with t in [0, ln2), so that e^x = e^t * 2^n.
+     * 
+     * @return {t with W - 3 fraction bits, n}
+     */
+    template <typename T, typename I, unsigned int f, bool r>
+    EIRIN_ALWAYS_INLINE constexpr std::pair<T, I> cordic_exp_reduce(fixed_num<T, I, f, r> x) noexcept
+    {
+        constexpr unsigned int work_f = cordic_work_bits<T>;
+        using work = fixed_num<T, I, work_f, r>;
+        constexpr auto log2_e = static_cast<I>(numbers::log2e_v<work>().internal_value());
+        constexpr auto ln2 = static_cast<I>(numbers::ln2_v<work>().internal_value());
+
+        const auto value = static_cast<I>(x.internal_value());
+        I n = (value * log2_e) >> (work_f + f);
+        I t = (value << (work_f - f)) - n * ln2;
+        // the truncated log2(e) may put t just outside of [0, ln2).
+        if(t < I(0))
+        {
+            t += ln2;
+            --n;
+        }
+        else if(t >= ln2)
+        {
+            t -= ln2;
+            ++n;
+        }
+        return {static_cast<T>(t), n};
+    }
+
+    template <typename T, typename I, unsigned int f, bool r, size_t count>
+    EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> cordic_exp(fixed_num<T, I, f, r> x) noexcept
+    {
+        using fixed = fixed_num<T, I, f, r>;
+        constexpr int width = sizeof(T) * 8;
+        constexpr int work_f = cordic_work_bits<T>;
+
+        auto [t, n] = cordic_exp_reduce(x);
+        // e^t is in [1, 2), so the result overflows from n = W - 1 - f, and rounds to zero below 2^-f.
+        if(n > I(width - 2 - static_cast<int>(f)))
+            return std::numeric_limits<fixed>::max();
+        const int shift = work_f - static_cast<int>(f) - static_cast<int>(n);
+        if(shift >= width - 1)
+            return fixed(0);
+
+        auto [c, s] = cordic_hyperbolic_rotate<T, I, r, count>(t);
+        return fixed::from_internal_value(static_cast<T>(cordic_round<I>(static_cast<I>(c) + static_cast<I>(s), shift)));
+    }
+
+    /**
+     * @return {sinh(x), cosh(x)}
+     */
+    template <typename T, typename I, unsigned int f, bool r, size_t count>
+    EIRIN_ALWAYS_INLINE constexpr std::pair<fixed_num<T, I, f, r>, fixed_num<T, I, f, r>> cordic_sinh_cosh(fixed_num<T, I, f, r> x) noexcept
+    {
+        using fixed = fixed_num<T, I, f, r>;
+        constexpr int width = sizeof(T) * 8;
+        constexpr int work_f = cordic_work_bits<T>;
+        constexpr auto max = std::numeric_limits<fixed>::max();
+
+        const bool negative = x < fixed(0);
+        auto [t, n] = cordic_exp_reduce(negative ? -x : x);
+        // both are greater than e^x / 2 >= 2^(n - 1).
+        if(n >= I(width - static_cast<int>(f)))
+            return {negative ? -max : max, max};
+
+        // e^x = (cosh(t) + sinh(t)) * 2^n and e^-x = (cosh(t) - sinh(t)) * 2^-n.
+        auto [c, s] = cordic_hyperbolic_rotate<T, I, r, count>(t);
+        const I pos = (static_cast<I>(c) + static_cast<I>(s)) << static_cast<int>(n);
+        const I neg = (static_cast<I>(c) - static_cast<I>(s)) >> static_cast<int>(n);
+        // the extra shift is the division by 2.
+        const T sinh_v = cordic_saturate<T>(cordic_round<I>(pos - neg, work_f - static_cast<int>(f) + 1));
+        const T cosh_v = cordic_saturate<T>(cordic_round<I>(pos + neg, work_f - static_cast<int>(f) + 1));
+        return {fixed::from_internal_value(negative ? -sinh_v : sinh_v), fixed::from_internal_value(cosh_v)};
+    }
+
+    template <typename T, typename I, unsigned int f, bool r, size_t count>
+    EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> cordic_tanh(fixed_num<T, I, f, r> x) noexcept
+    {
+        using fixed = fixed_num<T, I, f, r>;
+        constexpr int work_f = cordic_work_bits<T>;
+        constexpr T one = T(1) << work_f;
+        // e^(-2x) is below 2^-(f + 1) from x = (f + 1) * ln2 / 2, so tanh(x) rounds to 1.
+        constexpr auto saturation = fixed(static_cast<int>(f + 2) / 2);
+
+        const bool negative = x < fixed(0);
+        const auto abs_x = negative ? -x : x;
+        if(abs_x >= saturation)
+            return negative ? fixed(-1) : fixed(1);
+
+        // tanh(x) = (1 - e^(-2x)) / (1 + e^(-2x)), and e^(-2x) is in (0, 1].
+        auto [t, n] = cordic_exp_reduce(-(abs_x + abs_x));
+        auto [c, s] = cordic_hyperbolic_rotate<T, I, r, count>(t);
+        const T u = static_cast<T>(cordic_round<I>(static_cast<I>(c) + static_cast<I>(s), -static_cast<int>(n)));
+        const T q = cordic_linear_divide<T>(one + u, one - u);
+        const T result = static_cast<T>(cordic_round<I>(static_cast<I>(q), work_f - static_cast<int>(f)));
+        return fixed::from_internal_value(negative ? -result : result);
+    }
+
+    template <typename T, typename I, unsigned int f, bool r, size_t count>
+    EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> cordic_log(fixed_num<T, I, f, r> x)
+    {
+        using fixed = fixed_num<T, I, f, r>;
+        using U = std::make_unsigned_t<T>;
+        constexpr int width = sizeof(T) * 8;
+        constexpr int work_f = cordic_work_bits<T>;
+        constexpr T one = T(1) << work_f;
+        constexpr auto ln2 = static_cast<I>(numbers::ln2_v<fixed_num<T, I, work_f, r>>().internal_value());
+        if(x <= fixed(0))
+            EIRIN_THROW_EXCEPTION(std::domain_error, "cordic_log() domain error");
+
+        // x = m * 2^e with m in [1, 2), and log(m) = 2 * atanh((m - 1) / (m + 1)).
+        const T raw = x.internal_value();
+        const int msb = width - 1 - std::countl_zero(static_cast<U>(raw));
+        const int shift = work_f - msb;
+        const T m = shift >= 0 ? static_cast<T>(raw << shift) : static_cast<T>(raw >> -shift);
+        auto [z, magnitude] = cordic_hyperbolic_vectoring<T, I, r, count>(m + one, m - one);
+        const I result = static_cast<I>(z) * 2 + static_cast<I>(msb - static_cast<int>(f)) * ln2;
+        return fixed::from_internal_value(static_cast<T>(cordic_round<I>(result, work_f - static_cast<int>(f))));
+    }
+
+    template <typename T, typename I, unsigned int f, bool r, size_t count>
+    EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> cordic_sqrt(fixed_num<T, I, f, r> x)
+    {
+        using fixed = fixed_num<T, I, f, r>;
+        using U = std::make_unsigned_t<T>;
+        constexpr int width = sizeof(T) * 8;
+        constexpr int work_f = cordic_work_bits<T>;
+        constexpr T quarter = T(1) << (work_f - 2);
+        constexpr auto inverse_gain = static_cast<I>(cordic_constants<fixed_num<T, I, work_f, r>>::template hyperbolic_inverse_gain<count>().internal_value());
+        if(x < fixed(0))
+            EIRIN_THROW_EXCEPTION(std::domain_error, "cordic_sqrt() domain error");
+        if(x == fixed(0))
+            return fixed(0);
+
+        // x = m * 4^e with m in [0.5, 2), and sqrt(m) = sqrt((m + 1/4)^2 - (m - 1/4)^2).
+        const T raw = x.internal_value();
+        const int msb = width - 1 - std::countl_zero(static_cast<U>(raw));
+        const int exponent = msb - static_cast<int>(f);
+        const bool odd = (exponent & 1) != 0;
+        const int shift = work_f - odd - msb;
+        const T m = shift >= 0 ? static_cast<T>(raw << shift) : static_cast<T>(raw >> -shift);
+        auto [z, magnitude] = cordic_hyperbolic_vectoring<T, I, r, count>(m + quarter, m - quarter);
+        const I root = (static_cast<I>(magnitude) * inverse_gain) >> work_f;
+        const int half_exponent = (exponent + odd) / 2;
+        return fixed::from_internal_value(static_cast<T>(cordic_round<I>(root, work_f - static_cast<int>(f) - half_exponent)));
+    }
 } // namespace detail
 
 #ifdef EIRIN_MATH_HAS_INT128
@@ -150,6 +592,104 @@ EIRIN_ALWAYS_INLINE constexpr auto cordic_sine(fixed32 x) noexcept
 {
     return detail::cordic<int32_t, int64_t, 16, false, 41, true>(x);
 }
+
+#ifdef EIRIN_MATH_HAS_INT128
+/**
+ * @brief sine and cosine with a single CORDIC rotation.
+ * 
+ * @return {sin(x), cos(x)}
+ */
+EIRIN_ALWAYS_INLINE constexpr auto cordic_sincos(fixed64 x) noexcept
+{
+    return detail::cordic_rotate<int64_t, detail::int128_t, 32, false, 41>(x);
+}
+#endif
+EIRIN_ALWAYS_INLINE constexpr auto cordic_sincos(fixed32 x) noexcept
+{
+    return detail::cordic_rotate<int32_t, int64_t, 16, false, 41>(x);
+}
+
+#ifdef EIRIN_MATH_HAS_INT128
+/**
+ * @brief atan2 and hypot with a single CORDIC vectoring pass, without any division.
+ * 
+ * @return {hypot(x, y), atan2(y, x)}
+ */
+EIRIN_ALWAYS_INLINE constexpr auto cordic_polar(fixed64 x, fixed64 y) noexcept
+{
+    auto [angle, magnitude] = detail::cordic_vectoring<int64_t, detail::int128_t, 32, false, 41>(x, y);
+    return std::pair{magnitude, angle};
+}
+#endif
+EIRIN_ALWAYS_INLINE constexpr auto cordic_polar(fixed32 x, fixed32 y) noexcept
+{
+    auto [angle, magnitude] = detail::cordic_vectoring<int32_t, int64_t, 16, false, 41>(x, y);
+    return std::pair{magnitude, angle};
+}
+
+template <fixed_point FP>
+EIRIN_ALWAYS_INLINE constexpr FP cordic_atan2(FP y, FP x) noexcept
+{
+    return cordic_polar(x, y).second;
+}
+
+template <fixed_point FP>
+EIRIN_ALWAYS_INLINE constexpr FP cordic_hypot(FP x, FP y) noexcept
+{
+    return cordic_polar(x, y).first;
+}
+
+/**
+ * @brief Exponential function with the hyperbolic CORDIC, using shifts and adds only.
+ * The argument is split into n * ln2 + t, so e^x = (cosh(t) + sinh(t)) * 2^n, and the result
+ * saturates to the max value on overflow.
+ * 
+ * @tparam count the CORDIC iterations, the 4, 13, 40, ... steps are repeated.
+ */
+template <typename T, typename I, unsigned int f, bool r, size_t count = detail::cordic_work_bits<T>>
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> cordic_exp(fixed_num<T, I, f, r> x) noexcept
+{
+    return detail::cordic_exp<T, I, f, r, count>(x);
+}
+
+/**
+ * @brief Natural logarithm with the hyperbolic CORDIC vectoring mode, using shifts and adds only.
+ */
+template <typename T, typename I, unsigned int f, bool r, size_t count = detail::cordic_work_bits<T>>
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> cordic_log(fixed_num<T, I, f, r> x)
+{
+    return detail::cordic_log<T, I, f, r, count>(x);
+}
+
+/**
+ * @brief Square root with the hyperbolic CORDIC vectoring mode, sqrt(x) = sqrt((x + 1/4)^2 - (x - 1/4)^2).
+ */
+template <typename T, typename I, unsigned int f, bool r, size_t count = detail::cordic_work_bits<T>>
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> cordic_sqrt(fixed_num<T, I, f, r> x)
+{
+    return detail::cordic_sqrt<T, I, f, r, count>(x);
+}
+
+template <typename T, typename I, unsigned int f, bool r, size_t count = detail::cordic_work_bits<T>>
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> cordic_sinh(fixed_num<T, I, f, r> x) noexcept
+{
+    return detail::cordic_sinh_cosh<T, I, f, r, count>(x).first;
+}
+
+template <typename T, typename I, unsigned int f, bool r, size_t count = detail::cordic_work_bits<T>>
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> cordic_cosh(fixed_num<T, I, f, r> x) noexcept
+{
+    return detail::cordic_sinh_cosh<T, I, f, r, count>(x).second;
+}
+
+/**
+ * @brief Hyperbolic tangent, the division is done by the linear CORDIC vectoring mode.
+ */
+template <typename T, typename I, unsigned int f, bool r, size_t count = detail::cordic_work_bits<T>>
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> cordic_tanh(fixed_num<T, I, f, r> x) noexcept
+{
+    return detail::cordic_tanh<T, I, f, r, count>(x);
+}
 } // namespace eirin
 
 #endif // EIRIN_MATH_EXT_CORDIC_HPP
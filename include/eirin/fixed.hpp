@@ -89,6 +89,32 @@ namespace detail
     struct is_signed<detail::int128_t> : public std::true_type
     {};
 #endif
+
+    /**
+     * @brief x / 2^k truncated toward zero like the integer division, with shifts only.
+     */
+    template <unsigned int k, typename T>
+    EIRIN_ALWAYS_INLINE constexpr T shift_right_trunc(T x) noexcept
+    {
+        if constexpr(k == 0)
+            return x;
+        else if constexpr(is_signed<T>::value)
+            // the negative values are biased by 2^k - 1, so the floor of the arithmetic shift becomes a truncation.
+            return (x + ((x >> (sizeof(T) * 8 - 1)) & ~(T(-1) << k))) >> k;
+        else
+            return x >> k;
+    }
+
+    /**
+     * @brief x / 2^k rounded half away from zero, the truncation to one more bit is rounded away from zero by its last bit.
+     */
+    template <unsigned int k, typename T>
+    EIRIN_ALWAYS_INLINE constexpr T shift_right_round(T x) noexcept
+    {
+        static_assert(k > 0, "rounding needs a dropped bit");
+        const T q = shift_right_trunc<k - 1>(x);
+        return (q >> 1) + (q & static_cast<T>(q > T(0)));
+    }
 } // namespace detail
 
 template <typename Type, unsigned int fraction>
@@ -132,6 +158,16 @@ class fixed_num
 
     static constexpr IntermediateType fraction_multiplier = IntermediateType(1) << fraction;
 
+    // 2^fraction as a floating point value, built by doubling so it does not depend on the conversions of IntermediateType.
+    template <std::floating_point T>
+    static constexpr T floating_multiplier = []
+    {
+        T res = 1;
+        for(unsigned int i = 0; i < fraction; ++i)
+            res *= 2;
+        return res;
+    }();
+
     constexpr inline fixed_num(Type val, raw_value_construct_tag) noexcept
         : m_value(val) {};
 
@@ -154,31 +190,27 @@ public:
     EIRIN_ALWAYS_INLINE constexpr explicit fixed_num(T val) noexcept
         : m_value(static_cast<Type>(val) << fraction){};
 
+    /**
+     * @brief Construct the fixed number from a floating point value, truncated toward zero,
+     *        or rounded half away from zero if rounding is enabled.
+     * The scaling by 2^fraction is exact, so the only error is the final conversion to an integer.
+     *
+     * @tparam T floating point type.
+     * @param val the input floating point value, it must be in the range of the fixed number.
+     */
     template <std::floating_point T>
     EIRIN_ALWAYS_INLINE constexpr explicit fixed_num(T val) noexcept
     {
-        if constexpr(std::is_class_v<IntermediateType>)
-        {
-            if constexpr(rounding)
-            {
-                m_value = static_cast<Type>(
-                    val >= 0.0 ?
-                        (val * T{0.5} * fraction_multiplier) :
-                        (val * fraction_multiplier - T{0.5})
-                );
-            }
-            else
-            {
-                m_value = static_cast<Type>(
-                    Type(val) * fraction_multiplier
-                );
-            }
-        }
-        else
+        const T scaled = val * floating_multiplier<T>;
+        m_value = static_cast<Type>(scaled);
+        if constexpr(rounding)
         {
-            m_value = static_cast<Type>(
-                rounding ? (val >= 0.0) ? (val * fraction_multiplier * T{0.5}) : (val * fraction_multiplier - T{0.5}) : (val * fraction_multiplier)
-            );
+            // the fraction dropped by the truncation is exact, unlike scaled +- 0.5 near the precision of T.
+            const T dropped = scaled - static_cast<T>(m_value);
+            if(dropped >= T{0.5})
+                ++m_value;
+            else if(dropped <= T{-0.5})
+                --m_value;
         }
     };
 
@@ -241,6 +273,8 @@ public:
 
     static constexpr inline auto precision = fraction;
 
+    static constexpr inline bool is_rounding = rounding;
+
     EIRIN_ALWAYS_INLINE static constexpr Type signbit_mask() noexcept
     {
         return static_cast<Type>(1) << (sizeof(Type) * 8 - 1);
@@ -290,12 +324,14 @@ public:
         return static_cast<T>(m_value >> fraction);
     }
 
+    /**
+     * @brief Convert to a floating point value, the raw value is rounded to the nearest T, and the scaling is exact.
+     */
     template <std::floating_point T>
     constexpr inline explicit operator T() const noexcept
     {
         // MSVC might warn about precision loss here, but it's expected.
-        // SO I JUST FUCK IT BEFORE.
-        return static_cast<T>(static_cast<value_type>(m_value / fraction_multiplier));
+        return static_cast<T>(m_value) * (T{1} / floating_multiplier<T>);
     }
 
     constexpr inline fixed_num operator+(const fixed_num& other) const noexcept
@@ -489,15 +525,18 @@ public:
     template <unsigned int _fraction, typename T, typename std::enable_if_t<(_fraction > fraction), T*> = nullptr>
     EIRIN_ALWAYS_INLINE static constexpr fixed_num from_fixed_num_value(T inner_value) noexcept
     {
-        return rounding ?
-                   fixed_num(static_cast<Type>(inner_value / (T(1) << (_fraction - fraction)) + (inner_value / (T(1) << (_fraction - fraction - 1)) % 2)), raw_value_construct_tag{}) :
-                   fixed_num(static_cast<Type>(inner_value / (T(1) << (_fraction - fraction))), raw_value_construct_tag{});
+        if constexpr(rounding)
+            return fixed_num(static_cast<Type>(detail::shift_right_round<_fraction - fraction>(inner_value)), raw_value_construct_tag{});
+        else
+            return fixed_num(static_cast<Type>(detail::shift_right_trunc<_fraction - fraction>(inner_value)), raw_value_construct_tag{});
     }
 
     template <unsigned int _fraction, typename T, typename std::enable_if_t<(_fraction <= fraction), T*> = nullptr>
     EIRIN_ALWAYS_INLINE static constexpr fixed_num from_fixed_num_value(T inner_value) noexcept
     {
-        return fixed_num(static_cast<Type>(inner_value * (T(1) << (fraction - _fraction))), raw_value_construct_tag{});
+        // shifted in the wider of T and Type, so a narrower source does not overflow before the conversion.
+        using wide = std::conditional_t<(sizeof(T) > sizeof(Type)), T, Type>;
+        return fixed_num(static_cast<Type>(static_cast<wide>(inner_value) << (fraction - _fraction)), raw_value_construct_tag{});
     }
 
     static constexpr fixed_num from_internal_value(Type internal_value) noexcept
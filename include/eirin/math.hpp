@@ -4,8 +4,12 @@
 #pragma once
 
 #include "fixed.hpp"
+#include <bit>
 #include <stdexcept>
+#include <utility>
 #include "numbers.hpp"
+#include "detail/minimax.hpp"
+#include "poly.hpp"
 
 namespace eirin
 {
@@ -28,6 +32,70 @@ EIRIN_ALWAYS_INLINE constexpr T min_value() noexcept
     return std::numeric_limits<T>::min();
 }
 
+namespace detail
+{
+    /**
+     * @brief The precomputed reciprocal of a constant divisor, used by ``div_by``.
+     * The numerator of a fixed point division is ``x << f``, which is always less than 2^k with k = W - 1 + f
+     * for a W-bits store type, so with m = floor(2^k / |d|) + 1 the estimate ``(|x| * m) >> (k - f)`` is
+     * either the exact quotient or one more than it.
+     * 
+     * @tparam T @see fixed_num
+     * @tparam I @see fixed_num
+     * @tparam f @see fixed_num
+     * @tparam d the internal value of the divisor.
+     */
+    template <typename T, typename I, unsigned int f, T d>
+    struct fixed_reciprocal
+    {
+        static constexpr unsigned int width = sizeof(T) * 8;
+        static constexpr unsigned int shift = width - 1 + f;
+        static constexpr I abs_divisor = d < 0 ? -static_cast<I>(d) : static_cast<I>(d);
+        static constexpr I magic = (I(1) << shift) / abs_divisor + 1;
+        // |x| * magic must fit in the intermediate type, which holds when |d| > 0.5.
+        static constexpr bool usable = magic < (I(1) << width);
+    };
+} // namespace detail
+
+/**
+ * @brief Divide a fixed point number by a compile-time constant, replacing the runtime division
+ *        with a multiplication by the precomputed reciprocal and an exactness correction.
+ * @note The result is bit-identical to ``x / divisor``. Rounding fixed types and divisors whose
+ *       absolute value is not greater than 0.5 fall back to the ordinary division.
+ * 
+ * @tparam divisor the constant divisor, must not be zero.
+ * @tparam T @see fixed_num
+ * @tparam I @see fixed_num
+ * @tparam f @see fixed_num
+ * @tparam r @see fixed_num
+ * @param x the dividend.
+ * @return x / divisor
+ */
+template <auto divisor, typename T, typename I, unsigned int f, bool r>
+requires std::same_as<std::remove_cv_t<decltype(divisor)>, fixed_num<T, I, f, r>>
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> div_by(fixed_num<T, I, f, r> x) noexcept
+{
+    using fixed = fixed_num<T, I, f, r>;
+    using recip = detail::fixed_reciprocal<T, I, f, divisor.internal_value()>;
+    static_assert(divisor.internal_value() != 0, "div_by() divisor must not be zero");
+
+    if constexpr(r || !recip::usable)
+    {
+        return x / divisor;
+    }
+    else
+    {
+        const T value = x.internal_value();
+        const I n = value < 0 ? -static_cast<I>(value) : static_cast<I>(value);
+        I q = (n * recip::magic) >> (recip::shift - f);
+        // the estimate overshoots by at most one.
+        if(q * recip::abs_divisor > (n << f))
+            q -= 1;
+        const bool negative = (value < 0) != (divisor.internal_value() < 0);
+        return fixed::from_internal_value(static_cast<T>(negative ? -q : q));
+    }
+}
+
 template <typename T, typename I, unsigned int f, bool r>
 EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> ceil(fixed_num<T, I, f, r> fp) noexcept
 {
@@ -188,6 +256,63 @@ EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> sqrt(fixed_num<T, I, f, r> f
     }
 }
 
+namespace detail
+{
+    /**
+     * @brief Evaluates the odd minimax polynomial x * P(x^2) of ``detail/minimax.hpp`` for x in [0, 1]
+     *        with W - 2 fraction bits, so only the final rounding is added to the error of the polynomial.
+     */
+    template <minimax_poly poly, typename T, typename I, unsigned int f, bool r>
+    EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> minimax_eval(fixed_num<T, I, f, r> x) noexcept
+    {
+        using fixed = fixed_num<T, I, f, r>;
+        constexpr unsigned int P = sizeof(T) * 8 - 2;
+        static_assert(f <= P, "minimax_eval() requires the value 1 to be representable");
+        constexpr auto coeffs = []
+        {
+            std::array<T, poly.terms> arr{};
+            for(size_t i = 0; i < poly.terms; ++i)
+            {
+                if constexpr(P < minimax_fraction)
+                    arr[i] = static_cast<T>((poly.coeffs[i] + (int64_t(1) << (minimax_fraction - P - 1))) >> (minimax_fraction - P));
+                else
+                    arr[i] = static_cast<T>(static_cast<I>(poly.coeffs[i]) << (P - minimax_fraction));
+            }
+            return arr;
+        }();
+
+        // every partial sum is below 2 in magnitude, so the values stay in T and each product is a single widening multiplication.
+        const T xp = static_cast<T>(x.internal_value() << (P - f));
+        const T x2 = static_cast<T>((static_cast<I>(xp) * xp) >> P);
+        const T res = poly_eval_raw<poly_scheme::estrin, T, I, P>(coeffs, x2);
+        const I prod = static_cast<I>(res) * xp;
+        if constexpr(P == f)
+            return fixed::from_internal_value(static_cast<T>(prod >> P));
+        else
+            return fixed::from_internal_value(static_cast<T>((prod + (I(1) << (2 * P - f - 1))) >> (2 * P - f)));
+    }
+
+    /**
+     * @brief sin(pi / 2 * x) for x in [0, 1], the kernel shared by sin and sincos.
+     * @tparam bits the target precision, the lowest degree minimax polynomial with an error below 2^-bits is used.
+     */
+    template <typename T, typename I, unsigned int f, bool r, unsigned int bits = f + 1>
+    EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> sin_quarter(fixed_num<T, I, f, r> x) noexcept
+    {
+        return minimax_eval<minimax_select(minimax_sin_quarter, bits)>(x);
+    }
+
+    /**
+     * @brief atan(x) for x in [0, 1].
+     * @tparam bits the target precision, the lowest degree minimax polynomial with an error below 2^-bits is used.
+     */
+    template <typename T, typename I, unsigned int f, bool r, unsigned int bits = f + 1>
+    EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> atan_unit(fixed_num<T, I, f, r> x) noexcept
+    {
+        return minimax_eval<minimax_select(minimax_atan, bits)>(x);
+    }
+} // namespace detail
+
 /**
  * @brief sine function for fixed point number.
  * 
@@ -195,17 +320,16 @@ EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> sqrt(fixed_num<T, I, f, r> f
  * @tparam I @see fixed_num
  * @tparam f @see fixed_num
  * @tparam r @see fixed_num
- * @tparam pi the pi value, default is pi_v<fixed_num<T, I, f, r>>(). if you want more precision for fixed types like fixed128, you can pass the value you want.
  * @param fp 
  * @return sin(fp)
  */
-template <typename T, typename I, unsigned int f, bool r, fixed_num<T, I, f, r> pi = numbers::pi_v<fixed_num<T, I, f, r>>()>
+template <typename T, typename I, unsigned int f, bool r>
 EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> sin(fixed_num<T, I, f, r> fp) noexcept
 {
     using fixed = fixed_num<T, I, f, r>;
     auto x = fixed(fp);
     x %= fixed::double_pi();
-    x /= fixed::pi_2();
+    x = div_by<fixed::pi_2()>(x);
     constexpr auto fp1 = fixed(1);
     constexpr auto fp2 = fixed(2);
 
@@ -223,24 +347,57 @@ EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> sin(fixed_num<T, I, f, r> fp
     // sin(0.00015) = 0.000149999999437, so we use 0.0001 as the threshold.
     // TODO: replace it with fixed::template from_fixed_num_value<61>(0x13A92A0000000)
     if(abs(fp) < fixed(0.00015))
-        return negative ? -fp : fp;
+        return fp;
 
     // reduce the range to [0, 1] due to sin is
     // symmetrical around PI / 2 in the domain [0, PI].
     if(x > fp1)
         x = fp2 - x;
 
-    // we use tyler series to calculate sin(x).
-    // n = 4 has enough precision.
-    const auto x2 = x * x;
-    constexpr auto a = pi * pi / 24;
-    constexpr auto b = pi * pi / 80;
-    constexpr auto c = pi * pi / 168;
-    constexpr auto d = pi * pi / 288;
-    auto res = fixed::pi() * x * (fp1 - a * x2 * (fp1 - b * x2 * (fp1 - c * x2 * (fp1 - d * x2)))) / 2;
+    auto res = detail::sin_quarter<T, I, f, r>(x);
     return negative ? -res : res;
 }
 
+/**
+ * @brief sine and cosine of the same angle, sharing one range reduction.
+ * @note The sine part is identical to ``sin(fp)``, and the cosine part reuses the reduced angle
+ *       with the identity cos(pi/2 * t) = sin(pi/2 * (1 - t)).
+ * 
+ * @tparam T @see fixed_num
+ * @tparam I @see fixed_num
+ * @tparam f @see fixed_num
+ * @tparam r @see fixed_num
+ * @param fp 
+ * @return {sin(fp), cos(fp)}
+ */
+template <typename T, typename I, unsigned int f, bool r>
+EIRIN_ALWAYS_INLINE constexpr std::pair<fixed_num<T, I, f, r>, fixed_num<T, I, f, r>> sincos(fixed_num<T, I, f, r> fp) noexcept
+{
+    using fixed = fixed_num<T, I, f, r>;
+    auto x = fixed(fp);
+    x %= fixed::double_pi();
+    x = div_by<fixed::pi_2()>(x);
+
+    if(x < fixed(0))
+        x += fixed(4);
+
+    // x is in [0, 4) quarter turns now, the integral part is the quadrant.
+    const auto quadrant = static_cast<int>(x.internal_value() >> f) & 3;
+    const auto t = fixed::from_internal_value(x.internal_value() & ((T(1) << f) - 1));
+    const auto s = detail::sin_quarter<T, I, f, r>(t);
+    const auto c = detail::sin_quarter<T, I, f, r>(fixed(1) - t);
+
+    auto sin_res = (quadrant & 1) ? c : s;
+    auto cos_res = (quadrant & 1) ? s : c;
+    if(quadrant & 2)
+        sin_res = -sin_res;
+    if(quadrant == 1 || quadrant == 2)
+        cos_res = -cos_res;
+    if(abs(fp) < fixed(0.00015))
+        sin_res = fp;
+    return {sin_res, cos_res};
+}
+
 /**
  * @brief cosine function for fixed point number.
  * 
@@ -248,14 +405,14 @@ EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> sin(fixed_num<T, I, f, r> fp
  * @tparam I 
  * @tparam f 
  * @tparam r 
- * @tparam pi the pi value, default is pi_v<fixed_num<T, I, f, r>>(). if you want more precision for fixed types like fixed128, you can pass the value you want.
  * @param fp 
  * @return cos(fp)
  */
-template <typename T, typename I, unsigned int f, bool r, fixed_num<T, I, f, r> pi = numbers::pi_v<fixed_num<T, I, f, r>>()>
+template <typename T, typename I, unsigned int f, bool r>
 EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> cos(fixed_num<T, I, f, r> fp) noexcept
 {
     using fixed = fixed_num<T, I, f, r>;
+    constexpr auto pi = numbers::pi_v<fixed>();
     constexpr auto pi_2 = pi / fixed(2);
     constexpr auto double_pi = pi * fixed(2);
     return sin(fp.internal_value() > 0 ? fp - (double_pi - pi_2) : fp + pi_2);
@@ -272,52 +429,28 @@ EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> tan(fixed_num<T, I, f, r> fp
 }
 
 /**
-     * @brief Arctangent function for fixed point number, using the fitting
-     *        method from the paper "Efficient Approximations for the Arctangent Function".
-     * @note reference paper: https://ieeexplore.ieee.org/document/1628884
-     * 
-     * @tparam T @see fixed_num
-     * @tparam I @see fixed_num
-     * @tparam f @see fixed_num
-     * @tparam r @see fixed_num
-     * @tparam pi the pi value, default is pi_v<fixed_num<T, I, f, r>>(). if you want more precision for fixed types like fixed128, you can pass the value you want.
-     * @param fp the x of atan(x)
-     * @return atan(x).
-     */
-template <typename T, typename I, unsigned int f, bool r, fixed_num<T, I, f, r> pi = numbers::pi_v<fixed_num<T, I, f, r>>()>
+ * @brief Arctangent function for fixed point number, a minimax polynomial on [0, 1] selected by the precision
+ *        of the fixed point type, and atan(x) = pi / 2 - atan(1 / x) for |x| > 1.
+ * 
+ * @tparam T @see fixed_num
+ * @tparam I @see fixed_num
+ * @tparam f @see fixed_num
+ * @tparam r @see fixed_num
+ * @param fp the x of atan(x)
+ * @return atan(x).
+ */
+template <typename T, typename I, unsigned int f, bool r>
 EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> atan(fixed_num<T, I, f, r> fp) noexcept
 {
     using fixed = fixed_num<T, I, f, r>;
-    constexpr auto a = -1 * fixed::template from_fixed_num_value<61>(0X17CE62CE264A340); // 0.0464964749
-    constexpr auto b = fixed::template from_fixed_num_value<61>(0X5191A2296020A80); // 0.15931422
-    constexpr auto c = fixed::template from_fixed_num_value<61>(0XA7BE2BC19C39800); // 0.327622764
-    // TODO: because fixed point cannot represent infinity, so we need to handle the case when fp is very large.
-    auto abs_fp = abs(fp);
-    auto x = abs_fp;
-    auto x2 = x * x;
-    fixed result = ((a * x2 + b) * x2 - c) * x2 * x + x;
+    constexpr auto fp1 = fixed(1);
+    constexpr auto pi_2 = numbers::pi_v<fixed>() / fixed(2);
+    auto x = abs(fp);
+    fixed result = x > fp1 ? pi_2 - detail::atan_unit(fp1 / x) : detail::atan_unit(x);
     // if the input is negative, return negative result.
     if(fp.signbit_mask() & fp.internal_value())
         result = -result;
     return result;
-    // another calc algorithm: x / (1 + 0.28125 * x * x)
-    // constexpr auto factor = fixed::template from_fixed_num_value<61>(0X900000000000000); // 0.28125
-    // constexpr auto fp_1 = fixed(1);
-    // if(abs(fp) > fixed(1))
-    // {
-    //     constexpr auto pi_2 = pi / fixed(2);
-    //     constexpr auto neg_pi_2 = -pi_2;
-    //     auto x = fp_1 / fp;
-    //     if(fp > fixed(0))
-    //         return pi_2 - (x / (fp_1 + factor * x * x));
-    //     else
-    //         return neg_pi_2 - (x / (fp_1 + factor * x * x));
-    // }
-    // return fp / (fp_1 + factor * fp * fp);
-    // constexpr auto a = fixed::template from_fixed_num_value<61>(0X730BE0DED288D00); // 0.2247
-    // constexpr auto b = fixed::template from_fixed_num_value<61>(0X21F212D77318FC0); // 0.0663
-    // constexpr auto pi_4 = pi / fixed(4);
-    // return pi_4 * fp - fp * (abs(fp) - fixed(1)) * (a - b * abs(fp));
 }
 
 template <typename T, typename I, unsigned int f, bool r, fixed_num<T, I, f, r> pi = numbers::pi_v<fixed_num<T, I, f, r>>()>
@@ -348,35 +481,114 @@ EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> acos(fixed_num<T, I, f, r> f
     return pi / 2 - asin(fp);
 }
 
+/**
+ * @brief Arctangent of y / x, using the signs of both arguments to determine the quadrant.
+ * The quotient passed to ``atan`` is always the smaller magnitude divided by the larger one,
+ * so it stays in [0, 1] where the fitting polynomial of ``atan`` is accurate.
+ * 
+ * @tparam T @see fixed_num
+ * @tparam I @see fixed_num
+ * @tparam f @see fixed_num
+ * @tparam r @see fixed_num
+ * @tparam pi the pi value, default is pi_v<fixed_num<T, I, f, r>>().
+ * @param y the y coordinate.
+ * @param x the x coordinate.
+ * @return the angle in [-pi, pi], and 0 when both arguments are zero.
+ */
+template <typename T, typename I, unsigned int f, bool r, fixed_num<T, I, f, r> pi = numbers::pi_v<fixed_num<T, I, f, r>>()>
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> atan2(fixed_num<T, I, f, r> y, fixed_num<T, I, f, r> x) noexcept
+{
+    using fixed = fixed_num<T, I, f, r>;
+    constexpr auto const_0 = fixed(0);
+    constexpr auto half_pi = pi / 2;
+    auto abs_x = abs(x);
+    auto abs_y = abs(y);
+    if(abs_x == const_0 && abs_y == const_0)
+        return const_0;
+
+    fixed result = abs_y <= abs_x ? atan(abs_y / abs_x) : half_pi - atan(abs_x / abs_y);
+    if(x < const_0)
+        result = pi - result;
+    return y < const_0 ? -result : result;
+}
+
 //TODO: Implement asin and acos functions with CORDIC, and optimize other functions with CORDIC.
 
+namespace detail
+{
+    // the unsigned counterpart of the intermediate type, std::make_unsigned_t does not cover int128_t in strict mode.
+    template <typename I>
+    struct wide_unsigned
+    {
+        using type = std::make_unsigned_t<I>;
+    };
+
+#ifdef EIRIN_MATH_HAS_INT128
+    template <>
+    struct wide_unsigned<int128_t>
+    {
+        using type = uint128_t;
+    };
+#endif
+
+    /**
+     * @brief Integer cube root, floor(cbrt(n)), and n - floor(cbrt(n))^3 is left in n.
+     * The root is built one bit per step from the top, so no step divides or overflows.
+     */
+    template <typename U>
+    constexpr U icbrt(U& n) noexcept
+    {
+        U result = U(0);
+        int shift = (static_cast<int>(sizeof(U) * 8) - 1) / 3 * 3;
+        while(shift > 0 && (n >> shift) == U(0))
+            shift -= 3;
+        for(; shift >= 0; shift -= 3)
+        {
+            result <<= 1;
+            const U step = U(3) * result * (result + 1) + 1;
+            if((n >> shift) >= step)
+            {
+                n -= step << shift;
+                ++result;
+            }
+        }
+        return result;
+    }
+} // namespace detail
+
 /**
- * @brief cbrt function for fixed point number, which used newton method to calculate the cbrt.
+ * @brief cbrt function for fixed point number, by the integer cube root of |fp| * 2^(2f) in the unsigned
+ *        intermediate type, rounded to nearest, so the result is within half an ulp and never divides.
+ * @note If |fp| * 2^(2f) does not fit in the intermediate type (f above W / 2), fewer bits of the product are
+ *       used and the result is shifted back, which loses the low bits of the root.
  * 
  * @tparam T @see fixed_num
  * @tparam I @see fixed_num
  * @tparam f @see fixed_num
  * @tparam r @see fixed_num
- * @tparam iter_max max iteration times, default is 200.
  * @param fp 
  * @return cbrt(fp)
  */
-template <typename T, typename I, unsigned int f, bool r, int iter_max = 200>
+template <typename T, typename I, unsigned int f, bool r>
 EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> cbrt(fixed_num<T, I, f, r> fp) noexcept
 {
     using fixed = fixed_num<T, I, f, r>;
-    if(abs(fp) < fixed::epsilon())
-        return fixed(0);
-    auto x = (fixed(fp) + 2) / 3;
-    auto iter_count = 0;
-    constexpr auto precision = fixed::nearly_compare_epsilon() * 2;
+    using U = typename detail::wide_unsigned<I>::type;
+    // the largest shift up to 2f that fits, and the rest must be a multiple of 3 to be shifted back after the root.
+    constexpr unsigned int room = std::min<unsigned int>(2 * f, sizeof(I) * 8 - sizeof(T) * 8);
+    constexpr unsigned int shift = room - (3 - (2 * f - room) % 3) % 3;
 
-    while(abs(fp - (x * x * x)) >= precision && iter_count <= iter_max)
-    {
-        x = (fp / (x * x) + x * 2) / 3;
-        ++iter_count;
-    }
-    return x;
+    const T value = fp.internal_value();
+    // |min| is the magnitude of the unsigned negation.
+    const U magnitude = value < 0 ? U(0) - static_cast<U>(value) : static_cast<U>(value);
+    U n = magnitude << shift;
+    U root = detail::icbrt(n);
+    // round up when n - root^3 reaches (root + 1/2)^3 - root^3.
+    if(U(8) * n >= U(12) * root * root + U(6) * root + U(1))
+        ++root;
+    root <<= (2 * f - shift) / 3;
+    const T res = static_cast<T>(root);
+    return fixed::from_internal_value(value < 0 ? static_cast<T>(-res) : res);
 }
 
 /**
@@ -447,6 +659,132 @@ EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> log2(fixed_num<T, I, f, r> f
     return fixed::from_internal_value(y);
 }
 
+namespace detail
+{
+    /**
+     * @brief The table of ``fast_log2``, which splits [1, 2) into 2^k sub-intervals with the centers c_j = 1 + (2j + 1) / 2^(k + 1).
+     * log2(c_j) is computed with the squaring method of ``log2``, and 1 / c_j with an integer division, both with P fraction bits.
+     * 
+     * @tparam T @see fixed_num
+     * @tparam I @see fixed_num
+     * @tparam P the fraction bits of the table, the squares of [1, 2) with P fraction bits must fit in I.
+     * @tparam k log2 of the table size.
+     */
+    template <typename T, typename I, unsigned int P, unsigned int k>
+    struct log2_table
+    {
+        static constexpr size_t size = size_t(1) << k;
+
+        struct entry
+        {
+            T log2_c;
+            T inv_c;
+        };
+
+        static constexpr std::array<entry, size> generate() noexcept
+        {
+            std::array<entry, size> arr{};
+            constexpr I one = I(1) << P;
+            for(size_t j = 0; j < size; ++j)
+            {
+                const I c = one + ((static_cast<I>(2 * j + 1)) << (P - k - 1));
+                I z = c, y = I(0);
+                for(unsigned int i = 1; i <= P; ++i)
+                {
+                    z = (z * z) >> P;
+                    if(z >= 2 * one)
+                    {
+                        z >>= 1;
+                        y += one >> i;
+                    }
+                }
+                arr[j] = {static_cast<T>(y), static_cast<T>((one << P) / c)};
+            }
+            return arr;
+        }
+
+        static constexpr std::array<entry, size> values = generate();
+    };
+
+    /**
+     * @brief The coefficients of log2(1 + u) = (u - u^2 / 2 + u^3 / 3 - ...) / ln2 with P fraction bits, from u^1.
+     */
+    template <typename T, typename I, unsigned int P, size_t degree>
+    constexpr std::array<T, degree> log2_series() noexcept
+    {
+        constexpr auto log2_e = static_cast<I>(numbers::log2e_v<fixed_num<T, I, P, false>>().internal_value());
+        std::array<T, degree> arr{};
+        for(size_t n = 1; n <= degree; ++n)
+        {
+            const I c = log2_e / static_cast<I>(n);
+            arr[n - 1] = static_cast<T>(n % 2 == 1 ? c : -c);
+        }
+        return arr;
+    }
+
+    // the fraction bits of ``log2_kernel``, m in [1, 2) needs one integer bit besides the sign.
+    template <typename T>
+    inline constexpr unsigned int log2_kernel_bits = sizeof(T) * 8 - 2;
+
+    /**
+     * @brief log2 of a positive raw value with f fraction bits, the result has W - 2 fraction bits.
+     * @see fast_log2
+     */
+    template <typename T, typename I, unsigned int f>
+    EIRIN_ALWAYS_INLINE constexpr I log2_kernel(T x) noexcept
+    {
+        using U = std::make_unsigned_t<T>;
+        constexpr int width = sizeof(T) * 8;
+        constexpr unsigned int P = log2_kernel_bits<T>;
+        constexpr unsigned int k = f <= 16 ? 6 : 7;
+        constexpr size_t degree = f <= 16 ? 3 : 4;
+        using table = log2_table<T, I, P, k>;
+        constexpr auto coeffs = log2_series<T, I, P, degree>();
+
+        // a positive value has its highest bit at P at most.
+        const int msb = width - 1 - std::countl_zero(static_cast<U>(x));
+        const T m = x << (static_cast<int>(P) - msb);
+        const auto& entry = table::values[static_cast<size_t>(m >> (P - k)) & (table::size - 1)];
+        const I u = ((static_cast<I>(m) * entry.inv_c) >> P) - (I(1) << P);
+
+        const I poly = (static_cast<I>(poly_eval_raw<poly_scheme::estrin, T, I, P>(coeffs, static_cast<T>(u))) * u) >> P;
+
+        return (static_cast<I>(msb - static_cast<int>(f)) << P) + entry.log2_c + poly;
+    }
+} // namespace detail
+
+/**
+ * @brief Table driven log2 function for fixed point number.
+ * The argument is normalized to m * 2^e with m in [1, 2) by one count of leading zeros, then
+ * log2(m) = log2(c_j) + log2(1 + u) with u = m / c_j - 1 and the nearest table center c_j.
+ * The table has 64 entries and the series is cut after u^3 for 16 fraction bits or less, and
+ * 128 entries with u^4 otherwise, so the truncation error is far below the precision.
+ * @note The measured max error is 0.5003 ulp for fixed32 (exhaustive) and 0.5008 ulp for fixed64 (sampled
+ *       over the positive range), which is the final rounding only, while ``log2`` is up to 3.3 ulps off.
+ * 
+ * @tparam T @see fixed_num
+ * @tparam I @see fixed_num
+ * @tparam f @see fixed_num
+ * @tparam r @see fixed_num
+ * @param fp must be positive.
+ * @return log2(fp)
+ */
+template <typename T, typename I, unsigned int f, bool r>
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> fast_log2(fixed_num<T, I, f, r> fp)
+{
+    using fixed = fixed_num<T, I, f, r>;
+    constexpr unsigned int P = detail::log2_kernel_bits<T>;
+    if(fp <= fixed(0))
+        EIRIN_THROW_EXCEPTION(std::domain_error, "fast_log2() domain error");
+
+    const I result = detail::log2_kernel<T, I, f>(fp.internal_value());
+    // the kernel keeps W - 2 fraction bits, a type with more of them only gets the bits shifted in.
+    if constexpr(f < P)
+        return fixed::from_internal_value(static_cast<T>((result + (I(1) << (P - f - 1))) >> (P - f)));
+    else
+        return fixed::from_internal_value(static_cast<T>(result << (f - P)));
+}
+
 /**
  * @brief ln function for fixed point number, which used the log2 function to calculate the ln.
  * 
@@ -461,7 +799,7 @@ EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> log2(fixed_num<T, I, f, r> f
 template <typename T, typename I, unsigned int f, bool r, fixed_num<T, I, f, r> log2_e = fixed_num<T, I, f, r>::template from_fixed_num_value<60>(0x171547652B82FE00ll)>
 EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> log(fixed_num<T, I, f, r> fp)
 {
-    return log2(fp) / log2_e;
+    return div_by<log2_e>(log2(fp));
 }
 
 /**
@@ -478,7 +816,7 @@ EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> log(fixed_num<T, I, f, r> fp
 template <typename T, typename I, unsigned int f, bool r, fixed_num<T, I, f, r> log2_10 = fixed_num<T, I, f, r>::template from_fixed_num_value<60>(0x35269E12F346E200ll)>
 EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> log10(fixed_num<T, I, f, r> fp)
 {
-    return log2(fp) / log2_10;
+    return div_by<log2_10>(log2(fp));
 }
 
 template <typename T, typename I, unsigned int f, bool r, std::integral E>
@@ -514,54 +852,238 @@ EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> pow(fixed_num<T, I, f, r> b,
 
 namespace detail
 {
-    template <typename T, typename I, unsigned int f, bool r>
-    EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> exp_expand(fixed_num<T, I, f, r> fp) noexcept
+    /**
+     * @brief Integer square root, floor(sqrt(n)) for n >= 0.
+     */
+    template <typename I>
+    constexpr I isqrt(I n) noexcept
+    {
+        I result = I(0);
+        I bit = I(1) << (sizeof(I) * 8 - 2);
+        while(bit > n)
+            bit >>= 2;
+        while(bit != I(0))
+        {
+            if(n >= result + bit)
+            {
+                n -= result + bit;
+                result = (result >> 1) + bit;
+            }
+            else
+            {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        return result;
+    }
+
+    /**
+     * @brief ln2 with P fraction bits from the series of 1 / (k * 2^k) with 8 guard bits,
+     *        since the constants in ``numbers`` only carry the precision of a double.
+     */
+    template <typename I, unsigned int P>
+    constexpr I ln2_bits() noexcept
+    {
+        constexpr unsigned int guard = 8;
+        I sum = I(0);
+        for(unsigned int k = 1; k < P + guard; ++k)
+            sum += (I(1) << (P + guard - k)) / static_cast<I>(k);
+        return (sum + (I(1) << (guard - 1))) >> guard;
+    }
+
+    /**
+     * @brief log2(e) = 1 / ln2 with 2P fraction bits by a binary long division, split into the high part
+     *        with P fraction bits and the next P bits, so that x * log2(e) keeps its precision for any x.
+     */
+    template <typename I, unsigned int P>
+    constexpr std::pair<I, I> log2e_bits() noexcept
+    {
+        constexpr unsigned int L = sizeof(I) * 8 - 10;
+        constexpr I ln2 = ln2_bits<I, L>();
+        I rem = I(1) << L, high = I(0), low = I(0);
+        for(unsigned int i = 0; i <= 2 * P; ++i)
+        {
+            const bool bit = rem >= ln2;
+            if(bit)
+                rem -= ln2;
+            if(i <= P)
+                high = (high << 1) | I(bit);
+            else
+                low = (low << 1) | I(bit);
+            rem <<= 1;
+        }
+        return {high, low};
+    }
+
+    /**
+     * @brief The table of ``exp2``, 2^(j / 2^k) for j in [0, 2^k) with P fraction bits.
+     * The roots 2^(1 / 2^i) are computed with repeated integer square roots, and each entry is
+     * the product of the roots selected by the bits of j.
+     * 
+     * @tparam T @see fixed_num
+     * @tparam I @see fixed_num
+     * @tparam P the fraction bits of the table, 2^(2P + 1) must fit in I.
+     * @tparam k log2 of the table size.
+     */
+    template <typename T, typename I, unsigned int P, unsigned int k>
+    struct exp2_table
+    {
+        static constexpr size_t size = size_t(1) << k;
+
+        static constexpr std::array<T, size> generate() noexcept
+        {
+            std::array<I, k + 1> roots{};
+            roots[0] = I(2) << P;
+            for(unsigned int i = 1; i <= k; ++i)
+                roots[i] = isqrt<I>(roots[i - 1] << P);
+
+            std::array<T, size> arr{};
+            for(size_t j = 0; j < size; ++j)
+            {
+                I value = I(1) << P;
+                for(unsigned int bit = 0; bit < k; ++bit)
+                {
+                    if(j & (size_t(1) << bit))
+                        value = (value * roots[k - bit] + (I(1) << (P - 1))) >> P;
+                }
+                arr[j] = static_cast<T>(value);
+            }
+            return arr;
+        }
+
+        static constexpr std::array<T, size> values = generate();
+    };
+
+    // the fraction bits of ``exp2_kernel``, 2^x for x in [0, 1) needs one integer bit besides the sign.
+    template <typename T>
+    inline constexpr unsigned int exp2_kernel_bits = sizeof(T) * 8 - 2;
+
+    /**
+     * @brief 2^y for y with Q fraction bits, the result saturates to the max value on overflow.
+     * The integer part of y is a shift, and 2^frac = 2^(j / 2^k) * e^(t) with the table entry of
+     * the top k bits of the fraction, t = ln2 * (frac - j / 2^k) in [0, ln2 / 2^k) and a short
+     * Taylor series of e^t.
+     */
+    template <typename T, typename I, unsigned int f, bool r, unsigned int Q>
+    EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> exp2_kernel(I y) noexcept
     {
         using fixed = fixed_num<T, I, f, r>;
-        // the integer part of the input fixed point number.
-        const T x_int = fp.integral_part();
-        fp -= x_int;
-
-        constexpr auto a = fixed::template from_fixed_num_value<63>(0x01C798ECC0CBC856ll); // 1.3903728105644451e-2
-        constexpr auto b = fixed::template from_fixed_num_value<63>(0x04745859810836DAll); // 3.4800571158543038e-2
-        constexpr auto c = fixed::template from_fixed_num_value<63>(0x15CFBB5C306F85F3ll); // 1.7040197373796334e-1
-        constexpr auto d = fixed::template from_fixed_num_value<63>(0x3FE26186C531F98Ell); // 4.9909609871464493e-1
-        constexpr auto e = fixed::template from_fixed_num_value<63>(0x40014D4407008BB0ll); // 1.0000794567422495
-        constexpr auto _f = fixed::template from_fixed_num_value<63>(0x7FFFF686446F1B43ll); // 9.9999887043019773e-1
-        return pow(numbers::e_v<fixed>(), x_int) * (_f + fp * (e + fp * (d + fp * (c + fp * (b + fp * a)))));
+        constexpr int width = sizeof(T) * 8;
+        constexpr unsigned int P = exp2_kernel_bits<T>;
+        constexpr unsigned int k = (f <= 16 ? 6 : 8) < Q ? (f <= 16 ? 6 : 8) : Q;
+        constexpr size_t degree = f <= 16 ? 4 : 6;
+        using table = exp2_table<T, I, P, k>;
+        constexpr I ln2 = ln2_bits<I, P>();
+        constexpr auto coeffs = []
+        {
+            // 1 / n! with P fraction bits.
+            std::array<T, degree + 1> arr{};
+            arr[0] = T(1) << P;
+            for(size_t n = 1; n <= degree; ++n)
+                arr[n] = static_cast<T>(arr[n - 1] / static_cast<T>(n));
+            return arr;
+        }();
+
+        const I n = y >> Q;
+        // 2^frac is in [1, 2), so the result overflows from 2^(W - 1 - f).
+        if(n >= I(width - 1 - static_cast<int>(f)))
+            return std::numeric_limits<fixed>::max();
+        const int shift = static_cast<int>(P) - static_cast<int>(f) - static_cast<int>(n);
+        // below half of the smallest step even for the largest mantissa.
+        if(n < I(-static_cast<int>(f) - 2))
+            return fixed(0);
+
+        const I frac = y & ((I(1) << Q) - 1);
+        const size_t j = static_cast<size_t>(frac >> (Q - k));
+        const I rest = frac & ((I(1) << (Q - k)) - 1);
+        I t = 0;
+        if constexpr(Q >= P)
+            t = ((rest >> (Q - P)) * ln2) >> P;
+        else
+            t = ((rest << (P - Q)) * ln2) >> P;
+
+        const T poly = poly_eval_raw<poly_scheme::estrin, T, I, P>(coeffs, static_cast<T>(t));
+        const I mantissa = (static_cast<I>(table::values[j]) * poly) >> P;
+
+        I value = mantissa;
+        if(shift > 0)
+            value = (mantissa + (I(1) << (shift - 1))) >> shift;
+        else if(shift < 0)
+            value = mantissa << -shift;
+        if(value > static_cast<I>(std::numeric_limits<T>::max()))
+            return std::numeric_limits<fixed>::max();
+        return fixed::from_internal_value(static_cast<T>(value));
     }
 } // namespace detail
 
+/**
+ * @brief Base 2 exponential function for fixed point number. The integer part of the argument is a shift,
+ *        and the fraction part is a compile-time table of 2^(j / 2^k) times a short polynomial.
+ * @note The result saturates to the max value on overflow, and becomes zero on underflow.
+ * 
+ * @tparam T @see fixed_num
+ * @tparam I @see fixed_num
+ * @tparam f @see fixed_num
+ * @tparam r @see fixed_num
+ * @param fp the exponent.
+ * @return 2^fp
+ */
 template <typename T, typename I, unsigned int f, bool r>
-EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> exp(fixed_num<T, I, f, r> fp) noexcept
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> exp2(fixed_num<T, I, f, r> fp) noexcept
 {
-    using fixed = fixed_num<T, I, f, r>;
+    return detail::exp2_kernel<T, I, f, r, f>(static_cast<I>(fp.internal_value()));
+}
 
-    if(fp == fixed(0))
-        return fixed(1);
-    if(fp < fixed(0))
-        return fixed(1) / detail::exp_expand(-fp);
-    return detail::exp_expand(fp);
+/**
+ * @brief Exponential function for fixed point number, e^x = 2^(x * log2(e)).
+ * log2(e) carries 2 * (W - 2) fraction bits, so the error of the exponent does not grow with the result.
+ * @note The result saturates to the max value on overflow, and becomes zero on underflow.
+ */
+template <typename T, typename I, unsigned int f, bool r>
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> exp(fixed_num<T, I, f, r> fp) noexcept
+{
+    constexpr unsigned int P = detail::exp2_kernel_bits<T>;
+    constexpr auto log2_e = detail::log2e_bits<I, P>();
+    const auto x = static_cast<I>(fp.internal_value());
+    return detail::exp2_kernel<T, I, f, r, f + P>(x * log2_e.first + ((x * log2_e.second) >> P));
 }
 
-// TODO: This function has performance issue on MSVC,
-// which is about 5x slower than the result of clang-cl.
+/**
+ * @brief Power function for fixed point number, b^e = 2^(e * log2(b)).
+ * The logarithm is computed by ``fast_log2`` with W - 2 fraction bits, and 8 bits of them are dropped
+ * before the multiplication so the product fits in the intermediate type.
+ * @note The result saturates to the max value on overflow. A negative base is only allowed with an integral
+ *       exponent, which is computed by the integral ``pow``.
+ * 
+ * @tparam T @see fixed_num
+ * @tparam I @see fixed_num
+ * @tparam f @see fixed_num
+ * @tparam r @see fixed_num
+ * @param b the base.
+ * @param e the exponent.
+ * @return b^e
+ */
 template <typename T, typename I, unsigned int f, bool r>
-EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> pow(fixed_num<T, I, f, r> b, fixed_num<T, I, f, r> e) noexcept
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> pow(fixed_num<T, I, f, r> b, fixed_num<T, I, f, r> e)
 {
     using fixed = fixed_num<T, I, f, r>;
+    constexpr unsigned int P = detail::log2_kernel_bits<T> - 8;
     if(b == fixed(0))
     {
         if(e == fixed(0))
             return fixed(1);
         return fixed(0);
     }
+    if(b < fixed(0))
+    {
+        if(e.fractional_part() != 0)
+            EIRIN_THROW_EXCEPTION(std::domain_error, "pow() domain error");
+        return pow(b, static_cast<T>(e.internal_value() >> f));
+    }
 
-    // the integer part of the input exponent.
-    const T e_int = static_cast<T>(e.internal_value() / (I(1) << f));
-    e -= e_int;
-
-    return pow(b, e_int) * exp(e * log(b));
+    const I log2_b = detail::log2_kernel<T, I, f>(b.internal_value()) >> 8;
+    return detail::exp2_kernel<T, I, f, r, f + P>(static_cast<I>(e.internal_value()) * log2_b);
 }
 
 template <typename T, typename I, unsigned int f, bool r>
@@ -593,7 +1115,7 @@ EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> degrees(fixed_num<T, I, f, r
 {
     using fixed = fixed_num<T, I, f, r>;
     constexpr fixed factor = fixed(180);
-    fixed deg = rad / pi * factor;
+    fixed deg = div_by<pi>(rad) * factor;
     return deg;
 }
 
@@ -613,10 +1135,115 @@ EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> radians(fixed_num<T, I, f, r
 {
     using fixed = fixed_num<T, I, f, r>;
     constexpr fixed factor = fixed(180);
-    fixed rad = deg / factor * pi;
+    fixed rad = div_by<factor>(deg) * pi;
     return rad;
 }
 
+namespace detail
+{
+    /**
+     * @brief The initial guesses of ``rsqrt``, which splits [1 / 4, 1) into sub-intervals of width 2^-k,
+     *        and stores 1 / sqrt(c) of each center c with P fraction bits.
+     * The roots are computed with integer square roots at 16 fraction bits, far below the needed precision.
+     * 
+     * @tparam T @see fixed_num
+     * @tparam I @see fixed_num
+     * @tparam P the fraction bits of the table, at least 16.
+     * @tparam k log2 of the sub-intervals in [0, 1).
+     */
+    template <typename T, typename I, unsigned int P, unsigned int k>
+    struct rsqrt_table
+    {
+        static constexpr size_t offset = size_t(1) << (k - 2);
+        static constexpr size_t size = 3 * offset;
+
+        static constexpr std::array<T, size> generate() noexcept
+        {
+            std::array<T, size> arr{};
+            for(size_t j = 0; j < size; ++j)
+            {
+                // the center is (2 * (j + offset) + 1) / 2^(k + 1).
+                const I root = isqrt<I>((I(1) << (k + 1 + 32)) / static_cast<I>(2 * (j + offset) + 1));
+                arr[j] = static_cast<T>(root << (P - 16));
+            }
+            return arr;
+        }
+
+        static constexpr std::array<T, size> values = generate();
+    };
+} // namespace detail
+
+namespace detail
+{
+    /**
+     * @brief 1 / sqrt(x) of a positive raw value x with f fraction bits, as y / 2^shift with W - 3 fraction bits of y.
+     * The argument is normalized to m * 4^e with m in [1 / 4, 1) by one count of leading zeros, the initial guess
+     * of 1 / sqrt(m) comes from ``rsqrt_table``, and y = y * (3 - m * y^2) / 2 doubles its correct bits per step.
+     * @see rsqrt
+     */
+    template <typename T, typename I, unsigned int f>
+    EIRIN_ALWAYS_INLINE constexpr std::pair<T, int> rsqrt_kernel(T x) noexcept
+    {
+        using U = std::make_unsigned_t<T>;
+        constexpr int width = sizeof(T) * 8;
+        // m < 1 and y <= 2 need two integer bits besides the sign.
+        constexpr int P = width - 3;
+        constexpr unsigned int k = 8;
+        using table = rsqrt_table<T, I, P, k>;
+        // the table is good to 7 bits, and ``rsqrt`` needs 3f / 2 + 1 bits for the largest value 2^(f / 2).
+        constexpr int steps = []
+        {
+            int steps = 0;
+            for(int bits = k - 1; bits < static_cast<int>(3 * f / 2 + 1) && bits < P; bits = 2 * bits - 1)
+                ++steps;
+            return steps;
+        }();
+
+        // x < 2^s, and m = x / 4^e in [1 / 4, 1) with e = ceil(s / 2).
+        const int s = width - std::countl_zero(static_cast<U>(x)) - static_cast<int>(f);
+        const int e = (s + 1) >> 1;
+        const int shift = P - static_cast<int>(f) - 2 * e;
+        const T m = shift >= 0 ? static_cast<T>(x << shift) : static_cast<T>(x >> -shift);
+
+        T y = table::values[static_cast<size_t>(m >> (P - k)) - table::offset];
+        for(int i = 0; i < steps; ++i)
+        {
+            const T my = static_cast<T>((static_cast<I>(m) * y) >> P);
+            const T my2 = static_cast<T>((static_cast<I>(my) * y) >> P);
+            y = static_cast<T>((static_cast<I>(y) * ((T(3) << P) - my2)) >> (P + 1));
+        }
+        // 1 / sqrt(x) = y / 2^(P + e).
+        return {y, P + e};
+    }
+} // namespace detail
+
+/**
+ * @brief Reciprocal square root 1 / sqrt(x) without a division.
+ * The initial guess comes from a 192 entries table, and each Newton step is three multiplications
+ * with W - 3 fraction bits, 2 steps for fixed32 and 3 steps for fixed64.
+ * @see detail::rsqrt_kernel
+ * 
+ * @tparam T @see fixed_num
+ * @tparam I @see fixed_num
+ * @tparam f @see fixed_num
+ * @tparam r @see fixed_num
+ * @param fp the argument, which must be positive.
+ * @return 1 / sqrt(fp) rounded to the nearest.
+ */
+template <typename T, typename I, unsigned int f, bool r>
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> rsqrt(fixed_num<T, I, f, r> fp)
+{
+    using fixed = fixed_num<T, I, f, r>;
+    if(fp <= fixed(0))
+        EIRIN_THROW_EXCEPTION(std::domain_error, "rsqrt() domain error");
+
+    const auto [y, shift] = detail::rsqrt_kernel<T, I, f>(fp.internal_value());
+    const int out = shift - static_cast<int>(f);
+    if(out <= 0)
+        return fixed::from_internal_value(static_cast<T>(y << -out));
+    return fixed::from_internal_value(static_cast<T>((static_cast<I>(y) + (I(1) << (out - 1))) >> out));
+}
+
 template <typename T, typename I, unsigned int f, bool r>
 EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> hypot(fixed_num<T, I, f, r> x, fixed_num<T, I, f, r> y) noexcept
 {
@@ -0,0 +1,418 @@
+#ifndef EIRIN_MATH_MATRIX_HPP
+#define EIRIN_MATH_MATRIX_HPP
+
+#pragma once
+
+#include "error.hpp"
+#include "fixed.hpp"
+#include "vec.hpp"
+#include "detail/memory.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+#    include <immintrin.h>
+#endif
+
+namespace eirin
+{
+/**
+ * @brief Matrix of fixed point numbers with a size known at compile time, stored in row-major order.
+ * All operations are constexpr and unrolled over the elements.
+ *
+ * @tparam Fixed the fixed point type of the elements.
+ * @tparam R the number of rows.
+ * @tparam C the number of columns.
+ */
+template <typename Fixed, size_t R, size_t C>
+struct matrix
+{
+    static_assert(R > 0 && C > 0, "matrix requires at least one row and one column");
+
+    static constexpr size_t rows = R;
+    static constexpr size_t cols = C;
+    using value_type = Fixed;
+
+    std::array<Fixed, R * C> elements;
+
+    constexpr Fixed& operator()(size_t row, size_t col) noexcept
+    {
+        return elements[row * C + col];
+    }
+
+    constexpr const Fixed& operator()(size_t row, size_t col) const noexcept
+    {
+        return elements[row * C + col];
+    }
+
+    static constexpr matrix identity() noexcept
+    requires(R == C)
+    {
+        matrix res{};
+        for(size_t i = 0; i < R; ++i)
+            res(i, i) = Fixed(1);
+        return res;
+    }
+
+    constexpr bool operator==(const matrix&) const noexcept = default;
+};
+
+namespace detail
+{
+    template <typename Fixed, size_t R, size_t C, typename Op, size_t... n>
+    EIRIN_ALWAYS_INLINE constexpr matrix<Fixed, R, C> matrix_generate(Op op, std::index_sequence<n...>) noexcept
+    {
+        return {{op(n / C, n % C)...}};
+    }
+
+    template <typename Fixed, size_t R, size_t C, typename Op>
+    EIRIN_ALWAYS_INLINE constexpr matrix<Fixed, R, C> matrix_generate(Op op) noexcept
+    {
+        return matrix_generate<Fixed, R, C>(op, std::make_index_sequence<R * C>());
+    }
+
+    // the sum of a(i, k) * b(k, j) over k in the intermediate type.
+    template <typename T, typename I, unsigned int f, bool r, size_t R, size_t K, size_t C, size_t... k>
+    EIRIN_ALWAYS_INLINE constexpr I matrix_dot(const matrix<fixed_num<T, I, f, r>, R, K>& a, const matrix<fixed_num<T, I, f, r>, K, C>& b,
+                                               size_t i, size_t j, std::index_sequence<k...>) noexcept
+    {
+        return (wide_product(a(i, k), b(k, j)) + ...);
+    }
+} // namespace detail
+
+template <typename Fixed, size_t R, size_t C>
+EIRIN_ALWAYS_INLINE constexpr matrix<Fixed, R, C> operator+(const matrix<Fixed, R, C>& a, const matrix<Fixed, R, C>& b) noexcept
+{
+    return detail::matrix_generate<Fixed, R, C>([&](size_t i, size_t j) { return a(i, j) + b(i, j); });
+}
+
+template <typename Fixed, size_t R, size_t C>
+EIRIN_ALWAYS_INLINE constexpr matrix<Fixed, R, C> operator-(const matrix<Fixed, R, C>& a, const matrix<Fixed, R, C>& b) noexcept
+{
+    return detail::matrix_generate<Fixed, R, C>([&](size_t i, size_t j) { return a(i, j) - b(i, j); });
+}
+
+template <typename Fixed, size_t R, size_t C>
+EIRIN_ALWAYS_INLINE constexpr matrix<Fixed, R, C> operator-(const matrix<Fixed, R, C>& a) noexcept
+{
+    return detail::matrix_generate<Fixed, R, C>([&](size_t i, size_t j) { return -a(i, j); });
+}
+
+template <typename Fixed, size_t R, size_t C>
+EIRIN_ALWAYS_INLINE constexpr matrix<Fixed, R, C> operator*(const matrix<Fixed, R, C>& a, Fixed s) noexcept
+{
+    return detail::matrix_generate<Fixed, R, C>([&](size_t i, size_t j) { return a(i, j) * s; });
+}
+
+template <typename Fixed, size_t R, size_t C>
+EIRIN_ALWAYS_INLINE constexpr matrix<Fixed, R, C> operator*(Fixed s, const matrix<Fixed, R, C>& a) noexcept
+{
+    return a * s;
+}
+
+/**
+ * @brief Matrix product, every element is a dot product summed in the intermediate type and shifted once.
+ */
+template <typename T, typename I, unsigned int f, bool r, size_t R, size_t K, size_t C>
+EIRIN_ALWAYS_INLINE constexpr matrix<fixed_num<T, I, f, r>, R, C> operator*(const matrix<fixed_num<T, I, f, r>, R, K>& a,
+                                                                              const matrix<fixed_num<T, I, f, r>, K, C>& b) noexcept
+{
+    return detail::matrix_generate<fixed_num<T, I, f, r>, R, C>([&](size_t i, size_t j) {
+        return detail::narrow_product<T, I, f, r>(detail::matrix_dot(a, b, i, j, std::make_index_sequence<K>()));
+    });
+}
+
+/**
+ * @brief Transforms a vector by a square matrix of the same size, the vector is a column vector.
+ */
+template <typename T, typename I, unsigned int f, bool r, size_t N, template <typename> typename V>
+requires(fixed_vec<V<fixed_num<T, I, f, r>>> && V<fixed_num<T, I, f, r>>::size == N)
+EIRIN_ALWAYS_INLINE constexpr V<fixed_num<T, I, f, r>> operator*(const matrix<fixed_num<T, I, f, r>, N, N>& m,
+                                                                  const V<fixed_num<T, I, f, r>>& v) noexcept
+{
+    V<fixed_num<T, I, f, r>> res{};
+    for(size_t i = 0; i < N; ++i)
+    {
+        I sum = detail::wide_product(m(i, 0), v[0]);
+        for(size_t k = 1; k < N; ++k)
+            sum += detail::wide_product(m(i, k), v[k]);
+        res[i] = detail::narrow_product<T, I, f, r>(sum);
+    }
+    return res;
+}
+
+template <typename Fixed, size_t R, size_t C>
+EIRIN_ALWAYS_INLINE constexpr matrix<Fixed, R, C>& operator+=(matrix<Fixed, R, C>& a, const matrix<Fixed, R, C>& b) noexcept
+{
+    return a = a + b;
+}
+
+template <typename Fixed, size_t R, size_t C>
+EIRIN_ALWAYS_INLINE constexpr matrix<Fixed, R, C>& operator-=(matrix<Fixed, R, C>& a, const matrix<Fixed, R, C>& b) noexcept
+{
+    return a = a - b;
+}
+
+template <typename Fixed, size_t R, size_t C>
+EIRIN_ALWAYS_INLINE constexpr matrix<Fixed, R, C>& operator*=(matrix<Fixed, R, C>& a, Fixed s) noexcept
+{
+    return a = a * s;
+}
+
+template <typename Fixed, size_t R, size_t C>
+EIRIN_ALWAYS_INLINE constexpr matrix<Fixed, C, R> transpose(const matrix<Fixed, R, C>& a) noexcept
+{
+    return detail::matrix_generate<Fixed, C, R>([&](size_t i, size_t j) { return a(j, i); });
+}
+
+/**
+ * @brief Matrix of fixed point numbers with a size chosen at run time, stored in row-major order
+ *        in a 64 bytes aligned buffer.
+ *
+ * @tparam Fixed the fixed point type of the elements.
+ */
+template <typename Fixed>
+class dense_matrix
+{
+public:
+    static constexpr size_t alignment = 64;
+    using value_type = Fixed;
+
+    dense_matrix() noexcept = default;
+
+    /**
+     * @brief Creates a zero matrix.
+     */
+    dense_matrix(size_t rows, size_t cols) : m_rows(rows), m_cols(cols), m_data(rows * cols)
+    {
+    }
+
+    [[nodiscard]]
+    size_t rows() const noexcept
+    {
+        return m_rows;
+    }
+
+    [[nodiscard]]
+    size_t cols() const noexcept
+    {
+        return m_cols;
+    }
+
+    Fixed& operator()(size_t row, size_t col) noexcept
+    {
+        return m_data[row * m_cols + col];
+    }
+
+    const Fixed& operator()(size_t row, size_t col) const noexcept
+    {
+        return m_data[row * m_cols + col];
+    }
+
+    std::span<Fixed> row(size_t r) noexcept
+    {
+        return {m_data.data() + r * m_cols, m_cols};
+    }
+
+    std::span<const Fixed> row(size_t r) const noexcept
+    {
+        return {m_data.data() + r * m_cols, m_cols};
+    }
+
+    Fixed* data() noexcept
+    {
+        return m_data.data();
+    }
+
+    const Fixed* data() const noexcept
+    {
+        return m_data.data();
+    }
+
+    bool operator==(const dense_matrix&) const noexcept = default;
+
+private:
+    size_t m_rows = 0;
+    size_t m_cols = 0;
+    std::vector<Fixed, detail::aligned_allocator<Fixed, alignment>> m_data;
+};
+
+namespace detail
+{
+    // the packed columns of one block of the right operand stay in L2 while the rows of the left operand stream by.
+    inline constexpr size_t gemm_block_bytes = 256 * 1024;
+    // the multiply-adds every thread takes at least, below it the start of a thread costs more than its share of the product.
+    inline constexpr size_t gemm_parallel_min_work = size_t(1) << 18;
+
+    // calls op(std::integral_constant<size_t, i>) for i in [0, N).
+    template <size_t N, typename Op>
+    EIRIN_ALWAYS_INLINE void gemm_unroll(Op op) noexcept
+    {
+        [&]<size_t... i>(std::index_sequence<i...>) { (op(std::integral_constant<size_t, i>()), ...); }(std::make_index_sequence<N>());
+    }
+
+    /**
+     * @brief acc[m][n] += sum of a[m][k] * bt[n][k] over k, the rows of a and bt are depth elements apart.
+     */
+    template <size_t MR, size_t NR, typename T, typename I>
+    EIRIN_ALWAYS_INLINE void gemm_accumulate(const T* a, const T* bt, size_t depth, I (&acc)[MR][NR]) noexcept
+    {
+        size_t k = 0;
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+        if constexpr(std::is_same_v<T, int32_t> && std::is_same_v<I, int64_t>)
+        {
+            // _mm256_mul_epi32 multiplies the even lanes into four 64 bit products, so the odd lanes are shifted down first.
+            // The lanes sum the same products as the scalar loop, so the result is bit-identical.
+            __m256i lanes[MR][NR];
+            for(size_t m = 0; m < MR; ++m)
+                for(size_t n = 0; n < NR; ++n)
+                    lanes[m][n] = _mm256_setzero_si256();
+            for(; k + 8 <= depth; k += 8)
+            {
+                __m256i va[MR], vb[NR];
+                for(size_t m = 0; m < MR; ++m)
+                    va[m] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + m * depth + k));
+                for(size_t n = 0; n < NR; ++n)
+                    vb[n] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bt + n * depth + k));
+                for(size_t m = 0; m < MR; ++m)
+                    for(size_t n = 0; n < NR; ++n)
+                    {
+                        const __m256i even = _mm256_mul_epi32(va[m], vb[n]);
+                        const __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(va[m], 32), _mm256_srli_epi64(vb[n], 32));
+                        lanes[m][n] = _mm256_add_epi64(lanes[m][n], _mm256_add_epi64(even, odd));
+                    }
+            }
+            for(size_t m = 0; m < MR; ++m)
+                for(size_t n = 0; n < NR; ++n)
+                {
+                    alignas(32) int64_t sum[4];
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(sum), lanes[m][n]);
+                    acc[m][n] += sum[0] + sum[1] + sum[2] + sum[3];
+                }
+        }
+#endif
+        // local accumulators with constant indices, so they stay in registers.
+        I sum[MR][NR]{};
+        for(; k < depth; ++k)
+            gemm_unroll<MR * NR>([&](auto i) {
+                constexpr size_t m = decltype(i)::value / NR, n = decltype(i)::value % NR;
+                sum[m][n] += static_cast<I>(a[m * depth + k]) * bt[n * depth + k];
+            });
+        for(size_t m = 0; m < MR; ++m)
+            for(size_t n = 0; n < NR; ++n)
+                acc[m][n] += sum[m][n];
+    }
+
+    // computes the MR x NR tile of c from MR rows of a and NR packed columns bt.
+    template <size_t MR, size_t NR, typename T, typename I, unsigned int f, bool r>
+    EIRIN_ALWAYS_INLINE void gemm_tile(const T* a, const T* bt, fixed_num<T, I, f, r>* c, size_t ldc, size_t depth) noexcept
+    {
+        I acc[MR][NR]{};
+        gemm_accumulate<MR, NR>(a, bt, depth, acc);
+        for(size_t m = 0; m < MR; ++m)
+            for(size_t n = 0; n < NR; ++n)
+                c[m * ldc + n] = narrow_product<T, I, f, r>(acc[m][n]);
+    }
+
+    template <size_t MR, typename T, typename I, unsigned int f, bool r>
+    EIRIN_ALWAYS_INLINE void gemm_row_block(const T* a, const T* bt, fixed_num<T, I, f, r>* c, size_t ldc, size_t depth, size_t cols) noexcept
+    {
+        size_t j = 0;
+        for(; j + 2 <= cols; j += 2)
+            gemm_tile<MR, 2>(a, bt + j * depth, c + j, ldc, depth);
+        if(j < cols)
+            gemm_tile<MR, 1>(a, bt + j * depth, c + j, ldc, depth);
+    }
+
+    /**
+     * @brief Computes the rows [begin, end) of c = a * b, where bt holds the columns of b as rows.
+     */
+    template <typename T, typename I, unsigned int f, bool r>
+    void gemm_rows(const T* a, const T* bt, fixed_num<T, I, f, r>* c, size_t begin, size_t end, size_t depth, size_t cols) noexcept
+    {
+        const size_t block = std::max<size_t>(2, (gemm_block_bytes / (sizeof(T) * std::max<size_t>(depth, 1))) & ~size_t(1));
+        for(size_t jb = 0; jb < cols; jb += block)
+        {
+            const size_t width = std::min(block, cols - jb);
+            size_t i = begin;
+            for(; i + 2 <= end; i += 2)
+                gemm_row_block<2>(a + i * depth, bt + jb * depth, c + i * cols + jb, cols, depth, width);
+            if(i < end)
+                gemm_row_block<1>(a + i * depth, bt + jb * depth, c + i * cols + jb, cols, depth, width);
+        }
+    }
+} // namespace detail
+
+/**
+ * @brief Matrix product with cache blocking and an optional number of threads.
+ * Every element is a dot product summed exactly in the intermediate type and shifted once,
+ * so the result does not depend on the number of threads. Each thread takes at least
+ * ``detail::gemm_parallel_min_work`` multiply-adds, so small products run in the calling thread.
+ * @note The result differs from the naive sum of ``fixed_num`` products, which truncates every product.
+ *
+ * @tparam T @see fixed_num
+ * @tparam I @see fixed_num
+ * @tparam f @see fixed_num
+ * @tparam r @see fixed_num
+ * @param a the left matrix.
+ * @param b the right matrix, with as many rows as a has columns.
+ * @param threads the number of threads, 0 uses std::thread::hardware_concurrency().
+ * @return the rows() x b.cols() product.
+ */
+template <typename T, typename I, unsigned int f, bool r>
+dense_matrix<fixed_num<T, I, f, r>> multiply(const dense_matrix<fixed_num<T, I, f, r>>& a, const dense_matrix<fixed_num<T, I, f, r>>& b,
+                                             unsigned int threads = 0)
+{
+    if(a.cols() != b.rows())
+        EIRIN_THROW_EXCEPTION(std::invalid_argument, "multiply() requires a.cols() == b.rows()");
+    const size_t rows = a.rows(), depth = a.cols(), cols = b.cols();
+    dense_matrix<fixed_num<T, I, f, r>> res(rows, cols);
+    if(rows == 0 || cols == 0)
+        return res;
+
+    // both operands as raw values with the reduction dimension contiguous.
+    std::vector<T, detail::aligned_allocator<T, dense_matrix<fixed_num<T, I, f, r>>::alignment>> packed(depth * (rows + cols));
+    T* pa = packed.data();
+    T* bt = pa + rows * depth;
+    for(size_t i = 0; i < rows; ++i)
+        for(size_t k = 0; k < depth; ++k)
+            pa[i * depth + k] = a(i, k).internal_value();
+    for(size_t k = 0; k < depth; ++k)
+        for(size_t j = 0; j < cols; ++j)
+            bt[j * depth + k] = b(k, j).internal_value();
+
+    if(threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    // every thread takes an even number of rows, so the tiles are the same for any number of threads.
+    // small products run in the calling thread.
+    const size_t pairs = (rows + 1) / 2;
+    const size_t work = rows * std::max<size_t>(depth, 1) * cols;
+    const size_t workers = std::max<size_t>(1, std::min({static_cast<size_t>(threads), pairs, work / detail::gemm_parallel_min_work}));
+    const size_t per_worker = (pairs + workers - 1) / workers * 2;
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for(size_t w = 1; w < workers; ++w)
+    {
+        const size_t begin = std::min(rows, w * per_worker), end = std::min(rows, begin + per_worker);
+        pool.emplace_back([=, &res] { detail::gemm_rows(pa, bt, res.data(), begin, end, depth, cols); });
+    }
+    detail::gemm_rows(pa, bt, res.data(), 0, std::min(rows, per_worker), depth, cols);
+    for(auto& t : pool)
+        t.join();
+    return res;
+}
+
+template <typename Fixed>
+dense_matrix<Fixed> operator*(const dense_matrix<Fixed>& a, const dense_matrix<Fixed>& b)
+{
+    return multiply(a, b);
+}
+} // namespace eirin
+
+#endif
@@ -0,0 +1,547 @@
+#ifndef EIRIN_POLICY_HPP
+#define EIRIN_POLICY_HPP
+
+#pragma once
+
+#include "fixed.hpp"
+#include "math.hpp"
+#include "numbers.hpp"
+#include "ext/cordic.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+namespace eirin
+{
+namespace detail
+{
+    /**
+     * @brief fp in quarter turns, reduced to [0, 4) with f fraction bits, the integral part is the quadrant.
+     */
+    template <typename T, typename I, unsigned int f, bool r>
+    EIRIN_ALWAYS_INLINE constexpr T quarter_turns(fixed_num<T, I, f, r> fp) noexcept
+    {
+        using fixed = fixed_num<T, I, f, r>;
+        auto x = fp;
+        x %= fixed::double_pi();
+        x = div_by<fixed::pi_2()>(x);
+        if(x < fixed(0))
+            x += fixed(4);
+        return x.internal_value() & ((T(4) << f) - 1);
+    }
+
+    /**
+     * @brief {sin(pi / 2 * q), cos(pi / 2 * q)} for q in quarter turns, with ``kernel(t)`` = sin(pi / 2 * t) for t in [0, 1].
+     */
+    template <typename T, typename I, unsigned int f, bool r, typename Kernel>
+    EIRIN_ALWAYS_INLINE constexpr std::pair<fixed_num<T, I, f, r>, fixed_num<T, I, f, r>> sincos_quarter_turns(T q, Kernel kernel) noexcept
+    {
+        using fixed = fixed_num<T, I, f, r>;
+        const auto quadrant = static_cast<int>(q >> f) & 3;
+        const T t = q & ((T(1) << f) - 1);
+        const auto s = kernel(fixed::from_internal_value(t));
+        const auto c = kernel(fixed::from_internal_value((T(1) << f) - t));
+        auto sin_res = (quadrant & 1) ? c : s;
+        auto cos_res = (quadrant & 1) ? s : c;
+        if(quadrant & 2)
+            sin_res = -sin_res;
+        if(quadrant == 1 || quadrant == 2)
+            cos_res = -cos_res;
+        return {sin_res, cos_res};
+    }
+
+    /**
+     * @brief sin(pi / 2 * i / N) for i in [0, N] with W - 2 fraction bits, and the last entry repeated,
+     *        so the interpolation at t = 1 needs no branch.
+     */
+    template <typename T, typename I, unsigned int f, bool r, size_t N>
+    struct sin_lut
+    {
+        static constexpr unsigned int P = sizeof(T) * 8 - 2;
+
+        static constexpr std::array<T, N + 2> values = []
+        {
+            using wide = fixed_num<T, I, P, r>;
+            std::array<T, N + 2> res{};
+            for(size_t i = 0; i <= N; ++i)
+                res[i] = sin_quarter<T, I, P, r, f + 2>(wide::from_internal_value(static_cast<T>((T(1) << P) / T(N) * T(i)))).internal_value();
+            res[N + 1] = res[N];
+            return res;
+        }();
+
+        // sin(pi / 2 * t) for t in [0, 1], linear interpolation between the entries.
+        static constexpr fixed_num<T, I, f, r> interpolate(fixed_num<T, I, f, r> t) noexcept
+        {
+            constexpr unsigned int shift = f - std::countr_zero(N);
+            const T raw = t.internal_value();
+            const auto i = static_cast<size_t>(raw >> shift);
+            const I frac = raw & ((T(1) << shift) - 1);
+            const I value = static_cast<I>(values[i]) + ((static_cast<I>(values[i + 1] - values[i]) * frac) >> shift);
+            return fixed_num<T, I, f, r>::from_internal_value(static_cast<T>((value + (I(1) << (P - f - 1))) >> (P - f)));
+        }
+    };
+
+    // ln(2), log10(2) and log2(e) with 61 fraction bits.
+    inline constexpr int64_t ln2_61 = 0x162E42FEFA39EF35;
+    inline constexpr int64_t log10_2_61 = 0x09A209A84FBCFF7A;
+    inline constexpr int64_t log2e_61 = 0x2E2A8ECA5705FC2F;
+    inline constexpr int64_t log10e_61 = 0x0DE5BD8A93728719;
+
+    /**
+     * @brief A constant with 61 fraction bits, rounded to P fraction bits.
+     */
+    template <int64_t c61, typename I, unsigned int P>
+    EIRIN_ALWAYS_INLINE constexpr I round_const() noexcept
+    {
+        if constexpr(P < minimax_fraction)
+            return (static_cast<I>(c61) + (I(1) << (minimax_fraction - P - 1))) >> (minimax_fraction - P);
+        else
+            return static_cast<I>(c61) << (P - minimax_fraction);
+    }
+
+    /**
+     * @brief log2(x) * c of a positive raw value, where c has 61 fraction bits, rounded once from the kernel of ``fast_log2``.
+     */
+    template <int64_t c61, typename T, typename I, unsigned int f>
+    EIRIN_ALWAYS_INLINE constexpr T log2_scaled(T x) noexcept
+    {
+        constexpr unsigned int P = log2_kernel_bits<T>;
+        // f + 8 bits of the kernel are kept, so the product with c stays in I.
+        constexpr unsigned int G = std::min(f + 8, P);
+        constexpr I c = round_const<c61, I, P>();
+        const I prod = (log2_kernel<T, I, f>(x) >> (P - G)) * c;
+        return static_cast<T>((prod + (I(1) << (G + P - f - 1))) >> (G + P - f));
+    }
+
+    /**
+     * @brief x * c rounded once, where c has 61 fraction bits and is below 4 in magnitude.
+     */
+    template <int64_t c61, typename T, typename I, unsigned int f, bool r>
+    EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> mul_const(fixed_num<T, I, f, r> x) noexcept
+    {
+        constexpr unsigned int P = std::min<unsigned int>(sizeof(T) * 8 - 3, minimax_fraction);
+        constexpr I c = round_const<c61, I, P>();
+        return fixed_num<T, I, f, r>::from_internal_value(static_cast<T>((static_cast<I>(x.internal_value()) * c + (I(1) << (P - 1))) >> P));
+    }
+
+    /**
+     * @brief e^x / 2 from the kernel of ``exp``, the halving is exact in the exponent of the kernel,
+     *        so it saturates only when e^x / 2 does, like sinh and cosh.
+     */
+    template <typename T, typename I, unsigned int f, bool r>
+    EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> half_exp(fixed_num<T, I, f, r> x) noexcept
+    {
+        constexpr unsigned int P = exp2_kernel_bits<T>;
+        constexpr auto log2_e = log2e_bits<I, P>();
+        const auto v = static_cast<I>(x.internal_value());
+        return exp2_kernel<T, I, f, r, f + P>(v * log2_e.first + ((v * log2_e.second) >> P) - (I(1) << (f + P)));
+    }
+} // namespace detail
+
+/**
+ * @brief Math implementation policies, which select the implementation of every transcendental function at compile time.
+ * A policy is a type with static member functions, so a module can switch all of its call sites at once:
+ *
+ *     using math = eirin::policy::fast;
+ *     auto y = math::sin(x) * math::exp(x);
+ *
+ * or pass it as the first template argument of the free functions, ``eirin::sin<eirin::policy::lut<1024>>(x)``.
+ */
+namespace policy
+{
+    /**
+     * @brief The default implementations of ``math.hpp``, except the logarithms, which use the table kernel of ``fast_log2``
+     *        with a single rounding, as it is both faster and more precise than ``log2``. sinh, cosh and tanh, which ``math.hpp``
+     *        does not have, are built on the kernel of ``exp``.
+     */
+    struct precise
+    {
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> sin(fixed_num<T, I, f, r> x) noexcept
+        {
+            return eirin::sin(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> cos(fixed_num<T, I, f, r> x) noexcept
+        {
+            return eirin::cos(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr std::pair<fixed_num<T, I, f, r>, fixed_num<T, I, f, r>> sincos(fixed_num<T, I, f, r> x) noexcept
+        {
+            return eirin::sincos(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> tan(fixed_num<T, I, f, r> x)
+        {
+            return eirin::tan(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> atan(fixed_num<T, I, f, r> x) noexcept
+        {
+            return eirin::atan(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> atan2(fixed_num<T, I, f, r> y, fixed_num<T, I, f, r> x) noexcept
+        {
+            return eirin::atan2(y, x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> sqrt(fixed_num<T, I, f, r> x) noexcept
+        {
+            return eirin::sqrt(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> exp(fixed_num<T, I, f, r> x) noexcept
+        {
+            return eirin::exp(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> log2(fixed_num<T, I, f, r> x)
+        {
+            return eirin::fast_log2(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> log(fixed_num<T, I, f, r> x)
+        {
+            if(x <= fixed_num<T, I, f, r>(0))
+                EIRIN_THROW_EXCEPTION(std::domain_error, "log() domain error");
+            return fixed_num<T, I, f, r>::from_internal_value(detail::log2_scaled<detail::ln2_61, T, I, f>(x.internal_value()));
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> log10(fixed_num<T, I, f, r> x)
+        {
+            if(x <= fixed_num<T, I, f, r>(0))
+                EIRIN_THROW_EXCEPTION(std::domain_error, "log10() domain error");
+            return fixed_num<T, I, f, r>::from_internal_value(detail::log2_scaled<detail::log10_2_61, T, I, f>(x.internal_value()));
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> pow(fixed_num<T, I, f, r> b, fixed_num<T, I, f, r> e)
+        {
+            return eirin::pow(b, e);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> asin(fixed_num<T, I, f, r> x)
+        {
+            return eirin::asin(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> acos(fixed_num<T, I, f, r> x)
+        {
+            return eirin::acos(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> exp2(fixed_num<T, I, f, r> x) noexcept
+        {
+            return eirin::exp2(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> cbrt(fixed_num<T, I, f, r> x) noexcept
+        {
+            return eirin::cbrt(x);
+        }
+
+        // sinh and cosh are sums of e^|x| / 2 and e^-|x| / 2 from the kernel of ``exp``.
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> sinh(fixed_num<T, I, f, r> x) noexcept
+        {
+            using fixed = fixed_num<T, I, f, r>;
+            // abs of the min value would stay negative.
+            const auto a = x == min_value<fixed>() ? max_value<fixed>() : abs(x);
+            const auto res = detail::half_exp(a) - detail::half_exp(-a);
+            return x < fixed(0) ? -res : res;
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> cosh(fixed_num<T, I, f, r> x) noexcept
+        {
+            using fixed = fixed_num<T, I, f, r>;
+            const auto a = x == min_value<fixed>() ? max_value<fixed>() : abs(x);
+            const I sum = static_cast<I>(detail::half_exp(a).internal_value()) + detail::half_exp(-a).internal_value();
+            if(sum > static_cast<I>(std::numeric_limits<T>::max()))
+                return max_value<fixed>();
+            return fixed::from_internal_value(static_cast<T>(sum));
+        }
+
+        // tanh(x) = (1 - t) / (1 + t) with t = e^-2|x| from the kernel of ``exp`` with W - 2 fraction bits, rounded once.
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> tanh(fixed_num<T, I, f, r> x) noexcept
+        {
+            using fixed = fixed_num<T, I, f, r>;
+            constexpr unsigned int P = detail::exp2_kernel_bits<T>;
+            constexpr auto log2_e = detail::log2e_bits<I, P>();
+            const auto v = static_cast<I>(x.internal_value());
+            const I a = v < 0 ? -v : v;
+            const I t = detail::exp2_kernel<T, I, P, r, f + P>(-2 * (a * log2_e.first + ((a * log2_e.second) >> P))).internal_value();
+            constexpr I one = I(1) << P;
+            const I q = ((one - t) << (f + 1)) / (one + t);
+            const auto res = fixed::from_internal_value(static_cast<T>((q + 1) >> 1));
+            return x < fixed(0) ? -res : res;
+        }
+    };
+
+    /**
+     * @brief Lower degree polynomials for sin, cos, tan, atan and atan2, with an error below 2^-(f / 2 + 4)
+     *        instead of 2^-(f + 1), i.e. about 16 ULPs for fixed32. The other functions are the ones of ``precise``.
+     */
+    struct fast : precise
+    {
+        template <unsigned int f>
+        static constexpr unsigned int bits = f / 2 + 4;
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr std::pair<fixed_num<T, I, f, r>, fixed_num<T, I, f, r>> sincos(fixed_num<T, I, f, r> x) noexcept
+        {
+            return detail::sincos_quarter_turns<T, I, f, r>(detail::quarter_turns(x),
+                                                             [](fixed_num<T, I, f, r> t) { return detail::sin_quarter<T, I, f, r, bits<f>>(t); });
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> sin(fixed_num<T, I, f, r> x) noexcept
+        {
+            return sincos(x).first;
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> cos(fixed_num<T, I, f, r> x) noexcept
+        {
+            return sincos(x).second;
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> tan(fixed_num<T, I, f, r> x)
+        {
+            const auto [s, c] = sincos(x);
+            if(abs(c).internal_value() <= 1)
+                EIRIN_THROW_EXCEPTION(std::domain_error, "tan() domain error");
+            return s / c;
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> atan(fixed_num<T, I, f, r> x) noexcept
+        {
+            using fixed = fixed_num<T, I, f, r>;
+            const auto abs_x = abs(x);
+            const auto res = abs_x > fixed(1) ? fixed::pi_2() - detail::atan_unit<T, I, f, r, bits<f>>(fixed(1) / abs_x)
+                                               : detail::atan_unit<T, I, f, r, bits<f>>(abs_x);
+            return x < fixed(0) ? -res : res;
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> atan2(fixed_num<T, I, f, r> y, fixed_num<T, I, f, r> x) noexcept
+        {
+            using fixed = fixed_num<T, I, f, r>;
+            const auto abs_x = abs(x), abs_y = abs(y);
+            if(abs_x == fixed(0) && abs_y == fixed(0))
+                return fixed(0);
+            auto res = abs_y <= abs_x ? detail::atan_unit<T, I, f, r, bits<f>>(abs_y / abs_x)
+                                      : fixed::pi_2() - detail::atan_unit<T, I, f, r, bits<f>>(abs_x / abs_y);
+            if(x < fixed(0))
+                res = fixed::pi() - res;
+            return y < fixed(0) ? -res : res;
+        }
+    };
+
+    /**
+     * @brief sin, cos and tan by linear interpolation in a table of N + 1 values of the first quarter wave,
+     *        the error is about (pi / 2 / N)^2 / 8, i.e. 2^-22 for N = 1024. The other functions are the ones of ``precise``.
+     *
+     * @tparam N the size of the table, a power of two.
+     */
+    template <size_t N = 1024>
+    struct lut : precise
+    {
+        static_assert(std::has_single_bit(N), "the size of the table must be a power of two");
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr std::pair<fixed_num<T, I, f, r>, fixed_num<T, I, f, r>> sincos(fixed_num<T, I, f, r> x) noexcept
+        {
+            static_assert((size_t(1) << f) >= N, "the table is larger than the fraction");
+            return detail::sincos_quarter_turns<T, I, f, r>(detail::quarter_turns(x), detail::sin_lut<T, I, f, r, N>::interpolate);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> sin(fixed_num<T, I, f, r> x) noexcept
+        {
+            return sincos(x).first;
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> cos(fixed_num<T, I, f, r> x) noexcept
+        {
+            return sincos(x).second;
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> tan(fixed_num<T, I, f, r> x)
+        {
+            const auto [s, c] = sincos(x);
+            if(abs(c).internal_value() <= 1)
+                EIRIN_THROW_EXCEPTION(std::domain_error, "tan() domain error");
+            return s / c;
+        }
+    };
+
+    /**
+     * @brief The CORDIC kernels of ``ext/cordic.hpp``, with shifts and adds only. The circular ones are defined for fixed32
+     *        and fixed64 only, and pow, asin, acos, exp2 and cbrt, which have no CORDIC kernel, are the ones of ``precise``.
+     */
+    struct cordic : precise
+    {
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr std::pair<fixed_num<T, I, f, r>, fixed_num<T, I, f, r>> sincos(fixed_num<T, I, f, r> x) noexcept
+        {
+            return cordic_sincos(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> sin(fixed_num<T, I, f, r> x) noexcept
+        {
+            return cordic_sine(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> cos(fixed_num<T, I, f, r> x) noexcept
+        {
+            return cordic_sincos(x).second;
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> tan(fixed_num<T, I, f, r> x)
+        {
+            const auto [s, c] = cordic_sincos(x);
+            if(abs(c).internal_value() <= 1)
+                EIRIN_THROW_EXCEPTION(std::domain_error, "tan() domain error");
+            return s / c;
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> atan(fixed_num<T, I, f, r> x) noexcept
+        {
+            return cordic_atan2(x, fixed_num<T, I, f, r>(1));
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> atan2(fixed_num<T, I, f, r> y, fixed_num<T, I, f, r> x) noexcept
+        {
+            return cordic_atan2(y, x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> sqrt(fixed_num<T, I, f, r> x) noexcept
+        {
+            return cordic_sqrt(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> exp(fixed_num<T, I, f, r> x) noexcept
+        {
+            return cordic_exp(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> log(fixed_num<T, I, f, r> x)
+        {
+            return cordic_log(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> log2(fixed_num<T, I, f, r> x)
+        {
+            return detail::mul_const<detail::log2e_61>(cordic_log(x));
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> log10(fixed_num<T, I, f, r> x)
+        {
+            return detail::mul_const<detail::log10e_61>(cordic_log(x));
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> sinh(fixed_num<T, I, f, r> x) noexcept
+        {
+            return cordic_sinh(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> cosh(fixed_num<T, I, f, r> x) noexcept
+        {
+            return cordic_cosh(x);
+        }
+
+        template <typename T, typename I, unsigned int f, bool r>
+        static constexpr fixed_num<T, I, f, r> tanh(fixed_num<T, I, f, r> x) noexcept
+        {
+            return cordic_tanh(x);
+        }
+    };
+} // namespace policy
+
+/**
+ * @brief A math implementation policy of ``eirin::policy``, or a type with the same static member functions.
+ */
+template <typename P>
+concept math_policy = requires(fixed32 x) {
+    { P::sin(x) } -> std::same_as<fixed32>;
+    { P::exp(x) } -> std::same_as<fixed32>;
+};
+
+// the free functions with the policy as the first template argument, e.g. sin<policy::fast>(x).
+#define EIRIN_POLICY_UNARY(name)                                                            \
+    template <math_policy P, typename T, typename I, unsigned int f, bool r>                \
+    EIRIN_ALWAYS_INLINE constexpr auto name(fixed_num<T, I, f, r> x)                        \
+    {                                                                                       \
+        return P::name(x);                                                                  \
+    }
+
+#define EIRIN_POLICY_BINARY(name)                                                           \
+    template <math_policy P, typename T, typename I, unsigned int f, bool r>                \
+    EIRIN_ALWAYS_INLINE constexpr auto name(fixed_num<T, I, f, r> x, fixed_num<T, I, f, r> y) \
+    {                                                                                       \
+        return P::name(x, y);                                                               \
+    }
+
+EIRIN_POLICY_UNARY(sin)
+EIRIN_POLICY_UNARY(cos)
+EIRIN_POLICY_UNARY(sincos)
+EIRIN_POLICY_UNARY(tan)
+EIRIN_POLICY_UNARY(atan)
+EIRIN_POLICY_BINARY(atan2)
+EIRIN_POLICY_UNARY(sqrt)
+EIRIN_POLICY_UNARY(exp)
+EIRIN_POLICY_UNARY(log)
+EIRIN_POLICY_UNARY(log2)
+EIRIN_POLICY_UNARY(log10)
+EIRIN_POLICY_BINARY(pow)
+EIRIN_POLICY_UNARY(asin)
+EIRIN_POLICY_UNARY(acos)
+EIRIN_POLICY_UNARY(exp2)
+EIRIN_POLICY_UNARY(cbrt)
+EIRIN_POLICY_UNARY(sinh)
+EIRIN_POLICY_UNARY(cosh)
+EIRIN_POLICY_UNARY(tanh)
+
+#undef EIRIN_POLICY_UNARY
+#undef EIRIN_POLICY_BINARY
+} // namespace eirin
+
+#endif
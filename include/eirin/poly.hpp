@@ -0,0 +1,99 @@
+#ifndef EIRIN_MATH_POLY_HPP
+#define EIRIN_MATH_POLY_HPP
+
+#pragma once
+
+#include "fixed.hpp"
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace eirin
+{
+/**
+ * @brief The evaluation order of a polynomial.
+ * ``horner`` is c0 + x * (c1 + x * (c2 + ...)), one multiplication and one addition per term in a single dependency chain.
+ * ``estrin`` evaluates the pairs c[2i] + c[2i+1] * x independently, then repeats on the pairs with x^2, x^4, etc.
+ * It does a few more multiplications, but the dependency chain is only about log2(N) multiplications long.
+ */
+enum class poly_scheme
+{
+    horner,
+    estrin
+};
+
+namespace detail
+{
+    // one level of Estrin's scheme, c[2i] + c[2i + 1] * x for every pair, the odd last coefficient is kept.
+    template <typename V, size_t N, typename Mul, size_t... i>
+    EIRIN_ALWAYS_INLINE constexpr std::array<V, (N + 1) / 2> poly_estrin_pairs(
+        const std::array<V, N>& c, V x, Mul mul, std::index_sequence<i...>) noexcept
+    {
+        return {(2 * i + 1 < N ? static_cast<V>(c[2 * i] + mul(c[2 * i + 1 < N ? 2 * i + 1 : 0], x)) : c[2 * i])...};
+    }
+
+    /**
+     * @brief c[0] + c[1] * x + ... + c[N - 1] * x^(N - 1) with the multiplication mul(a, b).
+     */
+    template <poly_scheme scheme, typename V, size_t N, typename Mul>
+    EIRIN_ALWAYS_INLINE constexpr V poly_evaluate(const std::array<V, N>& c, V x, Mul mul) noexcept
+    {
+        static_assert(N > 0, "poly_eval() requires at least one coefficient");
+        if constexpr(N == 1)
+            return c[0];
+        else if constexpr(scheme == poly_scheme::horner)
+        {
+            V res = c[N - 1];
+            for(size_t i = N - 1; i > 0; --i)
+                res = static_cast<V>(c[i - 1] + mul(res, x));
+            return res;
+        }
+        else
+            return poly_evaluate<scheme>(poly_estrin_pairs(c, x, mul, std::make_index_sequence<(N + 1) / 2>()), mul(x, x), mul);
+    }
+
+    /**
+     * @brief ``poly_evaluate`` on raw values with P fraction bits, the values are kept in T and every
+     *        product is widened to I, so the partial sums need to fit in T.
+     */
+    template <poly_scheme scheme, typename T, typename I, unsigned int P, size_t N>
+    EIRIN_ALWAYS_INLINE constexpr T poly_eval_raw(const std::array<T, N>& c, T x) noexcept
+    {
+        return poly_evaluate<scheme>(c, x, [](T a, T b) { return static_cast<T>((static_cast<I>(a) * b) >> P); });
+    }
+} // namespace detail
+
+/**
+ * @brief Evaluates the polynomial Coeffs[0] + Coeffs[1] * x + Coeffs[2] * x^2 + ... with compile-time coefficients.
+ * @note The products are the ``operator*`` of fixed_num, and the two schemes may differ in the last bits.
+ *
+ * @tparam scheme @see poly_scheme
+ * @tparam Coeffs the coefficients from the constant term up, all of the type of x.
+ * @tparam T @see fixed_num
+ * @tparam I @see fixed_num
+ * @tparam f @see fixed_num
+ * @tparam r @see fixed_num
+ * @param x the variable.
+ * @return the value of the polynomial at x.
+ */
+template <poly_scheme scheme, auto... Coeffs, typename T, typename I, unsigned int f, bool r>
+requires(std::is_same_v<std::remove_cvref_t<decltype(Coeffs)>, fixed_num<T, I, f, r>> && ...)
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> poly_eval(fixed_num<T, I, f, r> x) noexcept
+{
+    using fixed = fixed_num<T, I, f, r>;
+    return detail::poly_evaluate<scheme>(std::array<fixed, sizeof...(Coeffs)>{Coeffs...}, x, [](fixed a, fixed b) { return a * b; });
+}
+
+/**
+ * @brief ``poly_eval`` with Estrin's scheme.
+ */
+template <auto... Coeffs, typename T, typename I, unsigned int f, bool r>
+requires(std::is_same_v<std::remove_cvref_t<decltype(Coeffs)>, fixed_num<T, I, f, r>> && ...)
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> poly_eval(fixed_num<T, I, f, r> x) noexcept
+{
+    return poly_eval<poly_scheme::estrin, Coeffs...>(x);
+}
+} // namespace eirin
+
+#endif
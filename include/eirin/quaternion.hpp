@@ -0,0 +1,342 @@
+#ifndef EIRIN_MATH_QUATERNION_HPP
+#define EIRIN_MATH_QUATERNION_HPP
+
+#pragma once
+
+#include "fixed.hpp"
+#include "math.hpp"
+#include "vec.hpp"
+#include <array>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+#    include "ext/simd_math.hpp"
+#endif
+
+namespace eirin
+{
+/**
+ * @brief Quaternion of fixed point numbers w + xi + yj + zk, the components are stored as x, y, z, w
+ *        like ``vec4``, so a quaternion of fixed64 fits one AVX2 register.
+ *
+ * @tparam Fixed the fixed point type of the components.
+ */
+template <typename Fixed>
+struct quaternion
+{
+    static constexpr size_t size = 4;
+    using value_type = Fixed;
+
+    Fixed x, y, z, w;
+
+    constexpr Fixed& operator[](size_t i) noexcept
+    {
+        return i == 0 ? x : (i == 1 ? y : (i == 2 ? z : w));
+    }
+
+    constexpr const Fixed& operator[](size_t i) const noexcept
+    {
+        return i == 0 ? x : (i == 1 ? y : (i == 2 ? z : w));
+    }
+
+    static constexpr quaternion identity() noexcept
+    {
+        return {Fixed(0), Fixed(0), Fixed(0), Fixed(1)};
+    }
+
+    constexpr vec3<Fixed> vector_part() const noexcept
+    {
+        return {x, y, z};
+    }
+
+    constexpr bool operator==(const quaternion&) const noexcept = default;
+};
+
+template <typename Fixed>
+EIRIN_ALWAYS_INLINE constexpr quaternion<Fixed> operator+(const quaternion<Fixed>& a, const quaternion<Fixed>& b) noexcept
+{
+    return {a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w};
+}
+
+template <typename Fixed>
+EIRIN_ALWAYS_INLINE constexpr quaternion<Fixed> operator-(const quaternion<Fixed>& a, const quaternion<Fixed>& b) noexcept
+{
+    return {a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w};
+}
+
+template <typename Fixed>
+EIRIN_ALWAYS_INLINE constexpr quaternion<Fixed> operator-(const quaternion<Fixed>& a) noexcept
+{
+    return {-a.x, -a.y, -a.z, -a.w};
+}
+
+template <typename Fixed>
+EIRIN_ALWAYS_INLINE constexpr quaternion<Fixed> operator*(const quaternion<Fixed>& a, Fixed s) noexcept
+{
+    return {a.x * s, a.y * s, a.z * s, a.w * s};
+}
+
+template <typename Fixed>
+EIRIN_ALWAYS_INLINE constexpr quaternion<Fixed> operator*(Fixed s, const quaternion<Fixed>& a) noexcept
+{
+    return a * s;
+}
+
+/**
+ * @brief Hamilton product, the rotation b followed by a. Every component sums its four products
+ *        in the intermediate type and shifts once, instead of 16 products with 16 shifts.
+ */
+template <typename T, typename I, unsigned int f, bool r>
+EIRIN_ALWAYS_INLINE constexpr quaternion<fixed_num<T, I, f, r>> operator*(const quaternion<fixed_num<T, I, f, r>>& a,
+                                                                           const quaternion<fixed_num<T, I, f, r>>& b) noexcept
+{
+    using detail::narrow_product;
+    using detail::wide_product;
+    return {narrow_product<T, I, f, r>(wide_product(a.w, b.x) + wide_product(a.x, b.w) + wide_product(a.y, b.z) - wide_product(a.z, b.y)),
+            narrow_product<T, I, f, r>(wide_product(a.w, b.y) - wide_product(a.x, b.z) + wide_product(a.y, b.w) + wide_product(a.z, b.x)),
+            narrow_product<T, I, f, r>(wide_product(a.w, b.z) + wide_product(a.x, b.y) - wide_product(a.y, b.x) + wide_product(a.z, b.w)),
+            narrow_product<T, I, f, r>(wide_product(a.w, b.w) - wide_product(a.x, b.x) - wide_product(a.y, b.y) - wide_product(a.z, b.z))};
+}
+
+template <typename Fixed>
+EIRIN_ALWAYS_INLINE constexpr quaternion<Fixed>& operator*=(quaternion<Fixed>& a, const quaternion<Fixed>& b) noexcept
+{
+    return a = a * b;
+}
+
+template <typename Fixed>
+EIRIN_ALWAYS_INLINE constexpr quaternion<Fixed> conjugate(const quaternion<Fixed>& q) noexcept
+{
+    return {-q.x, -q.y, -q.z, q.w};
+}
+
+/**
+ * @brief The four dimensional dot product, summed in the intermediate type and shifted once.
+ */
+template <typename T, typename I, unsigned int f, bool r>
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> dot(const quaternion<fixed_num<T, I, f, r>>& a, const quaternion<fixed_num<T, I, f, r>>& b) noexcept
+{
+    using detail::wide_product;
+    return detail::narrow_product<T, I, f, r>(wide_product(a.x, b.x) + wide_product(a.y, b.y) + wide_product(a.z, b.z) + wide_product(a.w, b.w));
+}
+
+/**
+ * @brief The root of the squared length summed in the intermediate type, which saturates to the max value.
+ */
+template <typename T, typename I, unsigned int f, bool r>
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> length(const quaternion<fixed_num<T, I, f, r>>& q) noexcept
+{
+    return detail::wide_length<T, I, f, r>(detail::wide_norm(q));
+}
+
+/**
+ * @brief The unit quaternion of the same rotation. The components are multiplied by ``rsqrt`` of the squared length
+ *        summed in the intermediate type before the final rounding, so long quaternions neither wrap nor lose their precision.
+ * The zero quaternion is returned as is.
+ */
+template <typename T, typename I, unsigned int f, bool r>
+EIRIN_ALWAYS_INLINE constexpr quaternion<fixed_num<T, I, f, r>> normalize(const quaternion<fixed_num<T, I, f, r>>& q) noexcept
+{
+    const auto norm = detail::wide_norm(q);
+    if(norm == 0)
+        return q;
+    const auto [y, shift] = detail::wide_rsqrt_kernel<T, I, f>(norm);
+    using detail::scale_by_rsqrt;
+    return {scale_by_rsqrt(q.x, y, shift), scale_by_rsqrt(q.y, y, shift), scale_by_rsqrt(q.z, y, shift), scale_by_rsqrt(q.w, y, shift)};
+}
+
+/**
+ * @brief The rotation by angle radians around the unit vector axis.
+ */
+template <typename Fixed>
+EIRIN_ALWAYS_INLINE constexpr quaternion<Fixed> from_axis_angle(const vec3<Fixed>& axis, Fixed angle) noexcept
+{
+    const auto [s, c] = sincos(angle / 2);
+    return {axis.x * s, axis.y * s, axis.z * s, c};
+}
+
+/**
+ * @brief Spherical linear interpolation between unit quaternions along the shorter arc.
+ * With theta = acos(dot(a, b)), the weights are sin((1 - t) * theta) / sin(theta) and sin(t * theta) / sin(theta),
+ * and the first one is expanded to cos(t * theta) - cos(theta) * sin(t * theta) / sin(theta), so two ``sincos``
+ * and one division are needed besides ``acos``. Nearly equal quaternions fall back to the normalized lerp.
+ */
+template <typename T, typename I, unsigned int f, bool r>
+EIRIN_ALWAYS_INLINE constexpr quaternion<fixed_num<T, I, f, r>> slerp(const quaternion<fixed_num<T, I, f, r>>& a,
+                                                                       quaternion<fixed_num<T, I, f, r>> b, fixed_num<T, I, f, r> t)
+{
+    using fixed = fixed_num<T, I, f, r>;
+    auto cos_theta = dot(a, b);
+    if(cos_theta < fixed(0))
+    {
+        b = -b;
+        cos_theta = -cos_theta;
+    }
+    // 1 - 2^-11, below which sin(theta) is about 0.03 and the division loses most of its precision.
+    constexpr fixed nlerp_threshold = fixed(1) - fixed::from_internal_value(T(1) << (f - 11));
+    if(cos_theta > nlerp_threshold)
+        return normalize(a + (b - a) * t);
+
+    const auto theta = acos(cos_theta);
+    const auto sin_theta = sincos(theta).first;
+    const auto [sin_t, cos_t] = sincos(theta * t);
+    const auto wb = sin_t / sin_theta;
+    const auto wa = cos_t - cos_theta * wb;
+
+    using detail::wide_product;
+    const auto mix = [&](fixed ca, fixed cb) { return detail::narrow_product<T, I, f, r>(wide_product(ca, wa) + wide_product(cb, wb)); };
+    return {mix(a.x, b.x), mix(a.y, b.y), mix(a.z, b.z), mix(a.w, b.w)};
+}
+
+namespace detail
+{
+    // the fraction bits of the rotation matrix, the entries in [-1, 1] fit 32 bits signed lanes.
+    inline constexpr unsigned int rotation_bits = 30;
+
+    /**
+     * @brief The rotation matrix of a unit quaternion in row-major order with ``rotation_bits`` fraction bits.
+     * The entries are computed from the exact products in the intermediate type and rounded once.
+     */
+    template <typename T, typename I, unsigned int f, bool r>
+    EIRIN_ALWAYS_INLINE constexpr std::array<T, 9> rotation_rows(const quaternion<fixed_num<T, I, f, r>>& q) noexcept
+    {
+        const I xx = wide_product(q.x, q.x), yy = wide_product(q.y, q.y), zz = wide_product(q.z, q.z);
+        const I xy = wide_product(q.x, q.y), xz = wide_product(q.x, q.z), yz = wide_product(q.y, q.z);
+        const I wx = wide_product(q.w, q.x), wy = wide_product(q.w, q.y), wz = wide_product(q.w, q.z);
+        constexpr I one = I(1) << (2 * f);
+        // values with 2f fraction bits to rotation_bits, rounded to the nearest.
+        const auto round = [](I v)
+        {
+            if constexpr(2 * f > rotation_bits)
+            {
+                constexpr unsigned int shift = 2 * f - rotation_bits;
+                return static_cast<T>((v + (I(1) << (shift - 1))) >> shift);
+            }
+            else
+                return static_cast<T>(v << (rotation_bits - 2 * f));
+        };
+        return {round(one - 2 * (yy + zz)), round(2 * (xy - wz)), round(2 * (xz + wy)),
+                round(2 * (xy + wz)), round(one - 2 * (xx + zz)), round(2 * (yz - wx)),
+                round(2 * (xz - wy)), round(2 * (yz + wx)), round(one - 2 * (xx + yy))};
+    }
+
+    /**
+     * @brief rows * v, every component sums its three products in the intermediate type and shifts once.
+     */
+    template <typename T, typename I, unsigned int f, bool r>
+    EIRIN_ALWAYS_INLINE constexpr vec3<fixed_num<T, I, f, r>> rotate_rows(const std::array<T, 9>& rows, const vec3<fixed_num<T, I, f, r>>& v) noexcept
+    {
+        using fixed = fixed_num<T, I, f, r>;
+        const I vx = v.x.internal_value(), vy = v.y.internal_value(), vz = v.z.internal_value();
+        const auto row = [&](size_t i)
+        { return fixed::from_internal_value(static_cast<T>((rows[3 * i] * vx + rows[3 * i + 1] * vy + rows[3 * i + 2] * vz) >> rotation_bits)); };
+        return {row(0), row(1), row(2)};
+    }
+
+#if defined(EIRIN_PLATFORM_SIMD_AVX2) && defined(EIRIN_MATH_HAS_INT128)
+    /**
+     * @brief ``rotate_rows`` on 4 lanes of fixed64 components, bit-identical to the scalar path.
+     * The entries have 30 fraction bits, so every product splits into a signed 32 x 32 bits product of
+     * the high half of v and of its sign extended low half, and the three products of each half sum in 64 bits:
+     * v = (h + c) * 2^32 + l with the signed low half l and its borrow c, and (r * v) >> 30 = 4 * sum(r * (h + c)) + (sum(r * l) >> 30).
+     */
+    EIRIN_ALWAYS_INLINE void avx_mm256_rotate_epi64(const __m256i (&rows)[9], __m256i& x, __m256i& y, __m256i& z)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i hx = _mm256_srli_epi64(x, 32), hy = _mm256_srli_epi64(y, 32), hz = _mm256_srli_epi64(z, 32);
+        const __m256i cx = _mm256_cmpgt_epi64(zero, _mm256_slli_epi64(x, 32));
+        const __m256i cy = _mm256_cmpgt_epi64(zero, _mm256_slli_epi64(y, 32));
+        const __m256i cz = _mm256_cmpgt_epi64(zero, _mm256_slli_epi64(z, 32));
+        const auto row = [&](__m256i rx, __m256i ry, __m256i rz)
+        {
+            const __m256i hi = _mm256_add_epi64(
+                _mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epi32(rx, hx), _mm256_and_si256(rx, cx)),
+                                 _mm256_add_epi64(_mm256_mul_epi32(ry, hy), _mm256_and_si256(ry, cy))),
+                _mm256_add_epi64(_mm256_mul_epi32(rz, hz), _mm256_and_si256(rz, cz)));
+            const __m256i lo = _mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epi32(rx, x), _mm256_mul_epi32(ry, y)), _mm256_mul_epi32(rz, z));
+            return _mm256_add_epi64(_mm256_slli_epi64(hi, 32 - rotation_bits), simd::detail::avx_mm256_srai_epi64(lo, rotation_bits));
+        };
+        const __m256i ox = row(rows[0], rows[1], rows[2]);
+        const __m256i oy = row(rows[3], rows[4], rows[5]);
+        z = row(rows[6], rows[7], rows[8]);
+        x = ox;
+        y = oy;
+    }
+
+    /**
+     * @brief Splits 4 consecutive vec3 of fixed64 in 3 registers into the x, y and z lanes.
+     * Blending picks each component from distinct positions, so one permutation restores the order,
+     * and the permutations are their own inverses for ``avx_mm256_store_vec3x4``.
+     */
+    EIRIN_ALWAYS_INLINE void avx_mm256_load_vec3x4(const void* p, __m256i& x, __m256i& y, __m256i& z)
+    {
+        const __m256i r0 = _mm256_loadu_si256(static_cast<const __m256i*>(p));
+        const __m256i r1 = _mm256_loadu_si256(static_cast<const __m256i*>(p) + 1);
+        const __m256i r2 = _mm256_loadu_si256(static_cast<const __m256i*>(p) + 2);
+        // (x0, x3, x2, x1), (y1, y0, y3, y2) and (z2, z1, z0, z3).
+        x = _mm256_permute4x64_epi64(_mm256_blend_epi32(_mm256_blend_epi32(r0, r1, 0x30), r2, 0x0C), _MM_SHUFFLE(1, 2, 3, 0));
+        y = _mm256_permute4x64_epi64(_mm256_blend_epi32(_mm256_blend_epi32(r0, r1, 0xC3), r2, 0x30), _MM_SHUFFLE(2, 3, 0, 1));
+        z = _mm256_permute4x64_epi64(_mm256_blend_epi32(_mm256_blend_epi32(r0, r1, 0x0C), r2, 0xC3), _MM_SHUFFLE(3, 0, 1, 2));
+    }
+
+    EIRIN_ALWAYS_INLINE void avx_mm256_store_vec3x4(void* p, __m256i x, __m256i y, __m256i z)
+    {
+        x = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 2, 3, 0));
+        y = _mm256_permute4x64_epi64(y, _MM_SHUFFLE(2, 3, 0, 1));
+        z = _mm256_permute4x64_epi64(z, _MM_SHUFFLE(3, 0, 1, 2));
+        _mm256_storeu_si256(static_cast<__m256i*>(p), _mm256_blend_epi32(_mm256_blend_epi32(x, y, 0x0C), z, 0x30));
+        _mm256_storeu_si256(static_cast<__m256i*>(p) + 1, _mm256_blend_epi32(_mm256_blend_epi32(y, z, 0x0C), x, 0x30));
+        _mm256_storeu_si256(static_cast<__m256i*>(p) + 2, _mm256_blend_epi32(_mm256_blend_epi32(z, x, 0x0C), y, 0x30));
+    }
+
+    template <typename T, size_t N>
+    EIRIN_ALWAYS_INLINE void avx_mm256_broadcast_rows(const std::array<T, N>& rows, __m256i (&res)[N])
+    {
+        for(size_t i = 0; i < N; ++i)
+            res[i] = _mm256_set1_epi64x(rows[i]);
+    }
+#endif
+} // namespace detail
+
+/**
+ * @brief Rotates v by the unit quaternion q through its rotation matrix, the same arithmetic as the batched ``rotate``.
+ */
+template <typename Fixed>
+EIRIN_ALWAYS_INLINE constexpr vec3<Fixed> rotate(const quaternion<Fixed>& q, const vec3<Fixed>& v) noexcept
+{
+    return detail::rotate_rows(detail::rotation_rows(q), v);
+}
+
+/**
+ * @brief Rotates every vector of vs in place by the unit quaternion q.
+ * The rotation matrix is computed once, and with AVX2 the fixed64 vectors are rotated 4 at a time.
+ * The results are bit-identical to the single ``rotate`` with or without AVX2.
+ */
+template <typename Fixed>
+inline void rotate(const quaternion<Fixed>& q, std::span<vec3<Fixed>> vs) noexcept
+{
+    const auto rows = detail::rotation_rows(q);
+    size_t i = 0;
+#if defined(EIRIN_PLATFORM_SIMD_AVX2) && defined(EIRIN_MATH_HAS_INT128)
+    if constexpr(std::is_same_v<Fixed, fixed64>)
+    {
+        static_assert(sizeof(vec3<fixed64>) == 3 * sizeof(int64_t));
+        __m256i lanes[9];
+        detail::avx_mm256_broadcast_rows(rows, lanes);
+        for(; i + 4 <= vs.size(); i += 4)
+        {
+            __m256i x, y, z;
+            detail::avx_mm256_load_vec3x4(vs.data() + i, x, y, z);
+            detail::avx_mm256_rotate_epi64(lanes, x, y, z);
+            detail::avx_mm256_store_vec3x4(vs.data() + i, x, y, z);
+        }
+    }
+#endif
+    for(; i < vs.size(); ++i)
+        vs[i] = detail::rotate_rows(rows, vs[i]);
+}
+} // namespace eirin
+
+#endif
@@ -0,0 +1,575 @@
+#ifndef EIRIN_MATH_SOA_HPP
+#define EIRIN_MATH_SOA_HPP
+
+#pragma once
+
+#include "fixed.hpp"
+#include "math.hpp"
+#include "vec.hpp"
+#include "quaternion.hpp"
+#include "detail/memory.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+#    include "ext/simd_math.hpp"
+#endif
+
+namespace eirin
+{
+/**
+ * @brief Structure of arrays of 3D vectors, every component is stored in its own 64 bytes aligned column,
+ *        so the batch operations process 8 (fixed32) or 4 (fixed64) components per AVX2 instruction.
+ * The iterators and ``operator[]`` yield proxy references which read and write the three columns.
+ *
+ * @tparam Fixed the fixed point type of the components.
+ */
+template <typename Fixed>
+class soa_vec3
+{
+public:
+    static constexpr size_t alignment = 64;
+    using value_type = vec3<Fixed>;
+    using column_type = std::vector<Fixed, detail::aligned_allocator<Fixed, alignment>>;
+
+    /**
+     * @brief The proxy reference to one vector in the columns.
+     */
+    template <bool Const>
+    struct basic_reference
+    {
+        using component = std::conditional_t<Const, const Fixed, Fixed>;
+        component &x, &y, &z;
+
+        constexpr operator vec3<Fixed>() const noexcept
+        {
+            return {x, y, z};
+        }
+
+        constexpr const basic_reference& operator=(const vec3<Fixed>& v) const noexcept
+            requires(!Const)
+        {
+            x = v.x;
+            y = v.y;
+            z = v.z;
+            return *this;
+        }
+
+        constexpr const basic_reference& operator=(const basic_reference& other) const noexcept
+            requires(!Const)
+        {
+            return *this = static_cast<vec3<Fixed>>(other);
+        }
+    };
+
+    using reference = basic_reference<false>;
+    using const_reference = basic_reference<true>;
+
+    template <bool Const>
+    class basic_iterator
+    {
+        using owner = std::conditional_t<Const, const soa_vec3, soa_vec3>;
+        owner* m_owner = nullptr;
+        size_t m_index = 0;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = vec3<Fixed>;
+        using difference_type = std::ptrdiff_t;
+        using reference = basic_reference<Const>;
+
+        constexpr basic_iterator() noexcept = default;
+
+        constexpr basic_iterator(owner* o, size_t index) noexcept : m_owner(o), m_index(index)
+        {
+        }
+
+        constexpr reference operator*() const noexcept
+        {
+            return (*m_owner)[m_index];
+        }
+
+        constexpr reference operator[](difference_type n) const noexcept
+        {
+            return (*m_owner)[m_index + n];
+        }
+
+        constexpr basic_iterator& operator++() noexcept
+        {
+            ++m_index;
+            return *this;
+        }
+
+        constexpr basic_iterator operator++(int) noexcept
+        {
+            auto res = *this;
+            ++m_index;
+            return res;
+        }
+
+        constexpr basic_iterator& operator--() noexcept
+        {
+            --m_index;
+            return *this;
+        }
+
+        constexpr basic_iterator operator--(int) noexcept
+        {
+            auto res = *this;
+            --m_index;
+            return res;
+        }
+
+        constexpr basic_iterator& operator+=(difference_type n) noexcept
+        {
+            m_index += n;
+            return *this;
+        }
+
+        constexpr basic_iterator& operator-=(difference_type n) noexcept
+        {
+            m_index -= n;
+            return *this;
+        }
+
+        constexpr basic_iterator operator+(difference_type n) const noexcept
+        {
+            return {m_owner, m_index + n};
+        }
+
+        friend constexpr basic_iterator operator+(difference_type n, const basic_iterator& it) noexcept
+        {
+            return it + n;
+        }
+
+        constexpr basic_iterator operator-(difference_type n) const noexcept
+        {
+            return {m_owner, m_index - n};
+        }
+
+        constexpr difference_type operator-(const basic_iterator& other) const noexcept
+        {
+            return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+        }
+
+        constexpr bool operator==(const basic_iterator& other) const noexcept
+        {
+            return m_index == other.m_index;
+        }
+
+        constexpr auto operator<=>(const basic_iterator& other) const noexcept
+        {
+            return m_index <=> other.m_index;
+        }
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    soa_vec3() = default;
+
+    explicit soa_vec3(size_t n) : m_x(n), m_y(n), m_z(n)
+    {
+    }
+
+    soa_vec3(std::initializer_list<vec3<Fixed>> values)
+    {
+        reserve(values.size());
+        for(const auto& v : values)
+            push_back(v);
+    }
+
+    size_t size() const noexcept
+    {
+        return m_x.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return m_x.empty();
+    }
+
+    void reserve(size_t n)
+    {
+        m_x.reserve(n);
+        m_y.reserve(n);
+        m_z.reserve(n);
+    }
+
+    void resize(size_t n)
+    {
+        m_x.resize(n);
+        m_y.resize(n);
+        m_z.resize(n);
+    }
+
+    void clear() noexcept
+    {
+        m_x.clear();
+        m_y.clear();
+        m_z.clear();
+    }
+
+    void push_back(const vec3<Fixed>& v)
+    {
+        m_x.push_back(v.x);
+        m_y.push_back(v.y);
+        m_z.push_back(v.z);
+    }
+
+    reference operator[](size_t i) noexcept
+    {
+        return {m_x[i], m_y[i], m_z[i]};
+    }
+
+    const_reference operator[](size_t i) const noexcept
+    {
+        return {m_x[i], m_y[i], m_z[i]};
+    }
+
+    iterator begin() noexcept
+    {
+        return {this, 0};
+    }
+
+    iterator end() noexcept
+    {
+        return {this, size()};
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return {this, 0};
+    }
+
+    const_iterator end() const noexcept
+    {
+        return {this, size()};
+    }
+
+    std::span<Fixed> xs() noexcept
+    {
+        return m_x;
+    }
+
+    std::span<Fixed> ys() noexcept
+    {
+        return m_y;
+    }
+
+    std::span<Fixed> zs() noexcept
+    {
+        return m_z;
+    }
+
+    std::span<const Fixed> xs() const noexcept
+    {
+        return m_x;
+    }
+
+    std::span<const Fixed> ys() const noexcept
+    {
+        return m_y;
+    }
+
+    std::span<const Fixed> zs() const noexcept
+    {
+        return m_z;
+    }
+
+private:
+    column_type m_x, m_y, m_z;
+};
+
+namespace detail
+{
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+    /**
+     * @brief Lane-wise fixed32 multiplication of 8 lanes, bit-identical to the scalar ``operator*``.
+     * The low 32 bits of (a * b) >> 16 do not depend on the sign extension, so logical shifts are enough.
+     */
+    EIRIN_ALWAYS_INLINE __m256i avx_mm256_fpmul_epi32(__m256i a, __m256i b)
+    {
+        const __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(a, b), 16);
+        const __m256i odd = _mm256_slli_epi64(_mm256_srli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)), 16), 32);
+        return _mm256_blend_epi32(even, odd, 0xAA);
+    }
+
+    /**
+     * @brief The 8 lanes dot products of fixed32 columns, summed in 64 bits and shifted once like ``dot``.
+     */
+    EIRIN_ALWAYS_INLINE __m256i avx_mm256_dot3_epi32(__m256i ax, __m256i ay, __m256i az, __m256i bx, __m256i by, __m256i bz)
+    {
+        const auto odd = [](__m256i v) { return _mm256_srli_epi64(v, 32); };
+        const __m256i even = _mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epi32(ax, bx), _mm256_mul_epi32(ay, by)), _mm256_mul_epi32(az, bz));
+        const __m256i odds = _mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epi32(odd(ax), odd(bx)), _mm256_mul_epi32(odd(ay), odd(by))),
+                                              _mm256_mul_epi32(odd(az), odd(bz)));
+        return _mm256_blend_epi32(_mm256_srli_epi64(even, 16), _mm256_slli_epi64(_mm256_srli_epi64(odds, 16), 32), 0xAA);
+    }
+
+    /**
+     * @brief The 8 lanes of c * y / 2^shift rounded to the nearest, bit-identical to ``scale_by_rsqrt``.
+     * AVX2 has no arithmetic shift of 64 bits lanes, so the products are biased by 2^62 to shift them logically.
+     */
+    EIRIN_ALWAYS_INLINE __m256i avx_mm256_scale_epi32(__m256i c, __m256i y, __m256i shift)
+    {
+        const __m256i one = _mm256_set1_epi64x(1);
+        const __m256i bias = _mm256_set1_epi64x(int64_t(1) << 62);
+        const auto scale = [&](__m256i product, __m256i s)
+        {
+            const __m256i half = _mm256_sllv_epi64(one, _mm256_sub_epi64(s, one));
+            return _mm256_sub_epi64(_mm256_srlv_epi64(_mm256_add_epi64(_mm256_add_epi64(product, half), bias), s), _mm256_srlv_epi64(bias, s));
+        };
+        const __m256i even = scale(_mm256_mul_epi32(c, y), _mm256_and_si256(shift, _mm256_set1_epi64x(0xFFFFFFFF)));
+        const __m256i odd = scale(_mm256_mul_epi32(_mm256_srli_epi64(c, 32), _mm256_srli_epi64(y, 32)), _mm256_srli_epi64(shift, 32));
+        return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+    }
+
+    template <typename Fixed>
+    inline constexpr size_t soa_lanes = std::is_same_v<Fixed, fixed32> ? 8 : (std::is_same_v<Fixed, fixed64> ? 4 : 0);
+
+    // the emulated 64 bits lane multiplication is slower than the scalar one, so only fixed32 multiplies in lanes.
+    template <typename Fixed>
+    inline constexpr size_t soa_mul_lanes = std::is_same_v<Fixed, fixed32> ? 8 : 0;
+
+    template <typename Fixed>
+    EIRIN_ALWAYS_INLINE __m256i soa_load(const Fixed* p)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+
+    template <typename Fixed>
+    EIRIN_ALWAYS_INLINE void soa_store(Fixed* p, __m256i v)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+
+    template <typename Fixed>
+    EIRIN_ALWAYS_INLINE __m256i soa_add(__m256i a, __m256i b)
+    {
+        if constexpr(std::is_same_v<Fixed, fixed32>)
+            return _mm256_add_epi32(a, b);
+        else
+            return _mm256_add_epi64(a, b);
+    }
+#else
+    template <typename Fixed>
+    inline constexpr size_t soa_lanes = 0;
+
+    template <typename Fixed>
+    inline constexpr size_t soa_mul_lanes = 0;
+#endif
+} // namespace detail
+
+/**
+ * @brief out[i] = a[i] + b[i], out may be a or b.
+ */
+template <typename Fixed>
+inline void add(soa_vec3<Fixed>& out, const soa_vec3<Fixed>& a, const soa_vec3<Fixed>& b) noexcept
+{
+    const size_t n = std::min({out.size(), a.size(), b.size()});
+    const Fixed* const in_a[] = {a.xs().data(), a.ys().data(), a.zs().data()};
+    const Fixed* const in_b[] = {b.xs().data(), b.ys().data(), b.zs().data()};
+    Fixed* const res[] = {out.xs().data(), out.ys().data(), out.zs().data()};
+    for(size_t c = 0; c < 3; ++c)
+    {
+        const Fixed* pa = in_a[c];
+        const Fixed* pb = in_b[c];
+        Fixed* pr = res[c];
+        size_t i = 0;
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+        if constexpr(detail::soa_lanes<Fixed> != 0)
+        {
+            constexpr size_t lanes = detail::soa_lanes<Fixed>;
+            for(; i + lanes <= n; i += lanes)
+                detail::soa_store(pr + i, detail::soa_add<Fixed>(detail::soa_load(pa + i), detail::soa_load(pb + i)));
+        }
+#endif
+        for(; i < n; ++i)
+            pr[i] = pa[i] + pb[i];
+    }
+}
+
+/**
+ * @brief out[i] = a[i] * s, out may be a.
+ */
+template <typename Fixed>
+inline void scale(soa_vec3<Fixed>& out, const soa_vec3<Fixed>& a, Fixed s) noexcept
+{
+    const size_t n = std::min(out.size(), a.size());
+    const Fixed* const in[] = {a.xs().data(), a.ys().data(), a.zs().data()};
+    Fixed* const res[] = {out.xs().data(), out.ys().data(), out.zs().data()};
+    for(size_t c = 0; c < 3; ++c)
+    {
+        const Fixed* pa = in[c];
+        Fixed* pr = res[c];
+        size_t i = 0;
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+        if constexpr(detail::soa_mul_lanes<Fixed> != 0)
+        {
+            const __m256i sv = _mm256_set1_epi32(s.internal_value());
+            for(; i + 8 <= n; i += 8)
+                detail::soa_store(pr + i, detail::avx_mm256_fpmul_epi32(detail::soa_load(pa + i), sv));
+        }
+#endif
+        for(; i < n; ++i)
+            pr[i] = pa[i] * s;
+    }
+}
+
+/**
+ * @brief out[i] = a[i] + b[i] * s in a single pass, like the integration step pos += vel * dt. out may be a or b.
+ */
+template <typename Fixed>
+inline void add_scaled(soa_vec3<Fixed>& out, const soa_vec3<Fixed>& a, const soa_vec3<Fixed>& b, Fixed s) noexcept
+{
+    const size_t n = std::min({out.size(), a.size(), b.size()});
+    const Fixed* const in_a[] = {a.xs().data(), a.ys().data(), a.zs().data()};
+    const Fixed* const in_b[] = {b.xs().data(), b.ys().data(), b.zs().data()};
+    Fixed* const res[] = {out.xs().data(), out.ys().data(), out.zs().data()};
+    for(size_t c = 0; c < 3; ++c)
+    {
+        const Fixed* pa = in_a[c];
+        const Fixed* pb = in_b[c];
+        Fixed* pr = res[c];
+        size_t i = 0;
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+        if constexpr(detail::soa_mul_lanes<Fixed> != 0)
+        {
+            const __m256i sv = _mm256_set1_epi32(s.internal_value());
+            for(; i + 8 <= n; i += 8)
+                detail::soa_store(pr + i, _mm256_add_epi32(detail::soa_load(pa + i), detail::avx_mm256_fpmul_epi32(detail::soa_load(pb + i), sv)));
+        }
+#endif
+        for(; i < n; ++i)
+            pr[i] = pa[i] + pb[i] * s;
+    }
+}
+
+/**
+ * @brief out[i] = dot(a[i], b[i]), the same as ``dot`` of ``vec3``.
+ */
+template <typename Fixed>
+inline void dot(std::span<Fixed> out, const soa_vec3<Fixed>& a, const soa_vec3<Fixed>& b) noexcept
+{
+    const size_t n = std::min({out.size(), a.size(), b.size()});
+    size_t i = 0;
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+    // AVX2 has no 64 x 64 -> 128 bits multiplication, so only fixed32 sums the exact products in the lanes.
+    if constexpr(std::is_same_v<Fixed, fixed32>)
+    {
+        for(; i + 8 <= n; i += 8)
+        {
+            detail::soa_store(out.data() + i,
+                              detail::avx_mm256_dot3_epi32(detail::soa_load(a.xs().data() + i), detail::soa_load(a.ys().data() + i), detail::soa_load(a.zs().data() + i),
+                                                           detail::soa_load(b.xs().data() + i), detail::soa_load(b.ys().data() + i), detail::soa_load(b.zs().data() + i)));
+        }
+    }
+#endif
+    for(; i < n; ++i)
+        out[i] = dot(static_cast<vec3<Fixed>>(a[i]), static_cast<vec3<Fixed>>(b[i]));
+}
+
+namespace detail
+{
+    /**
+     * @brief {y, shift} of ``wide_rsqrt_kernel`` for the squared length of v, and {0, 1} for the zero vector, which stays zero.
+     */
+    template <typename T, typename I, unsigned int f, bool r>
+    EIRIN_ALWAYS_INLINE constexpr std::pair<T, int> soa_rsqrt(const vec3<fixed_num<T, I, f, r>>& v) noexcept
+    {
+        const auto norm = wide_norm(v);
+        if(norm == 0)
+            return {T(0), 1};
+        return wide_rsqrt_kernel<T, I, f>(norm);
+    }
+
+    // the vectors of ``normalize`` whose scales are kept on the stack at once.
+    inline constexpr size_t soa_normalize_block = 64;
+} // namespace detail
+
+/**
+ * @brief out[i] = normalize(a[i]), out may be a. Each vector is scaled by ``rsqrt`` of its squared length summed
+ *        in the intermediate type, bit-identical to ``normalize`` of ``vec3``.
+ */
+template <typename Fixed>
+inline void normalize(soa_vec3<Fixed>& out, const soa_vec3<Fixed>& a) noexcept
+{
+    using T = typename Fixed::value_type;
+    const size_t n = std::min(out.size(), a.size());
+    const Fixed* const in[] = {a.xs().data(), a.ys().data(), a.zs().data()};
+    Fixed* const res[] = {out.xs().data(), out.ys().data(), out.zs().data()};
+
+    // the scales of a block are computed before any of its columns is written, so out may be a.
+    T inv[detail::soa_normalize_block];
+    int32_t shifts[detail::soa_normalize_block];
+    for(size_t begin = 0; begin < n; begin += detail::soa_normalize_block)
+    {
+        const size_t count = std::min(n - begin, detail::soa_normalize_block);
+        for(size_t i = 0; i < count; ++i)
+            std::tie(inv[i], shifts[i]) = detail::soa_rsqrt(static_cast<vec3<Fixed>>(a[begin + i]));
+
+        for(size_t c = 0; c < 3; ++c)
+        {
+            const Fixed* pa = in[c] + begin;
+            Fixed* pr = res[c] + begin;
+            size_t i = 0;
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+            if constexpr(detail::soa_mul_lanes<Fixed> != 0)
+            {
+                for(; i + 8 <= count; i += 8)
+                    detail::soa_store(pr + i, detail::avx_mm256_scale_epi32(detail::soa_load(pa + i), detail::soa_load(inv + i), detail::soa_load(shifts + i)));
+            }
+#endif
+            for(; i < count; ++i)
+                pr[i] = detail::scale_by_rsqrt(pa[i], inv[i], shifts[i]);
+        }
+    }
+}
+
+/**
+ * @brief out[i] = rotate(q, a[i]) by the unit quaternion q, out may be a.
+ * With AVX2, fixed64 columns are rotated 4 lanes at a time, bit-identical to ``rotate`` of ``vec3``.
+ */
+template <typename Fixed>
+inline void rotate(soa_vec3<Fixed>& out, const soa_vec3<Fixed>& a, const quaternion<Fixed>& q) noexcept
+{
+    const size_t n = std::min(out.size(), a.size());
+    const auto rows = detail::rotation_rows(q);
+    const Fixed *px = a.xs().data(), *py = a.ys().data(), *pz = a.zs().data();
+    Fixed *rx = out.xs().data(), *ry = out.ys().data(), *rz = out.zs().data();
+    size_t i = 0;
+#if defined(EIRIN_PLATFORM_SIMD_AVX2) && defined(EIRIN_MATH_HAS_INT128)
+    if constexpr(std::is_same_v<Fixed, fixed64>)
+    {
+        __m256i lanes[9];
+        detail::avx_mm256_broadcast_rows(rows, lanes);
+        for(; i + 4 <= n; i += 4)
+        {
+            __m256i x = detail::soa_load(px + i), y = detail::soa_load(py + i), z = detail::soa_load(pz + i);
+            detail::avx_mm256_rotate_epi64(lanes, x, y, z);
+            detail::soa_store(rx + i, x);
+            detail::soa_store(ry + i, y);
+            detail::soa_store(rz + i, z);
+        }
+    }
+#endif
+    for(; i < n; ++i)
+    {
+        const auto v = detail::rotate_rows(rows, vec3<Fixed>{px[i], py[i], pz[i]});
+        rx[i] = v.x;
+        ry[i] = v.y;
+        rz[i] = v.z;
+    }
+}
+} // namespace eirin
+
+#endif
@@ -0,0 +1,435 @@
+#ifndef EIRIN_MATH_VEC_HPP
+#define EIRIN_MATH_VEC_HPP
+
+#pragma once
+
+#include "fixed.hpp"
+#include "math.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#if defined(EIRIN_PLATFORM_SIMD_AVX2) || defined(__SSE4_1__)
+#    include <immintrin.h>
+#endif
+
+namespace eirin
+{
+/**
+ * @brief 2D vector of fixed point numbers.
+ *
+ * @tparam Fixed the fixed point type of the components.
+ */
+template <typename Fixed>
+struct vec2
+{
+    static constexpr size_t size = 2;
+    using value_type = Fixed;
+
+    Fixed x, y;
+
+    constexpr Fixed& operator[](size_t i) noexcept
+    {
+        return i == 0 ? x : y;
+    }
+
+    constexpr const Fixed& operator[](size_t i) const noexcept
+    {
+        return i == 0 ? x : y;
+    }
+
+    constexpr bool operator==(const vec2&) const noexcept = default;
+};
+
+/**
+ * @brief 3D vector of fixed point numbers.
+ *
+ * @tparam Fixed the fixed point type of the components.
+ */
+template <typename Fixed>
+struct vec3
+{
+    static constexpr size_t size = 3;
+    using value_type = Fixed;
+
+    Fixed x, y, z;
+
+    constexpr Fixed& operator[](size_t i) noexcept
+    {
+        return i == 0 ? x : (i == 1 ? y : z);
+    }
+
+    constexpr const Fixed& operator[](size_t i) const noexcept
+    {
+        return i == 0 ? x : (i == 1 ? y : z);
+    }
+
+    constexpr bool operator==(const vec3&) const noexcept = default;
+};
+
+/**
+ * @brief 4D vector of fixed point numbers, the components are contiguous so a vector fits one SIMD register
+ *        for fixed32 (SSE) and fixed64 (AVX2).
+ *
+ * @tparam Fixed the fixed point type of the components.
+ */
+template <typename Fixed>
+struct vec4
+{
+    static constexpr size_t size = 4;
+    using value_type = Fixed;
+
+    Fixed x, y, z, w;
+
+    constexpr Fixed& operator[](size_t i) noexcept
+    {
+        return i == 0 ? x : (i == 1 ? y : (i == 2 ? z : w));
+    }
+
+    constexpr const Fixed& operator[](size_t i) const noexcept
+    {
+        return i == 0 ? x : (i == 1 ? y : (i == 2 ? z : w));
+    }
+
+    constexpr bool operator==(const vec4&) const noexcept = default;
+};
+
+namespace detail
+{
+    template <typename V>
+    struct is_fixed_vec : std::false_type
+    {
+    };
+
+    template <typename Fixed>
+    struct is_fixed_vec<vec2<Fixed>> : std::true_type
+    {
+    };
+
+    template <typename Fixed>
+    struct is_fixed_vec<vec3<Fixed>> : std::true_type
+    {
+    };
+
+    template <typename Fixed>
+    struct is_fixed_vec<vec4<Fixed>> : std::true_type
+    {
+    };
+
+    template <typename V, typename Op>
+    EIRIN_ALWAYS_INLINE constexpr V vec_map(const V& a, const V& b, Op op) noexcept
+    {
+        V res{};
+        for(size_t i = 0; i < V::size; ++i)
+            res[i] = op(a[i], b[i]);
+        return res;
+    }
+
+#if defined(EIRIN_PLATFORM_SIMD_AVX2) && defined(EIRIN_MATH_HAS_INT128)
+    template <typename V>
+    inline constexpr bool is_avx2_vec = std::is_same_v<V, vec4<fixed64>>;
+#else
+    template <typename V>
+    inline constexpr bool is_avx2_vec = false;
+#endif
+} // namespace detail
+
+template <typename V>
+concept fixed_vec = detail::is_fixed_vec<V>::value;
+
+template <fixed_vec V>
+EIRIN_ALWAYS_INLINE constexpr V operator+(const V& a, const V& b) noexcept
+{
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+    if constexpr(detail::is_avx2_vec<V>)
+    {
+        if(!std::is_constant_evaluated())
+        {
+            V res;
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&res),
+                                _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&a)),
+                                                 _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b))));
+            return res;
+        }
+    }
+#endif
+    return detail::vec_map(a, b, [](auto l, auto r) { return l + r; });
+}
+
+template <fixed_vec V>
+EIRIN_ALWAYS_INLINE constexpr V operator-(const V& a, const V& b) noexcept
+{
+#ifdef EIRIN_PLATFORM_SIMD_AVX2
+    if constexpr(detail::is_avx2_vec<V>)
+    {
+        if(!std::is_constant_evaluated())
+        {
+            V res;
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&res),
+                                _mm256_sub_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&a)),
+                                                 _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b))));
+            return res;
+        }
+    }
+#endif
+    return detail::vec_map(a, b, [](auto l, auto r) { return l - r; });
+}
+
+template <fixed_vec V>
+EIRIN_ALWAYS_INLINE constexpr V operator-(const V& a) noexcept
+{
+    return V{} - a;
+}
+
+template <fixed_vec V>
+EIRIN_ALWAYS_INLINE constexpr V operator*(const V& a, typename V::value_type s) noexcept
+{
+    V res{};
+    for(size_t i = 0; i < V::size; ++i)
+        res[i] = a[i] * s;
+    return res;
+}
+
+template <fixed_vec V>
+EIRIN_ALWAYS_INLINE constexpr V operator*(typename V::value_type s, const V& a) noexcept
+{
+    return a * s;
+}
+
+template <fixed_vec V>
+EIRIN_ALWAYS_INLINE constexpr V operator/(const V& a, typename V::value_type s) noexcept
+{
+    V res{};
+    for(size_t i = 0; i < V::size; ++i)
+        res[i] = a[i] / s;
+    return res;
+}
+
+template <fixed_vec V>
+EIRIN_ALWAYS_INLINE constexpr V& operator+=(V& a, const V& b) noexcept
+{
+    return a = a + b;
+}
+
+template <fixed_vec V>
+EIRIN_ALWAYS_INLINE constexpr V& operator-=(V& a, const V& b) noexcept
+{
+    return a = a - b;
+}
+
+template <fixed_vec V>
+EIRIN_ALWAYS_INLINE constexpr V& operator*=(V& a, typename V::value_type s) noexcept
+{
+    return a = a * s;
+}
+
+template <fixed_vec V>
+EIRIN_ALWAYS_INLINE constexpr V& operator/=(V& a, typename V::value_type s) noexcept
+{
+    return a = a / s;
+}
+
+namespace detail
+{
+    /**
+     * @brief Shifts a sum of products with 2f fraction bits back to f fraction bits, rounding like ``operator*``.
+     */
+    template <typename T, typename I, unsigned int f, bool r>
+    EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> narrow_product(I sum) noexcept
+    {
+        using fixed = fixed_num<T, I, f, r>;
+        if constexpr(r)
+        {
+            const I value = sum / (I(1) << (f - 1));
+            return fixed::from_internal_value(static_cast<T>(value + (value % 2)));
+        }
+        else
+            return fixed::from_internal_value(static_cast<T>(sum >> f));
+    }
+
+    template <typename T, typename I, unsigned int f, bool r>
+    EIRIN_ALWAYS_INLINE constexpr I wide_product(fixed_num<T, I, f, r> a, fixed_num<T, I, f, r> b) noexcept
+    {
+        return static_cast<I>(a.internal_value()) * b.internal_value();
+    }
+
+    template <typename U>
+    EIRIN_ALWAYS_INLINE constexpr int wide_countl_zero(U x) noexcept
+    {
+        if constexpr(sizeof(U) <= sizeof(uint64_t))
+            return std::countl_zero(x);
+        else
+        {
+            const auto high = static_cast<uint64_t>(x >> 64);
+            return high != 0 ? std::countl_zero(high) : 64 + std::countl_zero(static_cast<uint64_t>(x));
+        }
+    }
+
+    /**
+     * @brief The squared length with 2f fraction bits in the unsigned intermediate type, where ``dot`` would narrow
+     *        and wrap it. The sum of three squares always fits, the sum of four saturates only when all are the min value.
+     */
+    template <typename T, typename I, unsigned int f, bool r, template <typename> typename V>
+    EIRIN_ALWAYS_INLINE constexpr typename wide_unsigned<I>::type wide_norm(const V<fixed_num<T, I, f, r>>& v) noexcept
+    {
+        using U = typename wide_unsigned<I>::type;
+        U sum = 0;
+        for(size_t i = 0; i < V<fixed_num<T, I, f, r>>::size; ++i)
+        {
+            const auto square = static_cast<U>(wide_product(v[i], v[i]));
+            sum = sum + square < sum ? ~U(0) : sum + square;
+        }
+        return sum;
+    }
+
+    /**
+     * @brief The square root of a squared length with 2f fraction bits is the length with f fraction bits,
+     *        which saturates to the max value.
+     */
+    template <typename T, typename I, unsigned int f, bool r, typename U>
+    EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> wide_length(U norm) noexcept
+    {
+        using fixed = fixed_num<T, I, f, r>;
+        const U root = isqrt<U>(norm);
+        if(root > static_cast<U>(std::numeric_limits<T>::max()))
+            return std::numeric_limits<fixed>::max();
+        return fixed::from_internal_value(static_cast<T>(root));
+    }
+
+    /**
+     * @brief 1 / sqrt of a positive squared length with 2f fraction bits, as y / 2^shift like ``rsqrt_kernel``.
+     * The top bits of the squared length are taken as a value with f fraction bits times an even power of two,
+     * so the kernel sees W - 3 significant bits for any length.
+     */
+    template <typename T, typename I, unsigned int f, typename U>
+    EIRIN_ALWAYS_INLINE constexpr std::pair<T, int> wide_rsqrt_kernel(U norm) noexcept
+    {
+        constexpr int width = sizeof(T) * 8;
+        // norm << 2g has one of its top two bits set, and (s - f) is even.
+        const int g = wide_countl_zero(norm) / 2;
+        constexpr int s = (width + 1 - static_cast<int>(f)) % 2 == 0 ? width + 1 : width + 2;
+        const auto x = static_cast<T>((norm << (2 * g)) >> s);
+        // norm / 2^2f = x / 2^f * 4^e.
+        const int e = (s - static_cast<int>(f)) / 2 - g;
+        const auto [y, shift] = rsqrt_kernel<T, I, f>(x);
+        return {y, shift + e};
+    }
+
+    /**
+     * @brief c * y / 2^shift rounded to the nearest, the component scaled by the result of ``wide_rsqrt_kernel``.
+     */
+    template <typename T, typename I, unsigned int f, bool r>
+    EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> scale_by_rsqrt(fixed_num<T, I, f, r> c, T y, int shift) noexcept
+    {
+        return fixed_num<T, I, f, r>::from_internal_value(static_cast<T>((static_cast<I>(c.internal_value()) * y + (I(1) << (shift - 1))) >> shift));
+    }
+} // namespace detail
+
+/**
+ * @brief Dot product, the products are summed in the intermediate type and shifted once,
+ *        so the result is more precise than the sum of the truncated products.
+ */
+template <typename T, typename I, unsigned int f, bool r, template <typename> typename V>
+requires fixed_vec<V<fixed_num<T, I, f, r>>>
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> dot(const V<fixed_num<T, I, f, r>>& a, const V<fixed_num<T, I, f, r>>& b) noexcept
+{
+#ifdef __SSE4_1__
+    if constexpr(std::is_same_v<V<fixed_num<T, I, f, r>>, vec4<fixed32>>)
+    {
+        if(!std::is_constant_evaluated())
+        {
+            // _mm_mul_epi32 multiplies the even lanes into two 64 bit products, so the odd lanes are shifted down first.
+            const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&a));
+            const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&b));
+            const __m128i even = _mm_mul_epi32(va, vb);
+            const __m128i odd = _mm_mul_epi32(_mm_srli_epi64(va, 32), _mm_srli_epi64(vb, 32));
+            const __m128i sum = _mm_add_epi64(even, odd);
+            const auto total = _mm_cvtsi128_si64(sum) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(sum, sum));
+            return detail::narrow_product<T, I, f, r>(total);
+        }
+    }
+#endif
+    I sum = detail::wide_product(a[0], b[0]);
+    for(size_t i = 1; i < V<fixed_num<T, I, f, r>>::size; ++i)
+        sum += detail::wide_product(a[i], b[i]);
+    return detail::narrow_product<T, I, f, r>(sum);
+}
+
+/**
+ * @brief Cross product of 3D vectors, every component is a difference of products with a single shift.
+ */
+template <typename T, typename I, unsigned int f, bool r>
+EIRIN_ALWAYS_INLINE constexpr vec3<fixed_num<T, I, f, r>> cross(const vec3<fixed_num<T, I, f, r>>& a, const vec3<fixed_num<T, I, f, r>>& b) noexcept
+{
+    using detail::narrow_product;
+    using detail::wide_product;
+    return {narrow_product<T, I, f, r>(wide_product(a.y, b.z) - wide_product(a.z, b.y)),
+            narrow_product<T, I, f, r>(wide_product(a.z, b.x) - wide_product(a.x, b.z)),
+            narrow_product<T, I, f, r>(wide_product(a.x, b.y) - wide_product(a.y, b.x))};
+}
+
+/**
+ * @brief The z component of the cross product of 2D vectors, a.x * b.y - a.y * b.x.
+ */
+template <typename T, typename I, unsigned int f, bool r>
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> cross(const vec2<fixed_num<T, I, f, r>>& a, const vec2<fixed_num<T, I, f, r>>& b) noexcept
+{
+    return detail::narrow_product<T, I, f, r>(detail::wide_product(a.x, b.y) - detail::wide_product(a.y, b.x));
+}
+
+template <fixed_vec V>
+EIRIN_ALWAYS_INLINE constexpr typename V::value_type length_squared(const V& v) noexcept
+{
+    return dot(v, v);
+}
+
+/**
+ * @brief The root of the squared length summed in the intermediate type, so long vectors do not wrap.
+ * @note The result saturates to the max value.
+ */
+template <typename T, typename I, unsigned int f, bool r, template <typename> typename V>
+requires fixed_vec<V<fixed_num<T, I, f, r>>>
+EIRIN_ALWAYS_INLINE constexpr fixed_num<T, I, f, r> length(const V<fixed_num<T, I, f, r>>& v) noexcept
+{
+    return detail::wide_length<T, I, f, r>(detail::wide_norm(v));
+}
+
+template <fixed_vec V>
+EIRIN_ALWAYS_INLINE constexpr typename V::value_type distance(const V& a, const V& b) noexcept
+{
+    return length(b - a);
+}
+
+/**
+ * @brief The unit vector of the same direction, the zero vector is returned as is.
+ * The components are multiplied by 1 / sqrt of the squared length in the intermediate type before the final rounding,
+ * so both long and short vectors keep their precision.
+ */
+template <typename T, typename I, unsigned int f, bool r, template <typename> typename V>
+requires fixed_vec<V<fixed_num<T, I, f, r>>>
+EIRIN_ALWAYS_INLINE constexpr V<fixed_num<T, I, f, r>> normalize(const V<fixed_num<T, I, f, r>>& v) noexcept
+{
+    const auto norm = detail::wide_norm(v);
+    if(norm == 0)
+        return v;
+    const auto [y, shift] = detail::wide_rsqrt_kernel<T, I, f>(norm);
+    V<fixed_num<T, I, f, r>> res{};
+    for(size_t i = 0; i < V<fixed_num<T, I, f, r>>::size; ++i)
+        res[i] = detail::scale_by_rsqrt(v[i], y, shift);
+    return res;
+}
+
+/**
+ * @brief Linear interpolation a + (b - a) * t.
+ */
+template <fixed_vec V>
+EIRIN_ALWAYS_INLINE constexpr V lerp(const V& a, const V& b, typename V::value_type t) noexcept
+{
+    return a + (b - a) * t;
+}
+} // namespace eirin
+
+#endif
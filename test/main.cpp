@@ -1,9 +1,21 @@
 #include <gtest/gtest.h>
+#include <numbers>
+#include <complex>
 #include <eirin/eirin.hpp>
 #include <eirin/io/format.hpp>
 #include <eirin/ext/cordic.hpp>
+#include <eirin/poly.hpp>
+#include <eirin/soa.hpp>
+#include <eirin/matrix.hpp>
+#include <eirin/quaternion.hpp>
+#include <eirin/dsp/fft.hpp>
+#include <eirin/dsp/filter.hpp>
 #include <eirin/detail/util.hpp>
 #include <eirin/detail/perf.hpp>
+#include <eirin/policy.hpp>
+#include <eirin/convert.hpp>
+#include <eirin/algorithm.hpp>
+#include <eirin/angle.hpp>
 
 #ifdef EIRIN_DEV_TEST_MODE
 #include <eirin/ext/simd_math.hpp>
@@ -114,6 +126,27 @@ static testing::AssertionResult expect_fixed_eq(
         return testing::AssertionSuccess();
 }
 #endif
+
+// the largest distance in ulps between the output of a forward transform and the DFT of the input divided by its size.
+template <typename Fixed>
+static long double fft_max_error(const std::vector<eirin::dsp::complex<Fixed>>& input, const std::vector<eirin::dsp::complex<Fixed>>& output)
+{
+    const auto n = input.size();
+    const auto to_ld = [](Fixed v) { return std::ldexp(static_cast<long double>(v.internal_value()), -static_cast<int>(Fixed::precision)); };
+    std::vector<std::complex<long double>> roots(n);
+    for(size_t k = 0; k < n; ++k)
+        roots[k] = std::polar(1.0L, -2 * std::numbers::pi_v<long double> * k / n);
+    long double error = 0;
+    for(size_t k = 0; k < n; ++k)
+    {
+        std::complex<long double> sum = 0;
+        for(size_t j = 0; j < n; ++j)
+            sum += std::complex<long double>(to_ld(input[j].re), to_ld(input[j].im)) * roots[j * k % n];
+        sum /= static_cast<long double>(n);
+        error = std::max(error, std::abs(sum - std::complex<long double>(to_ld(output[k].re), to_ld(output[k].im))));
+    }
+    return std::ldexp(error, static_cast<int>(Fixed::precision));
+}
 } // namespace test_math
 
 TEST(Fixed32, Math)
@@ -143,6 +176,11 @@ TEST(Fixed32, Math)
     EXPECT_EQ(cbrt(1_f32), 1_f32);
     EXPECT_EQ(cbrt(8_f32), 2_f32);
     EXPECT_EQ(cbrt(27_f32), 3_f32);
+    EXPECT_EQ(cbrt(-27_f32), -3_f32);
+    EXPECT_EQ(cbrt(min_value<fixed32>()), -32_f32);
+    EXPECT_EQ(cbrt(-2_f32), -fixed32::from_internal_value(82570));
+    EXPECT_EQ(cbrt(766_f32), fixed32::from_internal_value(599639));
+    EXPECT_EQ(cbrt(max_value<fixed32>()), fixed32::from_internal_value(2097152));
     EXPECT_EQ(log2(2_f32), 1_f32);
     EXPECT_EQ(log2(10_f32), 3.321928_f32);
     EXPECT_TRUE(expect_fixed_eq(log(fixed32::e()), 1_f32));
@@ -154,6 +192,877 @@ TEST(Fixed32, Math)
     EXPECT_TRUE(expect_fixed_eq(degrees(numbers::pi), 180_f32));
 }
 
+TEST(Fixed32, DivBy)
+{
+    constexpr auto three_quarters = 0.75_f32;
+    constexpr auto neg_ln10 = -numbers::ln10;
+    constexpr auto tiny = 0.001_f32;
+    constexpr auto hundred_eighty = 180_f32;
+    eirin::mt19937 rng(114514u);
+    for(int i = 0; i < 10000; ++i)
+    {
+        auto x = fixed32::from_internal_value(static_cast<int32_t>(rng()));
+        EXPECT_EQ(div_by<numbers::pi>(x), x / numbers::pi);
+        EXPECT_EQ(div_by<hundred_eighty>(x), x / hundred_eighty);
+        EXPECT_EQ(div_by<three_quarters>(x), x / three_quarters);
+        EXPECT_EQ(div_by<neg_ln10>(x), x / neg_ln10);
+        EXPECT_EQ(div_by<tiny>(x), x / tiny);
+    }
+    EXPECT_EQ(div_by<numbers::pi>(min_value<fixed32>()), min_value<fixed32>() / numbers::pi);
+    EXPECT_EQ(div_by<numbers::pi>(max_value<fixed32>()), max_value<fixed32>() / numbers::pi);
+}
+
+TEST(Fixed32, SinCos)
+{
+    using test_math::expect_fixed_eq;
+
+    for(auto x = -20_f32; x <= 20_f32; x += 0.01_f32)
+    {
+        auto [s, c] = sincos(x);
+        EXPECT_EQ(s, sin(x));
+        EXPECT_TRUE(expect_fixed_eq(c, cos(x)));
+
+        auto [cs, cc] = cordic_sincos(x);
+        EXPECT_EQ(cs, cordic_sine(x));
+        EXPECT_TRUE(expect_fixed_eq(cc, cos(x), test_math::arc_triangle_max_error));
+    }
+    EXPECT_EQ(sincos(0_f32).second, 1_f32);
+    EXPECT_EQ(sincos(-0.0001_f32).first, -0.0001_f32);
+}
+
+TEST(Fixed32, Atan2)
+{
+    using test_math::expect_fixed_eq;
+
+    EXPECT_EQ(atan2(0_f32, 0_f32), 0_f32);
+    EXPECT_EQ(cordic_polar(0_f32, 0_f32), std::pair(0_f32, 0_f32));
+    EXPECT_EQ(cordic_polar(max_value<fixed32>(), max_value<fixed32>()).first, max_value<fixed32>());
+    EXPECT_EQ(cordic_polar(min_value<fixed32>(), 1_f32).first, max_value<fixed32>());
+    EXPECT_TRUE(expect_fixed_eq(atan2(0_f32, -1_f32), fixed32::pi()));
+    EXPECT_TRUE(expect_fixed_eq(cordic_atan2(0_f32, -1_f32), fixed32::pi()));
+    for(double radius : {0.01, 1.0, 100.0})
+    {
+        for(double theta = -3.14; theta <= 3.14; theta += 0.01)
+        {
+            auto x = fixed32(radius * std::cos(theta));
+            auto y = fixed32(radius * std::sin(theta));
+            // the reference from the quantized inputs.
+            double xd = std::ldexp(static_cast<double>(x.internal_value()), -16);
+            double yd = std::ldexp(static_cast<double>(y.internal_value()), -16);
+            auto expected = fixed32(std::atan2(yd, xd));
+            EXPECT_TRUE(expect_fixed_eq(atan2(y, x), expected, test_math::arc_triangle_max_error));
+
+            auto [magnitude, angle] = cordic_polar(x, y);
+            EXPECT_TRUE(expect_fixed_eq(angle, expected));
+            EXPECT_TRUE(expect_fixed_eq(magnitude, fixed32(std::hypot(xd, yd))));
+            EXPECT_EQ(cordic_atan2(y, x), angle);
+            EXPECT_EQ(cordic_hypot(x, y), magnitude);
+        }
+    }
+}
+
+TEST(Fixed32, CordicHyperbolic)
+{
+    using test_math::expect_fixed_eq;
+
+    EXPECT_EQ(cordic_exp(0_f32), 1_f32);
+    EXPECT_EQ(cordic_log(1_f32), 0_f32);
+    EXPECT_EQ(cordic_sqrt(0_f32), 0_f32);
+    EXPECT_EQ(cordic_sqrt(4_f32), 2_f32);
+    EXPECT_EQ(cordic_exp(100_f32), max_value<fixed32>());
+    EXPECT_EQ(cordic_exp(-100_f32), 0_f32);
+    EXPECT_EQ(cordic_tanh(100_f32), 1_f32);
+    for(auto x = -6_f32; x <= 6_f32; x += 0.01_f32)
+    {
+        double xd = std::ldexp(static_cast<double>(x.internal_value()), -16);
+        EXPECT_TRUE(expect_fixed_eq(cordic_exp(x), fixed32(std::exp(xd))));
+        EXPECT_TRUE(expect_fixed_eq(cordic_sinh(x), fixed32(std::sinh(xd))));
+        EXPECT_TRUE(expect_fixed_eq(cordic_cosh(x), fixed32(std::cosh(xd))));
+        EXPECT_TRUE(expect_fixed_eq(cordic_tanh(x), fixed32(std::tanh(xd))));
+        if(x > 0_f32)
+        {
+            EXPECT_TRUE(expect_fixed_eq(cordic_log(x), fixed32(std::log(xd))));
+            EXPECT_TRUE(expect_fixed_eq(cordic_sqrt(x), fixed32(std::sqrt(xd))));
+        }
+    }
+    EXPECT_THROW(cordic_log(0_f32), std::domain_error);
+    EXPECT_THROW(cordic_sqrt(-1_f32), std::domain_error);
+}
+
+TEST(Fixed32, FastLog2)
+{
+    EXPECT_EQ(fast_log2(1_f32), 0_f32);
+    EXPECT_EQ(fast_log2(1024_f32), 10_f32);
+    EXPECT_EQ(fast_log2(0.125_f32), -3_f32);
+    EXPECT_THROW(fast_log2(0_f32), std::domain_error);
+    EXPECT_THROW(fast_log2(-1_f32), std::domain_error);
+
+    // the final rounding is the only visible error.
+    const auto max_error = std::ldexp(0.51L, -16);
+    for(uint64_t raw = 1; raw <= static_cast<uint64_t>(std::numeric_limits<decltype(fixed32().internal_value())>::max()); raw += 1 + raw / 1000)
+    {
+        auto x = fixed32::from_internal_value(static_cast<int32_t>(raw));
+        long double expected = std::log2(static_cast<long double>(raw)) - 16;
+        long double actual = std::ldexp(static_cast<long double>(fast_log2(x).internal_value()), -16);
+        EXPECT_LE(std::fabs(actual - expected), max_error) << "raw value: " << raw;
+    }
+
+    // the kernel precision is W - 2 fraction bits, the types with as many or more are not rounded.
+    using fixed2_30 = fixed_num<int32_t, int64_t, 30, false>;
+    using fixed1_31 = fixed_num<int32_t, int64_t, 31, false>;
+    EXPECT_NEAR(static_cast<double>(fast_log2(fixed2_30(0.5))), -1.0, 1e-8);
+    EXPECT_NEAR(static_cast<double>(fast_log2(fixed2_30(1.5))), std::log2(1.5), 1e-8);
+    EXPECT_NEAR(static_cast<double>(fast_log2(fixed1_31(0.75))), std::log2(0.75), 1e-8);
+}
+
+TEST(Fixed32, Exp2)
+{
+    EXPECT_EQ(exp2(0_f32), 1_f32);
+    EXPECT_EQ(exp2(10_f32), 1024_f32);
+    EXPECT_EQ(exp2(-3_f32), 0.125_f32);
+    EXPECT_EQ(exp(100_f32), max_value<fixed32>());
+    EXPECT_EQ(exp(-100_f32), 0_f32);
+    EXPECT_EQ(pow(2_f32, 3_f32), 8_f32);
+    EXPECT_EQ(pow(-2_f32, 3_f32), -8_f32);
+    EXPECT_EQ(pow(0_f32, 0_f32), 1_f32);
+    EXPECT_EQ(pow(0_f32, 2.5_f32), 0_f32);
+    EXPECT_THROW(pow(-2_f32, 0.5_f32), std::domain_error);
+
+    // half an ulp of the final rounding plus a relative error of the mantissa.
+    const auto ulp = std::ldexp(1.0L, -16);
+    const auto relative = std::ldexp(1.0L, -27);
+    for(auto v = -12_f32; v < 10.3_f32; v += 0.001_f32)
+    {
+        long double x = std::ldexp(static_cast<long double>(v.internal_value()), -16);
+        long double expected = std::exp(x);
+        long double actual = std::ldexp(static_cast<long double>(exp(v).internal_value()), -16);
+        EXPECT_LE(std::fabs(actual - expected), ulp / 2 + expected * relative) << "x: " << v;
+        expected = std::exp2(x);
+        actual = std::ldexp(static_cast<long double>(exp2(v).internal_value()), -16);
+        EXPECT_LE(std::fabs(actual - expected), ulp / 2 + expected * relative) << "x: " << v;
+        if(v > 0_f32)
+        {
+            expected = std::pow(x, 1.5L);
+            actual = std::ldexp(static_cast<long double>(pow(v, 1.5_f32).internal_value()), -16);
+            EXPECT_LE(std::fabs(actual - expected), ulp + expected * relative * 4) << "x: " << v;
+        }
+    }
+}
+
+TEST(Fixed32, Minimax)
+{
+    // each format takes the lowest degree polynomial which meets its half ulp.
+    constexpr auto poly = detail::minimax_select(detail::minimax_sin_quarter, 17);
+    static_assert(poly.error_bits >= 17);
+
+    const auto ulp = std::ldexp(1.0L, -16);
+    for(auto v = 0_f32; v <= 1_f32; v += 0.0001_f32)
+    {
+        long double x = std::ldexp(static_cast<long double>(v.internal_value()), -16);
+        long double actual = std::ldexp(static_cast<long double>(detail::sin_quarter(v).internal_value()), -16);
+        EXPECT_LE(std::fabs(actual - std::sin(x * std::numbers::pi_v<long double> / 2)), ulp) << "x: " << v;
+        actual = std::ldexp(static_cast<long double>(detail::atan_unit(v).internal_value()), -16);
+        EXPECT_LE(std::fabs(actual - std::atan(x)), ulp) << "x: " << v;
+    }
+    for(auto v = -100_f32; v <= 100_f32; v += 0.37_f32)
+    {
+        long double x = std::ldexp(static_cast<long double>(v.internal_value()), -16);
+        long double actual = std::ldexp(static_cast<long double>(atan(v).internal_value()), -16);
+        EXPECT_LE(std::fabs(actual - std::atan(x)), ulp * 2) << "x: " << v;
+    }
+}
+
+TEST(Fixed32, PolyEval)
+{
+    static_assert(poly_eval<3_f32>(2_f32) == 3_f32);
+    static_assert(poly_eval<1_f32, 2_f32, 3_f32>(2_f32) == 17_f32);
+    static_assert(poly_eval<poly_scheme::horner, 1_f32, 2_f32, 3_f32, 4_f32>(-2_f32) == -23_f32);
+
+    // each product truncates, so the two schemes only differ by a few ulp.
+    const auto max_error = std::ldexp(8.0L, -16);
+    for(auto v = -1_f32; v <= 1_f32; v += 0.001_f32)
+    {
+        auto horner = poly_eval<poly_scheme::horner, 1_f32, 1_f32, 0.5_f32, fixed32(1.0 / 6), fixed32(1.0 / 24), fixed32(1.0 / 120)>(v);
+        auto estrin = poly_eval<1_f32, 1_f32, 0.5_f32, fixed32(1.0 / 6), fixed32(1.0 / 24), fixed32(1.0 / 120)>(v);
+        long double x = std::ldexp(static_cast<long double>(v.internal_value()), -16);
+        long double expected = 1 + x + x * x / 2 + x * x * x / 6 + x * x * x * x / 24 + x * x * x * x * x / 120;
+        EXPECT_LE(std::fabs(std::ldexp(static_cast<long double>(horner.internal_value()), -16) - expected), max_error) << "x: " << v;
+        EXPECT_LE(std::fabs(std::ldexp(static_cast<long double>(estrin.internal_value()), -16) - expected), max_error) << "x: " << v;
+    }
+}
+
+TEST(Fixed32, Vec)
+{
+    using test_math::expect_fixed_eq;
+
+    constexpr vec3<fixed32> a{1_f32, 2_f32, 3_f32};
+    constexpr vec3<fixed32> b{4_f32, -5_f32, 6_f32};
+    static_assert(dot(a, b) == 12_f32);
+    static_assert(cross(a, b) == vec3<fixed32>{27_f32, 6_f32, -13_f32});
+    static_assert(cross(vec2<fixed32>{1_f32, 2_f32}, vec2<fixed32>{3_f32, 4_f32}) == -2_f32);
+    static_assert(a + b - b == a);
+    static_assert(-a * 2_f32 == vec3<fixed32>{-2_f32, -4_f32, -6_f32});
+    EXPECT_EQ(lerp(a, b, 0.5_f32), (vec3<fixed32>{2.5_f32, -1.5_f32, 4.5_f32}));
+    EXPECT_TRUE(expect_fixed_eq(length(vec3<fixed32>{2_f32, 3_f32, 6_f32}), 7_f32));
+    EXPECT_EQ(normalize(vec3<fixed32>{}), vec3<fixed32>{});
+
+    // the squared lengths above the max value are summed in the intermediate type.
+    static_assert(length(vec3<fixed32>{200_f32, 0_f32, 0_f32}) == 200_f32);
+    static_assert(normalize(vec3<fixed32>{200_f32, 0_f32, 0_f32}) == vec3<fixed32>{1_f32, 0_f32, 0_f32});
+    EXPECT_EQ(distance(vec2<fixed32>{-200_f32, 0_f32}, vec2<fixed32>{200_f32, 0_f32}), 2 * 200_f32);
+    EXPECT_TRUE(expect_fixed_eq(length(vec3<fixed32>{15000_f32, -15000_f32, 15000_f32}), 25980.762113533_f32));
+    EXPECT_EQ(length(vec4<fixed32>{min_value<fixed32>(), min_value<fixed32>(), min_value<fixed32>(), min_value<fixed32>()}), max_value<fixed32>());
+    const auto diagonal = normalize(vec4<fixed32>{min_value<fixed32>(), min_value<fixed32>(), min_value<fixed32>(), min_value<fixed32>()});
+    EXPECT_TRUE(expect_fixed_eq(diagonal.x, -0.5_f32));
+    EXPECT_TRUE(expect_fixed_eq(length(normalize(vec3<fixed32>{15000_f32, 200_f32, -3_f32})), 1_f32));
+
+    // the products are summed before a single shift, so the dot product is the exact sum floored once.
+    // the components are small enough for the dot products not to overflow.
+    eirin::pcg2014_64 rng(114514u);
+    const auto random = [&rng]
+    { return fixed32::from_internal_value(static_cast<decltype(fixed32().internal_value())>(static_cast<int64_t>(rng()) >> 41)); };
+    for(int i = 0; i < 1000; ++i)
+    {
+        vec4<fixed32> u{random(), random(), random(), random()};
+        vec4<fixed32> v{random(), random(), random(), random()};
+        long double expected = 0;
+        for(size_t j = 0; j < 4; ++j)
+            expected += std::ldexp(static_cast<long double>(u[j].internal_value()), -16) * std::ldexp(static_cast<long double>(v[j].internal_value()), -16);
+        auto actual = std::ldexp(static_cast<long double>(dot(u, v).internal_value()), -16);
+        EXPECT_LE(std::fabs(actual - expected), std::ldexp(1.0L, -16)) << "u.x: " << u.x << ", v.x: " << v.x;
+        EXPECT_EQ(u + v - v, u);
+
+        vec3<fixed32> w{u.x, u.y, u.z};
+        if(length(w) > 0.01_f32)
+        {
+            EXPECT_TRUE(expect_fixed_eq(length(normalize(w)), 1_f32, 0.001_f32));
+        }
+    }
+}
+
+TEST(Fixed32, SoaVec3)
+{
+    eirin::pcg2014_64 rng(1919810u);
+    const auto random = [&rng]
+    { return fixed32::from_internal_value(static_cast<decltype(fixed32().internal_value())>(static_cast<int64_t>(rng()) >> 41)); };
+
+    // an odd size to cover the scalar tails of the SIMD loops.
+    soa_vec3<fixed32> a, b;
+    for(int i = 0; i < 1027; ++i)
+    {
+        a.push_back({random(), random(), random()});
+        b.push_back({random(), random(), random()});
+    }
+    EXPECT_EQ(static_cast<size_t>(a.end() - a.begin()), a.size());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a.xs().data()) % soa_vec3<fixed32>::alignment, 0u);
+
+    soa_vec3<fixed32> sum(a.size()), scaled(a.size()), unit(a.size()), step(a.size());
+    std::vector<fixed32> dots(a.size());
+    add(sum, a, b);
+    scale(scaled, a, 0.75_f32);
+    add_scaled(step, a, b, 0.01_f32);
+    dot(std::span<fixed32>(dots), a, b);
+    normalize(unit, a);
+    for(size_t i = 0; i < a.size(); ++i)
+    {
+        vec3<fixed32> u = a[i], v = b[i];
+        EXPECT_EQ(static_cast<vec3<fixed32>>(sum[i]), u + v);
+        EXPECT_EQ(static_cast<vec3<fixed32>>(scaled[i]), u * 0.75_f32);
+        EXPECT_EQ(static_cast<vec3<fixed32>>(step[i]), u + v * 0.01_f32);
+        EXPECT_EQ(dots[i], dot(u, v));
+        EXPECT_EQ(static_cast<vec3<fixed32>>(unit[i]), normalize(u));
+    }
+
+    // normalized in place block by block.
+    soa_vec3<fixed32> in_place = a;
+    normalize(in_place, in_place);
+    for(size_t i = 0; i < a.size(); ++i)
+        EXPECT_EQ(static_cast<vec3<fixed32>>(in_place[i]), static_cast<vec3<fixed32>>(unit[i]));
+
+    // the squared lengths of long vectors are summed in the intermediate type and do not wrap.
+    soa_vec3<fixed32> long_vecs{{200_f32, 0_f32, 0_f32}};
+    for(int i = 0; i < 16; ++i)
+        long_vecs.push_back({fixed32::from_internal_value(static_cast<decltype(fixed32().internal_value())>(static_cast<int64_t>(rng()) >> 33)), random(), random()});
+    soa_vec3<fixed32> long_units(long_vecs.size());
+    normalize(long_units, long_vecs);
+    EXPECT_EQ(static_cast<vec3<fixed32>>(long_units[0]), (vec3<fixed32>{1_f32, 0_f32, 0_f32}));
+    for(size_t i = 0; i < long_vecs.size(); ++i)
+    {
+        EXPECT_EQ(static_cast<vec3<fixed32>>(long_units[i]), normalize(static_cast<vec3<fixed32>>(long_vecs[i])));
+        EXPECT_TRUE(test_math::expect_fixed_eq(length(static_cast<vec3<fixed32>>(long_units[i])), 1_f32, 0.001_f32));
+    }
+
+    // the proxy references write through to the columns.
+    const vec3<fixed32> third = a[3];
+    for(auto v : a)
+        v = static_cast<vec3<fixed32>>(v) * 2_f32;
+    EXPECT_EQ(static_cast<vec3<fixed32>>(a[3]), third * 2_f32);
+    a[0] = b[0];
+    EXPECT_EQ(static_cast<vec3<fixed32>>(a[0]), static_cast<vec3<fixed32>>(b[0]));
+}
+
+TEST(Fixed32, Matrix)
+{
+    constexpr matrix<fixed32, 2, 3> a{{1_f32, 2_f32, 3_f32, 4_f32, 5_f32, 6_f32}};
+    constexpr matrix<fixed32, 3, 2> b{{7_f32, 8_f32, 9_f32, 10_f32, 11_f32, 12_f32}};
+    static_assert(a * b == matrix<fixed32, 2, 2>{{58_f32, 64_f32, 139_f32, 154_f32}});
+    static_assert(transpose(transpose(a)) == a);
+    static_assert(matrix<fixed32, 3, 3>::identity() * vec3<fixed32>{1_f32, 2_f32, 3_f32} == vec3<fixed32>{1_f32, 2_f32, 3_f32});
+    EXPECT_EQ(a + a, a * 2_f32);
+    EXPECT_EQ(a - a, (matrix<fixed32, 2, 3>{}));
+    EXPECT_EQ(transpose(a)(2, 1), 6_f32);
+
+    eirin::pcg2014_64 rng(1919810u);
+    const auto random = [&rng]
+    { return fixed32::from_internal_value(static_cast<decltype(fixed32().internal_value())>(static_cast<int64_t>(rng()) >> 41)); };
+    // odd sizes to cover the edge tiles and the scalar tails.
+    dense_matrix<fixed32> x(37, 53), y(53, 29);
+    for(size_t i = 0; i < x.rows(); ++i)
+        for(auto& v : x.row(i))
+            v = random();
+    for(size_t i = 0; i < y.rows(); ++i)
+        for(auto& v : y.row(i))
+            v = random();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(x.data()) % dense_matrix<fixed32>::alignment, 0u);
+
+    const auto product = multiply(x, y, 1);
+    ASSERT_EQ(product.rows(), 37u);
+    ASSERT_EQ(product.cols(), 29u);
+    for(size_t i = 0; i < product.rows(); ++i)
+        for(size_t j = 0; j < product.cols(); ++j)
+        {
+            auto sum = eirin::detail::wide_product(x(i, 0), y(0, j));
+            for(size_t k = 1; k < x.cols(); ++k)
+                sum += eirin::detail::wide_product(x(i, k), y(k, j));
+            EXPECT_EQ(product(i, j), (eirin::detail::narrow_product<int32_t, int64_t, 16, false>(sum)));
+        }
+    // the result is bit-identical for any number of threads.
+    EXPECT_EQ(multiply(x, y, 2), product);
+    EXPECT_EQ(multiply(x, y, 3), product);
+    EXPECT_EQ(x * y, product);
+    // the products above the minimum work per thread are split among the threads.
+    dense_matrix<fixed32> wide_x(97, 101), wide_y(101, 95);
+    for(auto* m : {&wide_x, &wide_y})
+        for(size_t i = 0; i < m->rows(); ++i)
+            for(auto& v : m->row(i))
+                v = random();
+    EXPECT_EQ(multiply(wide_x, wide_y, 3), multiply(wide_x, wide_y, 1));
+#ifndef EIRIN_NO_EXCEPTIONS
+    EXPECT_THROW(multiply(x, x), std::invalid_argument);
+#endif
+}
+
+TEST(Fixed32, Rsqrt)
+{
+    EXPECT_EQ(rsqrt(4_f32), 0.5_f32);
+    EXPECT_EQ(rsqrt(1_f32 / 4), 2_f32);
+    EXPECT_EQ(rsqrt(1_f32), 1_f32);
+    eirin::pcg2014_64 rng(1919810u);
+    for(int i = 0; i < 100000; ++i)
+    {
+        // raw values spread over all magnitudes.
+        const auto raw = static_cast<decltype(fixed32().internal_value())>(rng() >> (rng() % 31 + 1));
+        if(raw <= 0)
+            continue;
+        const long double expected = 1.0L / std::sqrt(std::ldexp(static_cast<long double>(raw), -16));
+        const long double actual = std::ldexp(static_cast<long double>(rsqrt(fixed32::from_internal_value(raw)).internal_value()), -16);
+        EXPECT_LE(std::fabs(actual - expected), std::ldexp(0.5L + 1e-6L, -16)) << raw;
+    }
+#ifndef EIRIN_NO_EXCEPTIONS
+    EXPECT_THROW(rsqrt(0_f32), std::domain_error);
+    EXPECT_THROW(rsqrt(-1_f32), std::domain_error);
+#endif
+}
+
+TEST(Fixed32, Quaternion)
+{
+    using test_math::expect_fixed_eq;
+    using quat = quaternion<fixed32>;
+    constexpr quat i{1_f32, 0_f32, 0_f32, 0_f32}, j{0_f32, 1_f32, 0_f32, 0_f32}, k{0_f32, 0_f32, 1_f32, 0_f32};
+    static_assert(i * j == k && j * k == i && k * i == j);
+    static_assert(i * i == -quat::identity());
+    static_assert(conjugate(i) * i == quat::identity());
+
+    const auto pi = numbers::pi_v<fixed32>();
+    const vec3<fixed32> z_axis{0_f32, 0_f32, 1_f32};
+    const auto quarter = from_axis_angle(z_axis, pi / 2);
+    const auto turned = rotate(quarter, vec3<fixed32>{2_f32, 0_f32, 0_f32});
+    EXPECT_TRUE(expect_fixed_eq(turned.x, 0_f32));
+    EXPECT_TRUE(expect_fixed_eq(turned.y, 2_f32));
+    EXPECT_TRUE(expect_fixed_eq(turned.z, 0_f32));
+    EXPECT_TRUE(expect_fixed_eq(dot(quarter * conjugate(quarter), quat::identity()), 1_f32));
+
+    const quat skewed{1_f32, 2_f32, 3_f32, 4_f32};
+    EXPECT_TRUE(expect_fixed_eq(length(normalize(skewed)), 1_f32));
+    EXPECT_EQ(normalize(quat{}), quat{});
+
+    // the squared lengths above the max value are summed in the intermediate type.
+    static_assert(length(quat{200_f32, 0_f32, 0_f32, 0_f32}) == 200_f32);
+    static_assert(normalize(quat{200_f32, 0_f32, 0_f32, 0_f32}) == quat{1_f32, 0_f32, 0_f32, 0_f32});
+    const quat long_skewed{200_f32, -2 * 200_f32, 3 * 200_f32, 4 * 200_f32};
+    EXPECT_TRUE(expect_fixed_eq(length(long_skewed), 200_f32 * sqrt(30_f32), 200_f32 * fixed32::nearly_compare_epsilon()));
+    for(size_t c = 0; c < 4; ++c)
+    {
+        EXPECT_TRUE(expect_fixed_eq(normalize(long_skewed)[c], normalize(skewed)[c] * (c == 1 ? -1 : 1)));
+    }
+
+    // slerp halfway to a quarter turn is an eighth turn, and the ends are the inputs.
+    const auto eighth = from_axis_angle(z_axis, pi / 4);
+    const auto half = slerp(quat::identity(), quarter, 1_f32 / 2);
+    for(size_t c = 0; c < 4; ++c)
+    {
+        EXPECT_TRUE(expect_fixed_eq(half[c], eighth[c], 0.001_f32));
+        EXPECT_TRUE(expect_fixed_eq(slerp(quat::identity(), quarter, 1_f32)[c], quarter[c], 0.001_f32));
+        EXPECT_TRUE(expect_fixed_eq(slerp(quarter, -eighth, 0_f32)[c], quarter[c], 0.001_f32));
+    }
+
+    // the batched rotations are bit-identical to the single one, an odd size covers the scalar tail.
+    eirin::pcg2014_64 rng(114514u);
+    const auto random = [&rng]
+    { return fixed32::from_internal_value(static_cast<decltype(fixed32().internal_value())>(static_cast<int64_t>(rng()) >> 41)); };
+    const auto q = normalize(quat{random(), random(), random(), random()});
+    std::vector<vec3<fixed32>> vs(1027);
+    soa_vec3<fixed32> soa;
+    for(auto& v : vs)
+    {
+        v = vec3<fixed32>{random(), random(), random()};
+        soa.push_back(v);
+    }
+    auto rotated = vs;
+    rotate(q, std::span<vec3<fixed32>>(rotated));
+    rotate(soa, soa, q);
+    for(size_t n = 0; n < vs.size(); ++n)
+    {
+        EXPECT_EQ(rotated[n], rotate(q, vs[n]));
+        EXPECT_EQ(static_cast<vec3<fixed32>>(soa[n]), rotated[n]);
+    }
+    // rotations keep the length, and compose like the product.
+    EXPECT_TRUE(expect_fixed_eq(length(rotated[5]), length(vs[5]), 0.01_f32));
+    const auto twice = rotate(q * quarter, vs[7]);
+    const auto stepwise = rotate(q, rotate(quarter, vs[7]));
+    for(size_t c = 0; c < 3; ++c)
+    {
+        EXPECT_TRUE(expect_fixed_eq(twice[c], stepwise[c], 0.01_f32));
+    }
+}
+
+TEST(Fixed32, Fft)
+{
+    using test_math::expect_fixed_eq;
+    using cfx = dsp::complex<fixed32>;
+    static_assert(cfx{0_f32, 1_f32} * cfx{0_f32, 1_f32} == cfx{-1_f32, 0_f32});
+    static_assert(conj(cfx{1_f32, 2_f32}) * cfx{0_f32, 1_f32} == cfx{2_f32, 1_f32});
+
+    // the raw values of std::mt19937_64 are fixed by the standard, so the inputs are the same everywhere.
+    std::mt19937_64 rng(114514u);
+    const auto random = [&rng]
+    { return fixed32::from_internal_value(static_cast<decltype(fixed32().internal_value())>(static_cast<int64_t>(rng()) >> 48)); };
+    // both the radix-2 first stage and the pure radix-4 sizes, below and above the 4 butterflies of the SIMD kernel.
+    for(size_t n : {2u, 4u, 8u, 32u, 128u, 1024u, 2048u})
+    {
+        std::vector<cfx> data(n);
+        for(auto& c : data)
+            c = {random(), random()};
+        const auto input = data;
+        const dsp::fft_plan<fixed32> plan(n);
+        plan.forward(data);
+        EXPECT_LE(test_math::fft_max_error(input, data), 4.0L) << n;
+        auto once = input;
+        dsp::fft(std::span<cfx>(once));
+        EXPECT_EQ(once, data);
+        // the rounding noise of the scaled forward transform grows with sqrt(n) in the inverse one.
+        plan.inverse(data);
+        const auto eps = fixed32::from_internal_value(static_cast<int32_t>(8 * std::sqrt(n)));
+        for(size_t k = 0; k < n; ++k)
+        {
+            EXPECT_TRUE(expect_fixed_eq(data[k].re, input[k].re, eps));
+            EXPECT_TRUE(expect_fixed_eq(data[k].im, input[k].im, eps));
+        }
+    }
+
+    // a pure tone lands in a single bin.
+    std::vector<cfx> tone(4096);
+    for(size_t k = 0; k < tone.size(); ++k)
+    {
+        const auto [s, c] = sincos(numbers::pi_v<fixed32>() * fixed32(static_cast<int>(k % 512)) / 256);
+        tone[k] = {c / 2, s / 2};
+    }
+    dsp::fft(std::span<cfx>(tone));
+    for(size_t k = 0; k < tone.size(); ++k)
+    {
+        EXPECT_TRUE(expect_fixed_eq(tone[k].re, k == 8 ? 0.5_f32 : 0_f32, 0.0005_f32)) << k;
+        EXPECT_TRUE(expect_fixed_eq(tone[k].im, 0_f32, 0.0005_f32)) << k;
+    }
+
+    // the results do not depend on the platform or on the SIMD kernel.
+    std::vector<cfx> large(1 << 16);
+    for(auto& c : large)
+        c = {random(), random()};
+    dsp::fft(std::span<cfx>(large));
+    uint64_t hash = 14695981039346656037u;
+    for(const auto& c : large)
+        hash = (hash ^ static_cast<uint32_t>(c.re.internal_value()) ^ (uint64_t(static_cast<uint32_t>(c.im.internal_value())) << 32)) * 1099511628211u;
+    EXPECT_EQ(hash, 9992904162878764391u);
+#ifndef EIRIN_NO_EXCEPTIONS
+    EXPECT_THROW(dsp::fft_plan<fixed32>(0), std::invalid_argument);
+    EXPECT_THROW(dsp::fft_plan<fixed32>(24), std::invalid_argument);
+    EXPECT_THROW(dsp::fft_plan<fixed32>(dsp::fft_plan<fixed32>::max_size * 2), std::invalid_argument);
+    EXPECT_THROW(dsp::fft_plan<fixed32>(8).forward(std::span<cfx>(large)), std::invalid_argument);
+#endif
+}
+
+TEST(Fixed32, Filter)
+{
+    std::mt19937_64 rng(114514u);
+    const auto random = [&rng]
+    { return fixed32::from_internal_value(static_cast<decltype(fixed32().internal_value())>(static_cast<int64_t>(rng()) >> 46)); };
+
+    // the impulse response of a FIR filter is its coefficients.
+    constexpr auto impulse = []
+    {
+        dsp::fir_filter<fixed32, 3> fir({1_f32 / 4, 1_f32 / 2, 1_f32 / 4});
+        std::array<fixed32, 4> res{};
+        for(size_t n = 0; n < res.size(); ++n)
+            res[n] = fir.process(n == 0 ? 1_f32 : 0_f32);
+        return res;
+    }();
+    static_assert(impulse == std::array<fixed32, 4>{1_f32 / 4, 1_f32 / 2, 1_f32 / 4, 0_f32});
+
+    // the outputs are the sums of the exact products shifted once, whatever the blocks of the stream and the SIMD kernel.
+    std::array<fixed32, 37> taps;
+    for(auto& c : taps)
+        c = random() / 8;
+    std::vector<fixed32> input(1000), output(input.size());
+    for(auto& x : input)
+        x = random();
+    dsp::fir_filter<fixed32, taps.size()> fir(taps);
+    size_t offset = 0;
+    for(size_t block : {1u, 7u, 300u, 12u, 680u})
+    {
+        fir.process(std::span<const fixed32>(input).subspan(offset, block), std::span<fixed32>(output).subspan(offset, block));
+        offset += block;
+    }
+    for(size_t n = 0; n < input.size(); ++n)
+    {
+        int64_t sum = 0;
+        for(size_t k = 0; k < taps.size() && k <= n; ++k)
+            sum += static_cast<int64_t>(taps[k].internal_value()) * input[n - k].internal_value();
+        EXPECT_EQ(output[n].internal_value(), static_cast<int32_t>(sum >> 16)) << n;
+    }
+    fir.reset();
+    auto in_place = input;
+    fir.process(in_place, in_place);
+    EXPECT_EQ(in_place, output);
+
+    // a low pass biquad passes the DC with a gain of (b0 + b1 + b2) / (1 + a1 + a2) = 1.
+    const dsp::biquad_coefficients<fixed32> low_pass{1_f32 / 16, 1_f32 / 8, 1_f32 / 16, -1_f32, 1_f32 / 4};
+    dsp::iir_filter<fixed32> step(low_pass);
+    std::vector<fixed32> ones(200, 1_f32), settled(ones.size());
+    step.process(ones, settled);
+    EXPECT_TRUE(test_math::expect_fixed_eq(settled.back(), 1_f32, 0.001_f32));
+
+    // every channel of the interleaved frames is the direct form I of its own samples, an odd count covers the scalar tail.
+    constexpr size_t channels = 7, frames = 150;
+    std::vector<fixed32> frames_in(channels * frames), frames_out(frames_in.size());
+    for(auto& x : frames_in)
+        x = random();
+    dsp::iir_filter<fixed32> bank(low_pass, channels);
+    bank.process(std::span<const fixed32>(frames_in).first(channels * 50), std::span<fixed32>(frames_out).first(channels * 50));
+    bank.process(std::span<const fixed32>(frames_in).subspan(channels * 50), std::span<fixed32>(frames_out).subspan(channels * 50));
+    for(size_t c = 0; c < channels; ++c)
+    {
+        int32_t x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+        for(size_t n = 0; n < frames; ++n)
+        {
+            const int32_t x = frames_in[n * channels + c].internal_value();
+            const int64_t sum = int64_t(low_pass.b0.internal_value()) * x + int64_t(low_pass.b1.internal_value()) * x1 +
+                                int64_t(low_pass.b2.internal_value()) * x2 - int64_t(low_pass.a1.internal_value()) * y1 -
+                                int64_t(low_pass.a2.internal_value()) * y2;
+            x2 = x1, x1 = x, y2 = y1, y1 = static_cast<int32_t>(sum >> 16);
+            EXPECT_EQ(frames_out[n * channels + c].internal_value(), y1) << c << ", " << n;
+        }
+    }
+#ifndef EIRIN_NO_EXCEPTIONS
+    EXPECT_THROW(fir.process(std::span<const fixed32>(input), std::span<fixed32>(output).first(3)), std::invalid_argument);
+    EXPECT_THROW(bank.process(std::span<const fixed32>(input).first(8), std::span<fixed32>(output).first(8)), std::invalid_argument);
+    EXPECT_THROW(dsp::iir_filter<fixed32>(low_pass, 0), std::invalid_argument);
+#endif
+}
+
+TEST(Fixed32, MeasureError)
+{
+    const auto ref = [](long double x) { return x; };
+    const auto exact = perf::measure_error(-100_f32, 100_f32, 10000, [](fixed32 x) { return x; }, ref, 4);
+    EXPECT_EQ(exact.samples, 10000u);
+    EXPECT_EQ(exact.max_ulp, 0);
+    EXPECT_EQ(exact.rms_ulp(), 0);
+    EXPECT_EQ(exact.histogram[0], 10000u);
+
+    // an error of exactly one ULP lands in the [1, 2) bucket, whatever the split over the threads.
+    const auto off_by_one = [](fixed32 x) { return fixed32::from_internal_value(x.internal_value() + 1); };
+    const auto single = perf::measure_error(-100_f32, 100_f32, 10001, off_by_one, ref, 1);
+    const auto split = perf::measure_error(-100_f32, 100_f32, 10001, off_by_one, ref, 3);
+    EXPECT_EQ(single.max_ulp, 1);
+    EXPECT_EQ(single.mean_ulp(), 1);
+    EXPECT_EQ(single.histogram[2], 10001u);
+    EXPECT_EQ(split.samples, single.samples);
+    EXPECT_EQ(split.max_ulp, single.max_ulp);
+    EXPECT_EQ(split.histogram, single.histogram);
+
+    // the worst input is reported with the max error.
+    const auto spike = [](fixed32 x) { return x == 25_f32 ? x + 1_f32 : x; };
+    const auto spiked = perf::measure_error(0_f32, 100_f32, 401, spike, ref, 3);
+    EXPECT_EQ(spiked.max_ulp, 65536);
+    EXPECT_EQ(spiked.max_ulp_input, 25);
+    EXPECT_EQ(spiked.histogram[perf::error_stats::histogram_size - 1], 1u);
+}
+
+TEST(Fixed32, Policy)
+{
+    static_assert(math_policy<policy::precise> && math_policy<policy::fast> && math_policy<policy::lut<256>> && math_policy<policy::cordic>);
+    static_assert(sin<policy::lut<256>>(0_f32) == 0_f32 && cos<policy::lut<256>>(0_f32) == 1_f32);
+    for(auto x : {-100_f32, -1_f32, 0_f32, 0.5_f32, 3_f32, 1000_f32})
+    {
+        EXPECT_EQ(sin<policy::precise>(x), sin(x));
+        EXPECT_EQ(policy::precise::atan(x), atan(x));
+        EXPECT_EQ(sincos<policy::fast>(x).first, sin<policy::fast>(x));
+    }
+
+    // the max errors in ULPs of every policy.
+    const auto max_ulp = [](auto func, long double (*ref)(long double), fixed32 lo, fixed32 hi)
+    { return perf::measure_error(lo, hi, 20001, func, ref, 1).max_ulp; };
+    const auto sin_ref = [](long double x) { return std::sin(x); };
+    const auto atan_ref = [](long double x) { return std::atan(x); };
+    const auto log_ref = [](long double x) { return std::log(x); };
+    const auto log2_ref = [](long double x) { return std::log2(x); };
+    EXPECT_LE(max_ulp([](fixed32 x) { return sin<policy::precise>(x); }, sin_ref, -100_f32, 100_f32), 16);
+    EXPECT_LE(max_ulp([](fixed32 x) { return sin<policy::fast>(x); }, sin_ref, -100_f32, 100_f32), 24);
+    EXPECT_LE(max_ulp([](fixed32 x) { return sin<policy::lut<>>(x); }, sin_ref, -100_f32, 100_f32), 16);
+    EXPECT_LE(max_ulp([](fixed32 x) { return sin<policy::cordic>(x); }, sin_ref, -100_f32, 100_f32), 32);
+    EXPECT_LE(max_ulp([](fixed32 x) { return atan<policy::fast>(x); }, atan_ref, -100_f32, 100_f32), 8);
+    EXPECT_LE(max_ulp([](fixed32 x) { return atan<policy::cordic>(x); }, atan_ref, -100_f32, 100_f32), 1.5);
+    EXPECT_LE(max_ulp([](fixed32 x) { return log<policy::precise>(x); }, log_ref, 0.01_f32, 10000_f32), 0.51);
+    EXPECT_LE(max_ulp([](fixed32 x) { return log2<policy::precise>(x); }, log2_ref, 0.01_f32, 10000_f32), 0.51);
+    EXPECT_LE(max_ulp([](fixed32 x) { return log2<policy::cordic>(x); }, log2_ref, 0.01_f32, 10000_f32), 1.5);
+
+    // the functions without a kernel of their own forward to the ones of precise.
+    static_assert(sinh<policy::precise>(0_f32) == 0_f32 && cosh<policy::precise>(0_f32) == 1_f32 && tanh<policy::precise>(0_f32) == 0_f32);
+    for(auto x : {-0.75_f32, 0_f32, 0.5_f32})
+    {
+        EXPECT_EQ(asin<policy::fast>(x), asin(x));
+        EXPECT_EQ(acos<policy::lut<>>(x), acos(x));
+        EXPECT_EQ(exp2<policy::cordic>(x), exp2(x));
+        EXPECT_EQ(cbrt<policy::precise>(x), cbrt(x));
+        EXPECT_EQ(tanh<policy::fast>(x), tanh<policy::precise>(x));
+    }
+    const auto sinh_ref = [](long double x) { return std::sinh(x); };
+    const auto cosh_ref = [](long double x) { return std::cosh(x); };
+    const auto tanh_ref = [](long double x) { return std::tanh(x); };
+    EXPECT_LE(max_ulp([](fixed32 x) { return sinh<policy::precise>(x); }, sinh_ref, -8_f32, 8_f32), 1.5);
+    EXPECT_LE(max_ulp([](fixed32 x) { return cosh<policy::precise>(x); }, cosh_ref, -8_f32, 8_f32), 1.5);
+    EXPECT_LE(max_ulp([](fixed32 x) { return tanh<policy::precise>(x); }, tanh_ref, -20_f32, 20_f32), 0.51);
+    EXPECT_LE(max_ulp([](fixed32 x) { return sinh<policy::cordic>(x); }, sinh_ref, -8_f32, 8_f32), 10);
+    EXPECT_LE(max_ulp([](fixed32 x) { return tanh<policy::cordic>(x); }, tanh_ref, -20_f32, 20_f32), 1);
+    EXPECT_EQ(cosh<policy::precise>(12_f32), max_value<fixed32>());
+    EXPECT_EQ(sinh<policy::precise>(min_value<fixed32>()), -max_value<fixed32>());
+
+    // a coarse table is less precise.
+    EXPECT_GT(max_ulp([](fixed32 x) { return sin<policy::lut<16>>(x); }, sin_ref, -4_f32, 4_f32), 50);
+#ifndef EIRIN_NO_EXCEPTIONS
+    EXPECT_THROW(log<policy::precise>(0_f32), std::domain_error);
+    EXPECT_THROW(log10<policy::precise>(-1_f32), std::domain_error);
+#endif
+}
+
+TEST(Fixed32, Convert)
+{
+    using rounded32 = fixed_num<int32_t, int64_t, 16, true>;
+    static_assert(static_cast<double>(0.5_f32) == 0.5 && static_cast<float>(-1.25_f32) == -1.25f);
+    static_assert(fixed32(0.75).internal_value() == 49152 && fixed32(-0.75f).internal_value() == -49152);
+    // a ULP and a half is truncated toward zero, or rounded half away from zero.
+    static_assert(fixed32(-0x1.8p-16).internal_value() == -1 && rounded32(-0x1.8p-16).internal_value() == -2);
+    static_assert(rounded32(0x1.8p-16f).internal_value() == 2 && rounded32(0x1.7ffp-16).internal_value() == 1);
+    EXPECT_EQ(static_cast<double>(fixed32::from_internal_value(std::numeric_limits<int32_t>::min())), -32768.0);
+
+    // the span conversions are bit-identical to the scalar ones, also in the tail after the AVX2 lanes.
+    std::mt19937_64 rng(114514u);
+    std::uniform_real_distribution<float> dist(-32767.0f, 32767.0f);
+    std::vector<fixed32> fixed_values(1003), converted(fixed_values.size());
+    std::vector<rounded32> rounded(fixed_values.size());
+    std::vector<float> floats(fixed_values.size()), back(fixed_values.size());
+    for(size_t i = 0; i < fixed_values.size(); ++i)
+    {
+        fixed_values[i] = fixed32::from_internal_value(static_cast<int32_t>(rng()));
+        // the halves of the ULP are the ties of the rounding.
+        floats[i] = i % 3 == 0 ? std::ldexp(std::round(std::ldexp(dist(rng), 17)), -17) : dist(rng);
+    }
+    to_float(fixed_values, back);
+    from_float(floats, converted);
+    from_floating(std::span<const float>(floats), std::span<rounded32>(rounded));
+    for(size_t i = 0; i < fixed_values.size(); ++i)
+    {
+        EXPECT_EQ(back[i], static_cast<float>(fixed_values[i])) << i;
+        EXPECT_EQ(converted[i], fixed32(floats[i])) << floats[i];
+        EXPECT_EQ(rounded[i], rounded32(floats[i])) << floats[i];
+    }
+#ifndef EIRIN_NO_EXCEPTIONS
+    EXPECT_THROW(to_float(fixed_values, std::span<float>(back).first(8)), std::invalid_argument);
+#endif
+}
+
+TEST(Fixed32, ConvertFormat)
+{
+    using fixed8_24 = fixed_num<int32_t, int64_t, 24, false>;
+    using rounded8 = fixed_num<int32_t, int64_t, 8, true>;
+    // the shifts truncate toward zero like the division they replace, or round half away from zero.
+    static_assert(fixed32(fixed8_24::from_internal_value(-0x180)).internal_value() == -1);
+    static_assert(rounded8(fixed32::from_internal_value(-0x180)).internal_value() == -2);
+    static_assert(rounded8(fixed32::from_internal_value(0x17F)).internal_value() == 1);
+    static_assert(fixed8_24(-3.25_f32) == fixed8_24(-3.25));
+    // 200 wraps in the 8 integer bits of fixed8_24, and saturates with convert_saturate.
+    static_assert(convert_saturate<fixed8_24>(200_f32).internal_value() == std::numeric_limits<int32_t>::max());
+    static_assert(convert_saturate<fixed8_24>(-200_f32).internal_value() == std::numeric_limits<int32_t>::min());
+    static_assert(convert_saturate<fixed8_24>(-3.25_f32) == fixed8_24(-3.25_f32));
+
+    std::mt19937_64 rng(114514u);
+    std::vector<fixed32> values(1003);
+    std::vector<fixed8_24> wrapped(values.size()), saturated(values.size());
+    std::vector<rounded8> rounded(values.size());
+    for(auto& x : values)
+        x = fixed32::from_internal_value(static_cast<int32_t>(rng()) >> (rng() % 32));
+    convert(std::span<const fixed32>(values), std::span<fixed8_24>(wrapped));
+    convert_saturate(std::span<const fixed32>(values), std::span<fixed8_24>(saturated));
+    convert(std::span<const fixed32>(values), std::span<rounded8>(rounded));
+    for(size_t i = 0; i < values.size(); ++i)
+    {
+        EXPECT_EQ(wrapped[i], fixed8_24(values[i])) << values[i];
+        EXPECT_EQ(saturated[i], abs(values[i]) < 127_f32 ? fixed8_24(values[i]) : convert_saturate<fixed8_24>(values[i])) << values[i];
+        EXPECT_EQ(rounded[i], rounded8(values[i])) << values[i];
+    }
+#ifndef EIRIN_NO_EXCEPTIONS
+    EXPECT_THROW(convert(std::span<const fixed32>(values), std::span<fixed8_24>(wrapped).first(1)), std::invalid_argument);
+#endif
+}
+
+TEST(Fixed32, Sort)
+{
+    // the raw values of every magnitude, with the min and the max values, and many duplicates.
+    std::mt19937_64 rng(114514u);
+    std::vector<fixed32> keys((size_t(1) << 17) + 3);
+    std::vector<uint32_t> order(keys.size());
+    for(size_t i = 0; i < keys.size(); ++i)
+    {
+        keys[i] = fixed32::from_internal_value(static_cast<int32_t>(rng()) >> (rng() % 32));
+        order[i] = static_cast<uint32_t>(i);
+    }
+    keys[7] = fixed32::from_internal_value(std::numeric_limits<int32_t>::min());
+    keys[8] = fixed32::from_internal_value(std::numeric_limits<int32_t>::max());
+    auto expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    auto sorted = keys;
+    radix_sort(std::span<fixed32>(sorted));
+    EXPECT_EQ(sorted, expected);
+    sorted = keys;
+    parallel_radix_sort(std::span<fixed32>(sorted), 4);
+    EXPECT_EQ(sorted, expected);
+    // the short arrays are sorted by insertion.
+    sorted.assign(keys.begin(), keys.begin() + 50);
+    radix_sort(std::span<fixed32>(sorted));
+    EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end()));
+
+    // the key-value sorts are stable.
+    sorted = keys;
+    auto values = order;
+    parallel_radix_sort(std::span<fixed32>(sorted), std::span<uint32_t>(values), 3);
+    EXPECT_EQ(sorted, expected);
+    for(size_t i = 0; i < keys.size(); ++i)
+    {
+        EXPECT_EQ(keys[values[i]], sorted[i]);
+        if(i > 0 && sorted[i] == sorted[i - 1])
+        {
+            EXPECT_LT(values[i - 1], values[i]);
+        }
+    }
+#ifndef EIRIN_NO_EXCEPTIONS
+    EXPECT_THROW(radix_sort(std::span<fixed32>(sorted), std::span<uint32_t>(values).first(3)), std::invalid_argument);
+#endif
+}
+
+TEST(Fixed32, Search)
+{
+    std::mt19937_64 rng(114514u);
+    std::vector<fixed32> data(1003);
+    for(auto& x : data)
+        x = fixed32::from_internal_value(static_cast<int32_t>(rng() % 4000) - 2000);
+    radix_sort(std::span<fixed32>(data));
+    // every length checks the tails after the binary search and the AVX2 lanes.
+    for(size_t n : {size_t(0), size_t(1), size_t(7), size_t(16), size_t(37), data.size()})
+    {
+        const std::span<const fixed32> sorted(data.data(), n);
+        for(int32_t raw = -2010; raw <= 2010; raw += 3)
+        {
+            const auto value = fixed32::from_internal_value(raw);
+            const auto expected = static_cast<size_t>(std::lower_bound(sorted.begin(), sorted.end(), value) - sorted.begin());
+            EXPECT_EQ(lower_bound(sorted, value), expected) << n << ' ' << raw;
+            EXPECT_EQ(linear_search(sorted, value), expected) << n << ' ' << raw;
+        }
+    }
+}
+
+TEST(Fixed32, Angle)
+{
+    using angle16 = angle<16>;
+    // a full turn wraps, and the quadrant is in the top two bits.
+    static_assert(angle16::from_internal_value(0xC000) + angle16::quarter_turn() == angle16());
+    static_assert((angle16() - angle16::quarter_turn()).quadrant() == 3 && (-angle16::half_turn()) == angle16::half_turn());
+    static_assert(sin(angle16::quarter_turn()) == 1_f32 && cos(angle16::half_turn()) == -1_f32 && sin(angle16()) == 0_f32);
+    static_assert(angle16::from_radians(numbers::pi) == angle16::half_turn());
+    static_assert(angle<12>::from_radians(-numbers::pi / 2_f32) == -angle<12>::quarter_turn());
+    static_assert(angle<8>::atan2(-1_f32, -1_f32).internal_value() == 160);
+    static_assert(angle16::atan2(0_f32, 0_f32) == angle16() && angle16::atan2(1_f32, 0_f32) == angle16::quarter_turn());
+
+    std::mt19937_64 rng(114514u);
+    std::vector<angle<32>> angles(1003);
+    for(auto& a : angles)
+        a = angle<32>::from_internal_value(static_cast<uint32_t>(rng()));
+    for(const auto& a : angles)
+    {
+        const double theta = std::ldexp(static_cast<double>(a.internal_value()), -32) * 2 * std::numbers::pi;
+        const auto [s, c] = sincos(a);
+        EXPECT_LE(std::abs(static_cast<double>(s) - std::sin(theta)), 0x1p-16) << theta;
+        EXPECT_LE(std::abs(static_cast<double>(c) - std::cos(theta)), 0x1p-16) << theta;
+        // [-pi, pi), and back to the same angle up to the resolution of fixed32.
+        const auto x = a.to_radians();
+        EXPECT_LE(std::abs(static_cast<double>(x) - std::remainder(theta, 2 * std::numbers::pi)), 0x1p-17) << theta;
+        const auto back = angle<32>::from_radians(x) - a;
+        EXPECT_LE(std::min<uint32_t>(back.internal_value(), -back.internal_value()), 1u << 16) << theta;
+    }
+    // within one binary angle of atan2, the quadrants of the signs of x and y.
+    for(int i = 0; i < 1000; ++i)
+    {
+        const auto y = fixed32::from_internal_value(static_cast<int32_t>(rng()) >> (rng() % 31));
+        const auto x = fixed32::from_internal_value(static_cast<int32_t>(rng()) >> (rng() % 31));
+        const double expected = std::atan2(static_cast<double>(y), static_cast<double>(x)) / (2 * std::numbers::pi) * 0x1p24;
+        const auto diff = static_cast<double>(angle<24>::atan2(y, x).internal_value()) - (expected < 0 ? expected + 0x1p24 : expected);
+        EXPECT_LE(std::min(std::abs(diff), 0x1p24 - std::abs(diff)), 1.0) << y << ' ' << x;
+    }
+
+    // the span functions are bit-identical to the scalar ones, also in the tail after the AVX2 lanes.
+    std::vector<fixed32> sins(angles.size()), coss(angles.size()), sins2(angles.size());
+    sincos(std::span<const angle<32>>(angles), std::span<fixed32>(sins), std::span<fixed32>(coss));
+    sin(std::span<const angle<32>>(angles), std::span<fixed32>(sins2));
+    for(size_t i = 0; i < angles.size(); ++i)
+    {
+        EXPECT_EQ(sins[i], sin(angles[i]));
+        EXPECT_EQ(coss[i], cos(angles[i]));
+        EXPECT_EQ(sins2[i], sins[i]);
+    }
+#ifndef EIRIN_NO_EXCEPTIONS
+    EXPECT_THROW(cos(std::span<const angle<32>>(angles), std::span<fixed32>(coss).first(2)), std::invalid_argument);
+#endif
+}
+
 TEST(FixedNum, Constants)
 {
     GTEST_LOG_(INFO) << "fixed32 max value: " << max_value<fixed32>() << ", min value: " << min_value<fixed32>();
@@ -279,6 +1188,823 @@ TEST(Fixed64, Decompression)
     }
 }
 
+TEST(Fixed64, DivBy)
+{
+    constexpr auto three_quarters = 0.75_f64;
+    constexpr auto neg_ln10 = -numbers::ln10_f64;
+    constexpr auto hundred_eighty = 180_f64;
+    eirin::mt19937_64 rng(114514u);
+    for(int i = 0; i < 10000; ++i)
+    {
+        auto x = fixed64::from_internal_value(static_cast<int64_t>(rng()));
+        EXPECT_EQ(div_by<numbers::pi_f64>(x), x / numbers::pi_f64);
+        EXPECT_EQ(div_by<hundred_eighty>(x), x / hundred_eighty);
+        EXPECT_EQ(div_by<three_quarters>(x), x / three_quarters);
+        EXPECT_EQ(div_by<neg_ln10>(x), x / neg_ln10);
+    }
+    EXPECT_EQ(div_by<numbers::pi_f64>(min_value<fixed64>()), min_value<fixed64>() / numbers::pi_f64);
+    EXPECT_EQ(div_by<numbers::pi_f64>(max_value<fixed64>()), max_value<fixed64>() / numbers::pi_f64);
+}
+
+TEST(Fixed64, SinCos)
+{
+    using test_math::expect_fixed_eq;
+
+    for(auto x = -20_f64; x <= 20_f64; x += 0.01_f64)
+    {
+        auto [s, c] = sincos(x);
+        EXPECT_EQ(s, sin(x));
+        EXPECT_TRUE(expect_fixed_eq(c, cos(x)));
+
+        auto [cs, cc] = cordic_sincos(x);
+        EXPECT_EQ(cs, cordic_sine(x));
+        EXPECT_TRUE(expect_fixed_eq(cc, cos(x)));
+    }
+}
+
+TEST(Fixed64, Atan2)
+{
+    using test_math::expect_fixed_eq;
+
+    EXPECT_EQ(atan2(0_f64, 0_f64), 0_f64);
+    EXPECT_EQ(cordic_polar(0_f64, 0_f64), std::pair(0_f64, 0_f64));
+    EXPECT_EQ(cordic_polar(max_value<fixed64>(), max_value<fixed64>()).first, max_value<fixed64>());
+    EXPECT_EQ(cordic_polar(min_value<fixed64>(), 1_f64).first, max_value<fixed64>());
+    EXPECT_TRUE(expect_fixed_eq(atan2(0_f64, -1_f64), fixed64::pi()));
+    EXPECT_TRUE(expect_fixed_eq(cordic_atan2(0_f64, -1_f64), fixed64::pi()));
+    for(double radius : {0.01, 1.0, 100.0})
+    {
+        for(double theta = -3.14; theta <= 3.14; theta += 0.01)
+        {
+            auto x = fixed64(radius * std::cos(theta));
+            auto y = fixed64(radius * std::sin(theta));
+            // the reference from the quantized inputs.
+            double xd = std::ldexp(static_cast<double>(x.internal_value()), -32);
+            double yd = std::ldexp(static_cast<double>(y.internal_value()), -32);
+            auto expected = fixed64(std::atan2(yd, xd));
+            EXPECT_TRUE(expect_fixed_eq(atan2(y, x), expected, test_math::arc_triangle_max_error_64));
+
+            auto [magnitude, angle] = cordic_polar(x, y);
+            EXPECT_TRUE(expect_fixed_eq(angle, expected));
+            EXPECT_TRUE(expect_fixed_eq(magnitude, fixed64(std::hypot(xd, yd))));
+            EXPECT_EQ(cordic_atan2(y, x), angle);
+            EXPECT_EQ(cordic_hypot(x, y), magnitude);
+        }
+    }
+}
+
+TEST(Fixed64, CordicHyperbolic)
+{
+    using test_math::expect_fixed_eq;
+
+    EXPECT_EQ(cordic_exp(0_f64), 1_f64);
+    EXPECT_EQ(cordic_log(1_f64), 0_f64);
+    EXPECT_EQ(cordic_sqrt(0_f64), 0_f64);
+    EXPECT_EQ(cordic_sqrt(4_f64), 2_f64);
+    EXPECT_EQ(cordic_exp(100_f64), max_value<fixed64>());
+    EXPECT_EQ(cordic_exp(-100_f64), 0_f64);
+    EXPECT_EQ(cordic_tanh(100_f64), 1_f64);
+    for(auto x = -9_f64; x <= 9_f64; x += 0.01_f64)
+    {
+        double xd = std::ldexp(static_cast<double>(x.internal_value()), -32);
+        EXPECT_TRUE(expect_fixed_eq(cordic_exp(x), fixed64(std::exp(xd))));
+        EXPECT_TRUE(expect_fixed_eq(cordic_sinh(x), fixed64(std::sinh(xd))));
+        EXPECT_TRUE(expect_fixed_eq(cordic_cosh(x), fixed64(std::cosh(xd))));
+        EXPECT_TRUE(expect_fixed_eq(cordic_tanh(x), fixed64(std::tanh(xd))));
+        if(x > 0_f64)
+        {
+            EXPECT_TRUE(expect_fixed_eq(cordic_log(x), fixed64(std::log(xd))));
+            EXPECT_TRUE(expect_fixed_eq(cordic_sqrt(x), fixed64(std::sqrt(xd))));
+        }
+    }
+    EXPECT_THROW(cordic_log(0_f64), std::domain_error);
+    EXPECT_THROW(cordic_sqrt(-1_f64), std::domain_error);
+}
+
+TEST(Fixed64, FastLog2)
+{
+    EXPECT_EQ(fast_log2(1_f64), 0_f64);
+    EXPECT_EQ(fast_log2(1024_f64), 10_f64);
+    EXPECT_EQ(fast_log2(0.125_f64), -3_f64);
+    EXPECT_THROW(fast_log2(0_f64), std::domain_error);
+    EXPECT_THROW(fast_log2(-1_f64), std::domain_error);
+
+    // the final rounding is the only visible error.
+    const auto max_error = std::ldexp(0.51L, -32);
+    for(uint64_t raw = 1; raw <= static_cast<uint64_t>(std::numeric_limits<decltype(fixed64().internal_value())>::max()); raw += 12345 + raw / 1000)
+    {
+        auto x = fixed64::from_internal_value(static_cast<int64_t>(raw));
+        long double expected = std::log2(static_cast<long double>(raw)) - 32;
+        long double actual = std::ldexp(static_cast<long double>(fast_log2(x).internal_value()), -32);
+        EXPECT_LE(std::fabs(actual - expected), max_error) << "raw value: " << raw;
+    }
+}
+
+TEST(Fixed64, Exp2)
+{
+    EXPECT_EQ(exp2(0_f64), 1_f64);
+    EXPECT_EQ(exp2(10_f64), 1024_f64);
+    EXPECT_EQ(exp2(-3_f64), 0.125_f64);
+    EXPECT_EQ(exp(100_f64), max_value<fixed64>());
+    EXPECT_EQ(exp(-100_f64), 0_f64);
+    EXPECT_EQ(pow(2_f64, 3_f64), 8_f64);
+    EXPECT_EQ(pow(-2_f64, 3_f64), -8_f64);
+    EXPECT_EQ(pow(0_f64, 0_f64), 1_f64);
+    EXPECT_EQ(pow(0_f64, 2.5_f64), 0_f64);
+    EXPECT_THROW(pow(-2_f64, 0.5_f64), std::domain_error);
+
+    // half an ulp of the final rounding plus a relative error of the mantissa.
+    const auto ulp = std::ldexp(1.0L, -32);
+    const auto relative = std::ldexp(1.0L, -59);
+    for(auto v = -23_f64; v < 15_f64; v += 0.0007_f64)
+    {
+        long double x = std::ldexp(static_cast<long double>(v.internal_value()), -32);
+        long double expected = std::exp(x);
+        long double actual = std::ldexp(static_cast<long double>(exp(v).internal_value()), -32);
+        EXPECT_LE(std::fabs(actual - expected), ulp / 2 + expected * relative) << "x: " << v;
+        expected = std::exp2(x);
+        actual = std::ldexp(static_cast<long double>(exp2(v).internal_value()), -32);
+        EXPECT_LE(std::fabs(actual - expected), ulp / 2 + expected * relative) << "x: " << v;
+        if(v > 0_f64)
+        {
+            expected = std::pow(x, 1.5L);
+            actual = std::ldexp(static_cast<long double>(pow(v, 1.5_f64).internal_value()), -32);
+            EXPECT_LE(std::fabs(actual - expected), ulp + expected * relative * 4) << "x: " << v;
+        }
+    }
+
+    // the top bin, where the mantissa is already at the fraction bits and takes no rounding shift.
+    static_assert(exp2(30_f64) == fixed64(1 << 30));
+    for(auto v : {30_f64, 30.5_f64, 30.999_f64})
+    {
+        long double expected = std::exp2(std::ldexp(static_cast<long double>(v.internal_value()), -32));
+        long double actual = std::ldexp(static_cast<long double>(exp2(v).internal_value()), -32);
+        EXPECT_LE(std::fabs(actual - expected), ulp / 2 + expected * relative) << "x: " << v;
+    }
+    for(auto v : {21_f64, 21.2_f64, 21.48_f64})
+    {
+        long double expected = std::exp(std::ldexp(static_cast<long double>(v.internal_value()), -32));
+        long double actual = std::ldexp(static_cast<long double>(exp(v).internal_value()), -32);
+        EXPECT_LE(std::fabs(actual - expected), ulp / 2 + expected * relative) << "x: " << v;
+    }
+    EXPECT_EQ(exp2(31_f64), max_value<fixed64>());
+}
+
+TEST(Fixed64, Minimax)
+{
+    // each format takes the lowest degree polynomial which meets its half ulp.
+    constexpr auto poly = detail::minimax_select(detail::minimax_sin_quarter, 33);
+    static_assert(poly.error_bits >= 33);
+
+    const auto ulp = std::ldexp(1.0L, -32);
+    for(auto v = 0_f64; v <= 1_f64; v += 0.0001_f64)
+    {
+        long double x = std::ldexp(static_cast<long double>(v.internal_value()), -32);
+        long double actual = std::ldexp(static_cast<long double>(detail::sin_quarter(v).internal_value()), -32);
+        EXPECT_LE(std::fabs(actual - std::sin(x * std::numbers::pi_v<long double> / 2)), ulp) << "x: " << v;
+        actual = std::ldexp(static_cast<long double>(detail::atan_unit(v).internal_value()), -32);
+        EXPECT_LE(std::fabs(actual - std::atan(x)), ulp) << "x: " << v;
+    }
+    for(auto v = -100_f64; v <= 100_f64; v += 0.37_f64)
+    {
+        long double x = std::ldexp(static_cast<long double>(v.internal_value()), -32);
+        long double actual = std::ldexp(static_cast<long double>(atan(v).internal_value()), -32);
+        EXPECT_LE(std::fabs(actual - std::atan(x)), ulp * 2) << "x: " << v;
+    }
+}
+
+TEST(Fixed64, PolyEval)
+{
+    static_assert(poly_eval<3_f64>(2_f64) == 3_f64);
+    static_assert(poly_eval<1_f64, 2_f64, 3_f64>(2_f64) == 17_f64);
+    static_assert(poly_eval<poly_scheme::horner, 1_f64, 2_f64, 3_f64, 4_f64>(-2_f64) == -23_f64);
+
+    // each product truncates, so the two schemes only differ by a few ulp.
+    const auto max_error = std::ldexp(8.0L, -32);
+    for(auto v = -1_f64; v <= 1_f64; v += 0.001_f64)
+    {
+        auto horner = poly_eval<poly_scheme::horner, 1_f64, 1_f64, 0.5_f64, fixed64(1.0 / 6), fixed64(1.0 / 24), fixed64(1.0 / 120)>(v);
+        auto estrin = poly_eval<1_f64, 1_f64, 0.5_f64, fixed64(1.0 / 6), fixed64(1.0 / 24), fixed64(1.0 / 120)>(v);
+        long double x = std::ldexp(static_cast<long double>(v.internal_value()), -32);
+        long double expected = 1 + x + x * x / 2 + x * x * x / 6 + x * x * x * x / 24 + x * x * x * x * x / 120;
+        EXPECT_LE(std::fabs(std::ldexp(static_cast<long double>(horner.internal_value()), -32) - expected), max_error) << "x: " << v;
+        EXPECT_LE(std::fabs(std::ldexp(static_cast<long double>(estrin.internal_value()), -32) - expected), max_error) << "x: " << v;
+    }
+}
+
+TEST(Fixed64, Vec)
+{
+    using test_math::expect_fixed_eq;
+
+    constexpr vec3<fixed64> a{1_f64, 2_f64, 3_f64};
+    constexpr vec3<fixed64> b{4_f64, -5_f64, 6_f64};
+    static_assert(dot(a, b) == 12_f64);
+    static_assert(cross(a, b) == vec3<fixed64>{27_f64, 6_f64, -13_f64});
+    static_assert(cross(vec2<fixed64>{1_f64, 2_f64}, vec2<fixed64>{3_f64, 4_f64}) == -2_f64);
+    static_assert(a + b - b == a);
+    static_assert(-a * 2_f64 == vec3<fixed64>{-2_f64, -4_f64, -6_f64});
+    EXPECT_EQ(lerp(a, b, 0.5_f64), (vec3<fixed64>{2.5_f64, -1.5_f64, 4.5_f64}));
+    EXPECT_TRUE(expect_fixed_eq(length(vec3<fixed64>{2_f64, 3_f64, 6_f64}), 7_f64));
+    EXPECT_EQ(normalize(vec3<fixed64>{}), vec3<fixed64>{});
+
+    // the squared lengths above the max value are summed in the intermediate type.
+    static_assert(length(vec3<fixed64>{50000_f64, 0_f64, 0_f64}) == 50000_f64);
+    static_assert(normalize(vec3<fixed64>{50000_f64, 0_f64, 0_f64}) == vec3<fixed64>{1_f64, 0_f64, 0_f64});
+    EXPECT_EQ(distance(vec2<fixed64>{-50000_f64, 0_f64}, vec2<fixed64>{50000_f64, 0_f64}), 2 * 50000_f64);
+    EXPECT_TRUE(expect_fixed_eq(length(vec3<fixed64>{1000000000_f64, -1000000000_f64, 1000000000_f64}), 1732050807.568877293_f64));
+    EXPECT_EQ(length(vec4<fixed64>{min_value<fixed64>(), min_value<fixed64>(), min_value<fixed64>(), min_value<fixed64>()}), max_value<fixed64>());
+    const auto diagonal = normalize(vec4<fixed64>{min_value<fixed64>(), min_value<fixed64>(), min_value<fixed64>(), min_value<fixed64>()});
+    EXPECT_TRUE(expect_fixed_eq(diagonal.x, -0.5_f64));
+    EXPECT_TRUE(expect_fixed_eq(length(normalize(vec3<fixed64>{1000000000_f64, 50000_f64, -3_f64})), 1_f64));
+
+    // the products are summed before a single shift, so the dot product is the exact sum floored once.
+    // the components are small enough for the dot products not to overflow.
+    eirin::mt19937_64 rng(114514u);
+    const auto random = [&rng]
+    { return fixed64::from_internal_value(static_cast<decltype(fixed64().internal_value())>(static_cast<int64_t>(rng()) >> 17)); };
+    for(int i = 0; i < 1000; ++i)
+    {
+        vec4<fixed64> u{random(), random(), random(), random()};
+        vec4<fixed64> v{random(), random(), random(), random()};
+        long double expected = 0;
+        for(size_t j = 0; j < 4; ++j)
+            expected += std::ldexp(static_cast<long double>(u[j].internal_value()), -32) * std::ldexp(static_cast<long double>(v[j].internal_value()), -32);
+        auto actual = std::ldexp(static_cast<long double>(dot(u, v).internal_value()), -32);
+        EXPECT_LE(std::fabs(actual - expected), std::ldexp(1.0L, -32)) << "u.x: " << u.x << ", v.x: " << v.x;
+        EXPECT_EQ(u + v - v, u);
+
+        vec3<fixed64> w{u.x, u.y, u.z};
+        if(length(w) > 0.01_f64)
+        {
+            EXPECT_TRUE(expect_fixed_eq(length(normalize(w)), 1_f64, 0.001_f64));
+        }
+    }
+}
+
+TEST(Fixed64, SoaVec3)
+{
+    eirin::mt19937_64 rng(1919810u);
+    const auto random = [&rng]
+    { return fixed64::from_internal_value(static_cast<decltype(fixed64().internal_value())>(static_cast<int64_t>(rng()) >> 17)); };
+
+    // an odd size to cover the scalar tails of the SIMD loops.
+    soa_vec3<fixed64> a, b;
+    for(int i = 0; i < 1027; ++i)
+    {
+        a.push_back({random(), random(), random()});
+        b.push_back({random(), random(), random()});
+    }
+    EXPECT_EQ(static_cast<size_t>(a.end() - a.begin()), a.size());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a.xs().data()) % soa_vec3<fixed64>::alignment, 0u);
+
+    soa_vec3<fixed64> sum(a.size()), scaled(a.size()), unit(a.size()), step(a.size());
+    std::vector<fixed64> dots(a.size());
+    add(sum, a, b);
+    scale(scaled, a, 0.75_f64);
+    add_scaled(step, a, b, 0.01_f64);
+    dot(std::span<fixed64>(dots), a, b);
+    normalize(unit, a);
+    for(size_t i = 0; i < a.size(); ++i)
+    {
+        vec3<fixed64> u = a[i], v = b[i];
+        EXPECT_EQ(static_cast<vec3<fixed64>>(sum[i]), u + v);
+        EXPECT_EQ(static_cast<vec3<fixed64>>(scaled[i]), u * 0.75_f64);
+        EXPECT_EQ(static_cast<vec3<fixed64>>(step[i]), u + v * 0.01_f64);
+        EXPECT_EQ(dots[i], dot(u, v));
+        EXPECT_EQ(static_cast<vec3<fixed64>>(unit[i]), normalize(u));
+    }
+
+    // normalized in place block by block.
+    soa_vec3<fixed64> in_place = a;
+    normalize(in_place, in_place);
+    for(size_t i = 0; i < a.size(); ++i)
+        EXPECT_EQ(static_cast<vec3<fixed64>>(in_place[i]), static_cast<vec3<fixed64>>(unit[i]));
+
+    // the squared lengths of long vectors are summed in the intermediate type and do not wrap.
+    soa_vec3<fixed64> long_vecs{{50000_f64, 0_f64, 0_f64}};
+    for(int i = 0; i < 16; ++i)
+        long_vecs.push_back({fixed64::from_internal_value(static_cast<decltype(fixed64().internal_value())>(static_cast<int64_t>(rng()) >> 1)), random(), random()});
+    soa_vec3<fixed64> long_units(long_vecs.size());
+    normalize(long_units, long_vecs);
+    EXPECT_EQ(static_cast<vec3<fixed64>>(long_units[0]), (vec3<fixed64>{1_f64, 0_f64, 0_f64}));
+    for(size_t i = 0; i < long_vecs.size(); ++i)
+    {
+        EXPECT_EQ(static_cast<vec3<fixed64>>(long_units[i]), normalize(static_cast<vec3<fixed64>>(long_vecs[i])));
+        EXPECT_TRUE(test_math::expect_fixed_eq(length(static_cast<vec3<fixed64>>(long_units[i])), 1_f64, 0.001_f64));
+    }
+
+    // the proxy references write through to the columns.
+    const vec3<fixed64> third = a[3];
+    for(auto v : a)
+        v = static_cast<vec3<fixed64>>(v) * 2_f64;
+    EXPECT_EQ(static_cast<vec3<fixed64>>(a[3]), third * 2_f64);
+    a[0] = b[0];
+    EXPECT_EQ(static_cast<vec3<fixed64>>(a[0]), static_cast<vec3<fixed64>>(b[0]));
+}
+
+TEST(Fixed64, Matrix)
+{
+    constexpr matrix<fixed64, 2, 3> a{{1_f64, 2_f64, 3_f64, 4_f64, 5_f64, 6_f64}};
+    constexpr matrix<fixed64, 3, 2> b{{7_f64, 8_f64, 9_f64, 10_f64, 11_f64, 12_f64}};
+    static_assert(a * b == matrix<fixed64, 2, 2>{{58_f64, 64_f64, 139_f64, 154_f64}});
+    static_assert(transpose(transpose(a)) == a);
+    static_assert(matrix<fixed64, 3, 3>::identity() * vec3<fixed64>{1_f64, 2_f64, 3_f64} == vec3<fixed64>{1_f64, 2_f64, 3_f64});
+    EXPECT_EQ(a + a, a * 2_f64);
+    EXPECT_EQ(a - a, (matrix<fixed64, 2, 3>{}));
+    EXPECT_EQ(transpose(a)(2, 1), 6_f64);
+
+    eirin::mt19937_64 rng(1919810u);
+    const auto random = [&rng]
+    { return fixed64::from_internal_value(static_cast<decltype(fixed64().internal_value())>(static_cast<int64_t>(rng()) >> 17)); };
+    // odd sizes to cover the edge tiles and the scalar tails.
+    dense_matrix<fixed64> x(37, 53), y(53, 29);
+    for(size_t i = 0; i < x.rows(); ++i)
+        for(auto& v : x.row(i))
+            v = random();
+    for(size_t i = 0; i < y.rows(); ++i)
+        for(auto& v : y.row(i))
+            v = random();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(x.data()) % dense_matrix<fixed64>::alignment, 0u);
+
+    const auto product = multiply(x, y, 1);
+    ASSERT_EQ(product.rows(), 37u);
+    ASSERT_EQ(product.cols(), 29u);
+    for(size_t i = 0; i < product.rows(); ++i)
+        for(size_t j = 0; j < product.cols(); ++j)
+        {
+            auto sum = eirin::detail::wide_product(x(i, 0), y(0, j));
+            for(size_t k = 1; k < x.cols(); ++k)
+                sum += eirin::detail::wide_product(x(i, k), y(k, j));
+            EXPECT_EQ(product(i, j), (eirin::detail::narrow_product<int64_t, eirin::detail::int128_t, 32, false>(sum)));
+        }
+    // the result is bit-identical for any number of threads.
+    EXPECT_EQ(multiply(x, y, 2), product);
+    EXPECT_EQ(multiply(x, y, 3), product);
+    EXPECT_EQ(x * y, product);
+    // the products above the minimum work per thread are split among the threads.
+    dense_matrix<fixed64> wide_x(97, 101), wide_y(101, 95);
+    for(auto* m : {&wide_x, &wide_y})
+        for(size_t i = 0; i < m->rows(); ++i)
+            for(auto& v : m->row(i))
+                v = random();
+    EXPECT_EQ(multiply(wide_x, wide_y, 3), multiply(wide_x, wide_y, 1));
+#    ifndef EIRIN_NO_EXCEPTIONS
+    EXPECT_THROW(multiply(x, x), std::invalid_argument);
+#    endif
+}
+
+TEST(Fixed64, Rsqrt)
+{
+    EXPECT_EQ(rsqrt(4_f64), 0.5_f64);
+    EXPECT_EQ(rsqrt(1_f64 / 4), 2_f64);
+    EXPECT_EQ(rsqrt(1_f64), 1_f64);
+    eirin::mt19937_64 rng(1919810u);
+    for(int i = 0; i < 100000; ++i)
+    {
+        // raw values spread over all magnitudes.
+        const auto raw = static_cast<decltype(fixed64().internal_value())>(rng() >> (rng() % 63 + 1));
+        if(raw <= 0)
+            continue;
+        const long double expected = 1.0L / std::sqrt(std::ldexp(static_cast<long double>(raw), -32));
+        const long double actual = std::ldexp(static_cast<long double>(rsqrt(fixed64::from_internal_value(raw)).internal_value()), -32);
+        EXPECT_LE(std::fabs(actual - expected), std::ldexp(0.5L + 1e-6L, -32)) << raw;
+    }
+#    ifndef EIRIN_NO_EXCEPTIONS
+    EXPECT_THROW(rsqrt(0_f64), std::domain_error);
+    EXPECT_THROW(rsqrt(-1_f64), std::domain_error);
+#    endif
+}
+
+TEST(Fixed64, Quaternion)
+{
+    using test_math::expect_fixed_eq;
+    using quat = quaternion<fixed64>;
+    constexpr quat i{1_f64, 0_f64, 0_f64, 0_f64}, j{0_f64, 1_f64, 0_f64, 0_f64}, k{0_f64, 0_f64, 1_f64, 0_f64};
+    static_assert(i * j == k && j * k == i && k * i == j);
+    static_assert(i * i == -quat::identity());
+    static_assert(conjugate(i) * i == quat::identity());
+
+    const auto pi = numbers::pi_v<fixed64>();
+    const vec3<fixed64> z_axis{0_f64, 0_f64, 1_f64};
+    const auto quarter = from_axis_angle(z_axis, pi / 2);
+    const auto turned = rotate(quarter, vec3<fixed64>{2_f64, 0_f64, 0_f64});
+    EXPECT_TRUE(expect_fixed_eq(turned.x, 0_f64));
+    EXPECT_TRUE(expect_fixed_eq(turned.y, 2_f64));
+    EXPECT_TRUE(expect_fixed_eq(turned.z, 0_f64));
+    EXPECT_TRUE(expect_fixed_eq(dot(quarter * conjugate(quarter), quat::identity()), 1_f64));
+
+    const quat skewed{1_f64, 2_f64, 3_f64, 4_f64};
+    EXPECT_TRUE(expect_fixed_eq(length(normalize(skewed)), 1_f64));
+    EXPECT_EQ(normalize(quat{}), quat{});
+
+    // the squared lengths above the max value are summed in the intermediate type.
+    static_assert(length(quat{50000_f64, 0_f64, 0_f64, 0_f64}) == 50000_f64);
+    static_assert(normalize(quat{50000_f64, 0_f64, 0_f64, 0_f64}) == quat{1_f64, 0_f64, 0_f64, 0_f64});
+    const quat long_skewed{50000_f64, -2 * 50000_f64, 3 * 50000_f64, 4 * 50000_f64};
+    EXPECT_TRUE(expect_fixed_eq(length(long_skewed), 50000_f64 * sqrt(30_f64), 50000_f64 * fixed64::nearly_compare_epsilon()));
+    for(size_t c = 0; c < 4; ++c)
+    {
+        EXPECT_TRUE(expect_fixed_eq(normalize(long_skewed)[c], normalize(skewed)[c] * (c == 1 ? -1 : 1)));
+    }
+
+    // slerp halfway to a quarter turn is an eighth turn, and the ends are the inputs.
+    const auto eighth = from_axis_angle(z_axis, pi / 4);
+    const auto half = slerp(quat::identity(), quarter, 1_f64 / 2);
+    for(size_t c = 0; c < 4; ++c)
+    {
+        EXPECT_TRUE(expect_fixed_eq(half[c], eighth[c], 0.001_f64));
+        EXPECT_TRUE(expect_fixed_eq(slerp(quat::identity(), quarter, 1_f64)[c], quarter[c], 0.001_f64));
+        EXPECT_TRUE(expect_fixed_eq(slerp(quarter, -eighth, 0_f64)[c], quarter[c], 0.001_f64));
+    }
+
+    // the batched rotations are bit-identical to the single one, an odd size covers the scalar tail.
+    eirin::mt19937_64 rng(114514u);
+    const auto random = [&rng]
+    { return fixed64::from_internal_value(static_cast<decltype(fixed64().internal_value())>(static_cast<int64_t>(rng()) >> 17)); };
+    const auto q = normalize(quat{random(), random(), random(), random()});
+    std::vector<vec3<fixed64>> vs(1027);
+    soa_vec3<fixed64> soa;
+    for(auto& v : vs)
+    {
+        v = vec3<fixed64>{random(), random(), random()};
+        soa.push_back(v);
+    }
+    auto rotated = vs;
+    rotate(q, std::span<vec3<fixed64>>(rotated));
+    rotate(soa, soa, q);
+    for(size_t n = 0; n < vs.size(); ++n)
+    {
+        EXPECT_EQ(rotated[n], rotate(q, vs[n]));
+        EXPECT_EQ(static_cast<vec3<fixed64>>(soa[n]), rotated[n]);
+    }
+    // rotations keep the length, and compose like the product.
+    EXPECT_TRUE(expect_fixed_eq(length(rotated[5]), length(vs[5]), 0.01_f64));
+    const auto twice = rotate(q * quarter, vs[7]);
+    const auto stepwise = rotate(q, rotate(quarter, vs[7]));
+    for(size_t c = 0; c < 3; ++c)
+    {
+        EXPECT_TRUE(expect_fixed_eq(twice[c], stepwise[c], 0.01_f64));
+    }
+}
+
+TEST(Fixed64, Fft)
+{
+    using test_math::expect_fixed_eq;
+    using cfx = dsp::complex<fixed64>;
+    static_assert(cfx{0_f64, 1_f64} * cfx{0_f64, 1_f64} == cfx{-1_f64, 0_f64});
+    static_assert(conj(cfx{1_f64, 2_f64}) * cfx{0_f64, 1_f64} == cfx{2_f64, 1_f64});
+
+    std::mt19937_64 rng(114514u);
+    const auto random = [&rng] { return fixed64::from_internal_value(static_cast<int64_t>(rng()) >> 32); };
+    for(size_t n : {2u, 16u, 512u, 2048u})
+    {
+        std::vector<cfx> data(n);
+        for(auto& c : data)
+            c = {random(), random()};
+        const auto input = data;
+        const dsp::fft_plan<fixed64> plan(n);
+        plan.forward(data);
+        EXPECT_LE(test_math::fft_max_error(input, data), 4.0L) << n;
+        plan.inverse(data);
+        const auto eps = fixed64::from_internal_value(static_cast<int64_t>(8 * std::sqrt(n)));
+        for(size_t k = 0; k < n; ++k)
+        {
+            EXPECT_TRUE(expect_fixed_eq(data[k].re, input[k].re, eps));
+            EXPECT_TRUE(expect_fixed_eq(data[k].im, input[k].im, eps));
+        }
+    }
+
+    // the twiddles between the coarse steps of the largest size.
+    std::vector<cfx> tone(dsp::fft_plan<fixed64>::max_size);
+    for(size_t k = 0; k < tone.size(); ++k)
+    {
+        const auto [s, c] = sincos(numbers::pi_v<fixed64>() * fixed64(static_cast<int>(k % 4096)) / 2048);
+        tone[k] = {c / 2, s / 2};
+    }
+    dsp::fft(std::span<cfx>(tone));
+    for(size_t k = 0; k < tone.size(); ++k)
+    {
+        EXPECT_TRUE(expect_fixed_eq(tone[k].re, k == 256 ? 0.5_f64 : 0_f64, 0.000001_f64)) << k;
+        EXPECT_TRUE(expect_fixed_eq(tone[k].im, 0_f64, 0.000001_f64)) << k;
+    }
+#    ifndef EIRIN_NO_EXCEPTIONS
+    EXPECT_THROW(dsp::fft_plan<fixed64>(1), std::invalid_argument);
+    EXPECT_THROW(dsp::fft_plan<fixed64>(8).inverse(std::span<cfx>(tone)), std::invalid_argument);
+#    endif
+}
+
+TEST(Fixed64, Filter)
+{
+    constexpr auto impulse = []
+    {
+        dsp::fir_filter<fixed64, 3> fir({1_f64 / 4, 1_f64 / 2, 1_f64 / 4});
+        std::array<fixed64, 4> res{};
+        for(size_t n = 0; n < res.size(); ++n)
+            res[n] = fir.process(n == 0 ? 1_f64 : 0_f64);
+        return res;
+    }();
+    static_assert(impulse == std::array<fixed64, 4>{1_f64 / 4, 1_f64 / 2, 1_f64 / 4, 0_f64});
+
+    std::mt19937_64 rng(114514u);
+    const auto random = [&rng] { return fixed64::from_internal_value(static_cast<int64_t>(rng()) >> 30); };
+    std::array<fixed64, 5> taps;
+    for(auto& c : taps)
+        c = random() / 4;
+    std::vector<fixed64> input(600), output(input.size());
+    for(auto& x : input)
+        x = random();
+    dsp::fir_filter<fixed64, taps.size()> fir(taps);
+    fir.process(std::span<const fixed64>(input).first(100), std::span<fixed64>(output).first(100));
+    fir.process(std::span<const fixed64>(input).subspan(100), std::span<fixed64>(output).subspan(100));
+    for(size_t n = 0; n < input.size(); ++n)
+    {
+        fixed64 sum = 0_f64;
+        for(size_t k = 0; k < taps.size() && k <= n; ++k)
+            sum += taps[k] * input[n - k];
+        EXPECT_TRUE(test_math::expect_fixed_eq(output[n], sum, fixed64::from_internal_value(int64_t(taps.size())))) << n;
+    }
+
+    const dsp::biquad_coefficients<fixed64> low_pass{1_f64 / 16, 1_f64 / 8, 1_f64 / 16, -1_f64, 1_f64 / 4};
+    dsp::iir_filter<fixed64> step(low_pass, 2);
+    std::vector<fixed64> ones(400, 1_f64), settled(ones.size());
+    step.process(ones, settled);
+    EXPECT_TRUE(test_math::expect_fixed_eq(settled[settled.size() - 2], 1_f64, 0.000001_f64));
+    EXPECT_EQ(settled[settled.size() - 2], settled.back());
+#    ifndef EIRIN_NO_EXCEPTIONS
+    EXPECT_THROW(step.process(std::span<const fixed64>(input).first(3), std::span<fixed64>(output).first(3)), std::invalid_argument);
+#    endif
+}
+
+TEST(Fixed64, Policy)
+{
+    static_assert(sin<policy::lut<256>>(0_f64) == 0_f64 && cos<policy::lut<256>>(0_f64) == 1_f64);
+    for(auto x : {-100_f64, -1_f64, 0_f64, 0.5_f64, 3_f64, 1000_f64})
+    {
+        EXPECT_EQ(sin<policy::precise>(x), sin(x));
+        EXPECT_EQ(exp<policy::fast>(x / 100), exp(x / 100));
+        EXPECT_EQ(sincos<policy::lut<>>(x).second, cos<policy::lut<>>(x));
+    }
+
+    const auto max_ulp = [](auto func, long double (*ref)(long double), fixed64 lo, fixed64 hi)
+    { return perf::measure_error(lo, hi, 20001, func, ref, 1).max_ulp; };
+    const auto sin_ref = [](long double x) { return std::sin(x); };
+    const auto log_ref = [](long double x) { return std::log(x); };
+    const auto log10_ref = [](long double x) { return std::log10(x); };
+    EXPECT_LE(max_ulp([](fixed64 x) { return sin<policy::precise>(x); }, sin_ref, -100_f64, 100_f64), 4);
+    // 2^-20 and 2^-22 of fixed64, in ULPs.
+    EXPECT_LE(max_ulp([](fixed64 x) { return sin<policy::fast>(x); }, sin_ref, -100_f64, 100_f64), 4096);
+    EXPECT_LE(max_ulp([](fixed64 x) { return sin<policy::lut<>>(x); }, sin_ref, -100_f64, 100_f64), 1024 + 512);
+    EXPECT_LE(max_ulp([](fixed64 x) { return sin<policy::cordic>(x); }, sin_ref, -100_f64, 100_f64), 32);
+    EXPECT_LE(max_ulp([](fixed64 x) { return log<policy::precise>(x); }, log_ref, 0.01_f64, 10000_f64), 0.51);
+    EXPECT_LE(max_ulp([](fixed64 x) { return log10<policy::precise>(x); }, log10_ref, 0.01_f64, 10000_f64), 0.51);
+    EXPECT_LE(max_ulp([](fixed64 x) { return log10<policy::cordic>(x); }, log10_ref, 0.01_f64, 10000_f64), 1);
+
+    EXPECT_EQ(exp2<policy::fast>(10.5_f64), exp2(10.5_f64));
+    EXPECT_EQ(asin<policy::cordic>(0.5_f64), asin(0.5_f64));
+    const auto sinh_ref = [](long double x) { return std::sinh(x); };
+    const auto cosh_ref = [](long double x) { return std::cosh(x); };
+    const auto tanh_ref = [](long double x) { return std::tanh(x); };
+    EXPECT_LE(max_ulp([](fixed64 x) { return sinh<policy::precise>(x); }, sinh_ref, -8_f64, 8_f64), 1.5);
+    EXPECT_LE(max_ulp([](fixed64 x) { return cosh<policy::precise>(x); }, cosh_ref, -8_f64, 8_f64), 1.5);
+    EXPECT_LE(max_ulp([](fixed64 x) { return tanh<policy::precise>(x); }, tanh_ref, -40_f64, 40_f64), 0.51);
+}
+
+TEST(Fixed64, Convert)
+{
+    using rounded64 = fixed_num<int64_t, detail::int128_t, 32, true>;
+    static_assert(static_cast<double>(1.5_f64) == 1.5 && fixed64(-0.5).internal_value() == -(int64_t(1) << 31));
+    static_assert(fixed64(0x1.8p-32).internal_value() == 1 && rounded64(0x1.8p-32).internal_value() == 2);
+    // the raw value is rounded to the nearest double before the exact scaling.
+    EXPECT_EQ(static_cast<double>(fixed64::from_internal_value(std::numeric_limits<int64_t>::max())), 0x1p31);
+
+    // the magnitudes above 2^19 take the slow path of the AVX2 conversion from double.
+    std::mt19937_64 rng(114514u);
+    std::vector<fixed64> fixed_values(1003), converted(fixed_values.size());
+    std::vector<rounded64> rounded(fixed_values.size());
+    std::vector<double> doubles(fixed_values.size()), back(fixed_values.size());
+    for(size_t i = 0; i < fixed_values.size(); ++i)
+    {
+        fixed_values[i] = fixed64::from_internal_value(static_cast<int64_t>(rng()) >> (i % 64));
+        const double x = std::ldexp(static_cast<double>(static_cast<int64_t>(rng())), -33 - static_cast<int>(i % 24));
+        doubles[i] = i % 3 == 0 ? std::ldexp(std::round(std::ldexp(x, 33)), -33) : x;
+    }
+    to_double(fixed_values, back);
+    from_double(doubles, converted);
+    from_floating(std::span<const double>(doubles), std::span<rounded64>(rounded));
+    for(size_t i = 0; i < fixed_values.size(); ++i)
+    {
+        EXPECT_EQ(back[i], static_cast<double>(fixed_values[i])) << i;
+        EXPECT_EQ(converted[i], fixed64(doubles[i])) << doubles[i];
+        EXPECT_EQ(rounded[i], rounded64(doubles[i])) << doubles[i];
+    }
+#    ifndef EIRIN_NO_EXCEPTIONS
+    EXPECT_THROW(from_double(std::span<const double>(doubles).first(5), converted), std::invalid_argument);
+#    endif
+}
+
+TEST(Fixed64, ConvertFormat)
+{
+    // the raw value of fixed32 is widened before the shift.
+    static_assert(fixed64(-3.25_f32) == -3.25_f64 && fixed64(32767_f32) == 32767_f64);
+    static_assert(fixed32(-3.25_f64) == -3.25_f32);
+    static_assert(convert_saturate<fixed32>(40000_f64).internal_value() == std::numeric_limits<int32_t>::max());
+    static_assert(convert_saturate<fixed32>(-40000_f64).internal_value() == std::numeric_limits<int32_t>::min());
+    static_assert(convert_saturate<fixed64>(-3.25_f32) == -3.25_f64);
+
+    std::mt19937_64 rng(114514u);
+    std::vector<fixed64> values(1003), widened(values.size());
+    std::vector<fixed32> wrapped(values.size()), saturated(values.size());
+    for(auto& x : values)
+        x = fixed64::from_internal_value(static_cast<int64_t>(rng()) >> (rng() % 64));
+    values[0] = fixed64::from_internal_value(std::numeric_limits<int64_t>::min());
+    convert(std::span<const fixed64>(values), std::span<fixed32>(wrapped));
+    convert_saturate(std::span<const fixed64>(values), std::span<fixed32>(saturated));
+    convert(std::span<const fixed32>(saturated), std::span<fixed64>(widened));
+    for(size_t i = 0; i < values.size(); ++i)
+    {
+        EXPECT_EQ(wrapped[i], fixed32(values[i])) << values[i];
+        EXPECT_EQ(saturated[i], convert_saturate<fixed32>(values[i])) << values[i];
+        EXPECT_EQ(widened[i], fixed64(saturated[i])) << values[i];
+        // the saturated value is the nearest fixed32 toward zero, abs of the min value overflows.
+        if(i == 0)
+            continue;
+        EXPECT_LE(abs(widened[i]), abs(values[i])) << values[i];
+        if(abs(values[i]) < 32767_f64)
+        {
+            EXPECT_LT(abs(values[i] - widened[i]), fixed64(fixed32::from_internal_value(1))) << values[i];
+        }
+    }
+}
+
+TEST(Fixed64, Sort)
+{
+    std::mt19937_64 rng(114514u);
+    std::vector<fixed64> keys((size_t(1) << 17) + 5);
+    std::vector<uint32_t> order(keys.size());
+    for(size_t i = 0; i < keys.size(); ++i)
+    {
+        keys[i] = fixed64::from_internal_value(static_cast<int64_t>(rng()) >> (rng() % 64));
+        order[i] = static_cast<uint32_t>(i);
+    }
+    keys[7] = fixed64::from_internal_value(std::numeric_limits<int64_t>::min());
+    keys[8] = fixed64::from_internal_value(std::numeric_limits<int64_t>::max());
+    auto expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    auto sorted = keys;
+    radix_sort(std::span<fixed64>(sorted));
+    EXPECT_EQ(sorted, expected);
+    sorted = keys;
+    parallel_radix_sort(std::span<fixed64>(sorted), 4);
+    EXPECT_EQ(sorted, expected);
+
+    sorted = keys;
+    auto values = order;
+    radix_sort(std::span<fixed64>(sorted), std::span<uint32_t>(values));
+    EXPECT_EQ(sorted, expected);
+    for(size_t i = 0; i < keys.size(); ++i)
+        EXPECT_EQ(keys[values[i]], sorted[i]);
+
+    // prices share their high bytes, which are skipped, and the partition uses the highest byte which differs.
+    std::uniform_int_distribution<int64_t> cents(1, 3000000);
+    for(auto& x : keys)
+        x = fixed64(cents(rng)) / 100_f64;
+    expected = keys;
+    std::sort(expected.begin(), expected.end());
+    sorted = keys;
+    values = order;
+    parallel_radix_sort(std::span<fixed64>(sorted), std::span<uint32_t>(values), 4);
+    EXPECT_EQ(sorted, expected);
+    for(size_t i = 1; i < keys.size(); ++i)
+    {
+        if(sorted[i] == sorted[i - 1])
+        {
+            EXPECT_LT(values[i - 1], values[i]);
+        }
+    }
+}
+
+TEST(Fixed64, Search)
+{
+    std::mt19937_64 rng(114514u);
+    std::vector<fixed64> data(1003);
+    for(auto& x : data)
+        x = fixed64::from_internal_value(static_cast<int64_t>(rng() % 4000) - 2000);
+    radix_sort(std::span<fixed64>(data));
+    for(size_t n : {size_t(0), size_t(1), size_t(7), size_t(16), size_t(37), data.size()})
+    {
+        const std::span<const fixed64> sorted(data.data(), n);
+        for(int64_t raw = -2010; raw <= 2010; raw += 3)
+        {
+            const auto value = fixed64::from_internal_value(raw);
+            const auto expected = static_cast<size_t>(std::lower_bound(sorted.begin(), sorted.end(), value) - sorted.begin());
+            EXPECT_EQ(lower_bound(sorted, value), expected) << n << ' ' << raw;
+            EXPECT_EQ(linear_search(sorted, value), expected) << n << ' ' << raw;
+        }
+    }
+}
+
+TEST(Fixed64, Angle)
+{
+    static_assert(sin<fixed64>(angle<64>::quarter_turn()) == 1_f64 && cos<fixed64>(angle<64>::half_turn()) == -1_f64);
+    static_assert(angle<32>::from_radians(numbers::pi_v<fixed64>()) == angle<32>::half_turn());
+    static_assert(angle<32>::atan2(-1_f64, 0_f64) == -angle<32>::quarter_turn());
+
+    std::mt19937_64 rng(114514u);
+    for(int i = 0; i < 1000; ++i)
+    {
+        const auto a = angle<64>::from_internal_value(rng());
+        const long double theta = std::ldexp(static_cast<long double>(a.internal_value()), -64) * 2 * std::numbers::pi_v<long double>;
+        const auto [s, c] = sincos<fixed64>(a);
+        EXPECT_LE(std::abs(std::ldexp(static_cast<long double>(s.internal_value()), -32) - std::sin(theta)), 0x1p-32L) << a.internal_value();
+        EXPECT_LE(std::abs(std::ldexp(static_cast<long double>(c.internal_value()), -32) - std::cos(theta)), 0x1p-32L) << a.internal_value();
+        const auto x = a.to_radians<fixed64>();
+        EXPECT_LE(std::abs(std::ldexp(static_cast<long double>(x.internal_value()), -32) - std::remainder(theta, 2 * std::numbers::pi_v<long double>)),
+                  0x1p-33L)
+            << a.internal_value();
+
+        const auto y0 = fixed64::from_internal_value(static_cast<int64_t>(rng()) >> (rng() % 63));
+        const auto x0 = fixed64::from_internal_value(static_cast<int64_t>(rng()) >> (rng() % 63));
+        const long double expected =
+            std::atan2(static_cast<long double>(y0.internal_value()), static_cast<long double>(x0.internal_value())) / (2 * std::numbers::pi_v<long double>) * 0x1p32L;
+        const auto diff = static_cast<long double>(angle<32>::atan2(y0, x0).internal_value()) - (expected < 0 ? expected + 0x1p32L : expected);
+        EXPECT_LE(std::min(std::abs(diff), 0x1p32L - std::abs(diff)), 1.0L) << y0 << ' ' << x0;
+    }
+}
+
+#    ifdef EIRIN_DEV_TEST_MODE
+TEST(Fixed64, SimdMath)
+{
+    using test_math::expect_fixed_eq;
+
+    eirin::mt19937_64 rng(114514u);
+    std::vector<fixed64> xs(1027), ys(1027);
+    for(auto& x : xs)
+        x = fixed64::from_internal_value(static_cast<int64_t>(rng() >> 16)) - 32768_f64;
+    for(size_t i = 0; i < xs.size(); ++i)
+        ys[i] = fixed64::from_internal_value(static_cast<int64_t>(rng() >> 16)) - 32768_f64;
+
+    for(size_t i = 0; i < xs.size(); ++i)
+    {
+        auto a = std::array{xs[i], ys[i], -xs[i], -ys[i]};
+        auto b = std::array{ys[i], xs[i], xs[i], -ys[i]};
+        auto av = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a.data()));
+        auto bv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b.data()));
+        std::array<fixed64, 4> res;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(res.data()), simd::detail::avx_mm256_fpmul_epi64(av, bv));
+        for(size_t j = 0; j < 4; ++j)
+            EXPECT_EQ(res[j], a[j] * b[j]);
+    }
+
+    // the batch angles are reduced like the scalar ones, also at the multiples of pi / 2 and the limits.
+    std::vector<fixed64> angles(xs.begin(), xs.end() - 3);
+    for(int k = -8; k <= 8; ++k)
+    {
+        const auto quarter = fixed64::pi_2() * k;
+        for(int64_t d : {-2, -1, 0, 1, 2})
+            angles.push_back(quarter + fixed64::from_internal_value(d));
+    }
+    // the scalar ``abs`` of the min value overflows, so the limits start one above it.
+    for(auto x : {min_value<fixed64>() + fixed64::from_internal_value(1), max_value<fixed64>(), fixed64::double_pi(), -fixed64::double_pi(), 0.0001_f64, -0.0001_f64, 1_f64 / fixed64::from_internal_value(1 << 20)})
+        angles.push_back(x);
+
+    std::vector<fixed64> sin_out(angles.size()), cos_out(angles.size());
+    simd::sincos(angles, sin_out, cos_out);
+    for(size_t i = 0; i < angles.size(); ++i)
+    {
+        auto [s, c] = sincos(angles[i]);
+        EXPECT_EQ(sin_out[i], s) << "angle: " << angles[i];
+        EXPECT_EQ(cos_out[i], c) << "angle: " << angles[i];
+    }
+    simd::cordic_sincos(angles, sin_out, cos_out);
+    for(size_t i = 0; i < angles.size(); ++i)
+    {
+        auto [s, c] = cordic_sincos(angles[i]);
+        EXPECT_EQ(sin_out[i], s) << "angle: " << angles[i];
+        EXPECT_EQ(cos_out[i], c) << "angle: " << angles[i];
+    }
+
+    // the magnitudes of the vectors near the limits saturate to the max value, and the wide inputs are shifted down
+    // with the floor of the scalar arithmetic shift.
+    const auto max = max_value<fixed64>(), min = min_value<fixed64>();
+    for(auto [x, y] : {std::pair{max, max}, {min, min}, {max, min}, {min, 0_f64}, {0_f64, max}, {0_f64, 0_f64}, {1e-9_f64, -1e-9_f64},
+                          {fixed64::from_internal_value(3348533313747153877), fixed64::from_internal_value(-1831699135)}})
+    {
+        xs.push_back(x);
+        ys.push_back(y);
+    }
+
+    std::vector<fixed64> magnitude_out(xs.size()), angle_out(xs.size());
+    simd::cordic_polar(xs, ys, magnitude_out, angle_out);
+    for(size_t i = 0; i < xs.size(); ++i)
+    {
+        auto [m, a] = cordic_polar(xs[i], ys[i]);
+        EXPECT_EQ(magnitude_out[i], m) << "x: " << xs[i] << ", y: " << ys[i];
+        EXPECT_EQ(angle_out[i], a) << "x: " << xs[i] << ", y: " << ys[i];
+    }
+}
+#    endif
+
 TEST(Fixed64, Math)
 {
     using test_math::expect_fixed_eq;
@@ -306,6 +2032,9 @@ TEST(Fixed64, Math)
     EXPECT_TRUE(expect_fixed_eq(cbrt(1_f64), 1_f64));
     EXPECT_TRUE(expect_fixed_eq(cbrt(8_f64), 2_f64));
     EXPECT_TRUE(expect_fixed_eq(cbrt(27_f64), 3_f64));
+    EXPECT_EQ(cbrt(-8_f64), -2_f64);
+    EXPECT_EQ(cbrt(min_value<fixed64>()), -fixed64::from_internal_value(5541191377757));
+    EXPECT_EQ(cbrt(1000000000_f64), 1000_f64);
     EXPECT_TRUE(expect_fixed_eq(log2(2_f64), 1_f64));
     EXPECT_TRUE(expect_fixed_eq(log2(10_f64), 3.321928_f64));
     EXPECT_TRUE(expect_fixed_eq(log(fixed64::e()), 1_f64));
@@ -0,0 +1,213 @@
+/**
+ * @file remez.cpp
+ * @brief Generates the minimax polynomial coefficients used by the math functions,
+ *        and prints them as ``include/eirin/detail/minimax.hpp``.
+ *
+ * Usage: remez > include/eirin/detail/minimax.hpp
+ *
+ * Every function is approximated on [0, 1] by an odd polynomial x * P(x^2) for each number of terms
+ * with the Remez exchange algorithm, and the max absolute error of the rounded coefficients is recorded,
+ * so that each fixed point format picks the lowest degree which meets its precision at compile time.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+using real = long double;
+
+// the fraction bits of the emitted coefficients, the same as the constants in numbers.hpp.
+constexpr int coeff_fraction = 61;
+constexpr size_t grid_size = 1 << 14;
+constexpr int max_iterations = 64;
+
+struct target_function
+{
+    const char* name;
+    const char* comment;
+    real (*func)(real);
+    size_t max_terms;
+};
+
+real sin_quarter(real x)
+{
+    return std::sin(x * 1.570796326794896619231321691639751442L);
+}
+
+real atan_unit(real x)
+{
+    return std::atan(x);
+}
+
+real eval(const std::vector<real>& coeffs, real x)
+{
+    const real x2 = x * x;
+    real res = 0;
+    for(size_t i = coeffs.size(); i-- > 0;)
+        res = res * x2 + coeffs[i];
+    return res * x;
+}
+
+/**
+ * @brief Solves sum(c_i * x_j^(2i+1)) + (-1)^j * E = f(x_j) for the coefficients c and the levelled error E.
+ */
+std::vector<real> solve_reference(const target_function& fn, const std::vector<real>& ref)
+{
+    const size_t n = ref.size() - 1;
+    std::vector<std::vector<real>> mat(n + 1, std::vector<real>(n + 2));
+    for(size_t j = 0; j <= n; ++j)
+    {
+        real p = ref[j];
+        for(size_t i = 0; i < n; ++i, p *= ref[j] * ref[j])
+            mat[j][i] = p;
+        mat[j][n] = (j & 1) ? -1 : 1;
+        mat[j][n + 1] = fn.func(ref[j]);
+    }
+    // gaussian elimination with partial pivoting.
+    for(size_t col = 0; col <= n; ++col)
+    {
+        size_t pivot = col;
+        for(size_t row = col + 1; row <= n; ++row)
+            if(std::fabs(mat[row][col]) > std::fabs(mat[pivot][col]))
+                pivot = row;
+        std::swap(mat[col], mat[pivot]);
+        for(size_t row = 0; row <= n; ++row)
+        {
+            if(row == col)
+                continue;
+            const real factor = mat[row][col] / mat[col][col];
+            for(size_t k = col; k <= n + 1; ++k)
+                mat[row][k] -= factor * mat[col][k];
+        }
+    }
+    std::vector<real> coeffs(n);
+    for(size_t i = 0; i < n; ++i)
+        coeffs[i] = mat[i][n + 1] / mat[i][i];
+    return coeffs;
+}
+
+real max_error(const target_function& fn, const std::vector<real>& coeffs)
+{
+    real res = 0;
+    for(size_t i = 1; i <= grid_size * 4; ++i)
+    {
+        const real x = static_cast<real>(i) / (grid_size * 4);
+        res = std::max(res, std::fabs(eval(coeffs, x) - fn.func(x)));
+    }
+    return res;
+}
+
+/**
+ * @brief Picks the local extrema of the error with alternating signs as the next reference.
+ * @return false if there are not enough alternations.
+ */
+bool exchange(const target_function& fn, const std::vector<real>& coeffs, std::vector<real>& ref)
+{
+    std::vector<real> points;
+    std::vector<real> errors;
+    for(size_t i = 1; i <= grid_size; ++i)
+    {
+        const real x = static_cast<real>(i) / grid_size;
+        const real e = eval(coeffs, x) - fn.func(x);
+        if(!errors.empty() && std::signbit(e) == std::signbit(errors.back()))
+        {
+            if(std::fabs(e) > std::fabs(errors.back()))
+            {
+                points.back() = x;
+                errors.back() = e;
+            }
+        }
+        else
+        {
+            points.push_back(x);
+            errors.push_back(e);
+        }
+    }
+    // drop the smaller end while there are more alternations than needed.
+    while(points.size() > ref.size())
+    {
+        if(std::fabs(errors.front()) < std::fabs(errors.back()))
+        {
+            points.erase(points.begin());
+            errors.erase(errors.begin());
+        }
+        else
+        {
+            points.pop_back();
+            errors.pop_back();
+        }
+    }
+    if(points.size() < ref.size())
+        return false;
+    ref = points;
+    return true;
+}
+
+std::vector<real> remez(const target_function& fn, size_t terms)
+{
+    std::vector<real> ref(terms + 1);
+    for(size_t j = 0; j <= terms; ++j)
+        ref[j] = (1 - std::cos(3.141592653589793238462643383279502884L * (j + 1) / (terms + 1))) / 2;
+    auto coeffs = solve_reference(fn, ref);
+    for(int i = 0; i < max_iterations; ++i)
+    {
+        auto next_ref = ref;
+        if(!exchange(fn, coeffs, next_ref))
+            break;
+        auto next = solve_reference(fn, next_ref);
+        if(max_error(fn, next) > max_error(fn, coeffs))
+            break;
+        ref = next_ref;
+        coeffs = next;
+    }
+    return coeffs;
+}
+
+void emit(const target_function& fn)
+{
+    std::printf("\n// %s\n", fn.comment);
+    std::printf("inline constexpr minimax_poly %s[] = {\n", fn.name);
+    for(size_t terms = 1; terms <= fn.max_terms; ++terms)
+    {
+        auto coeffs = remez(fn, terms);
+        std::vector<int64_t> bits(terms);
+        for(size_t i = 0; i < terms; ++i)
+        {
+            bits[i] = static_cast<int64_t>(std::llround(std::ldexp(coeffs[i], coeff_fraction)));
+            coeffs[i] = std::ldexp(static_cast<real>(bits[i]), -coeff_fraction);
+        }
+        const auto error_bits = static_cast<unsigned int>(std::floor(-std::log2(max_error(fn, coeffs))));
+        std::printf("    {%zu, %u, {", terms, error_bits);
+        for(size_t i = 0; i < terms; ++i)
+            std::printf("%s%s0x%llX", i ? ", " : "", bits[i] < 0 ? "-" : "", static_cast<unsigned long long>(std::llabs(bits[i])));
+        std::printf("}},\n");
+    }
+    std::printf("};\n");
+}
+} // namespace
+
+int main()
+{
+    constexpr target_function functions[] = {
+        {"minimax_sin_quarter", "sin(pi / 2 * x) = x * P(x^2) for x in [0, 1].", sin_quarter, 8},
+        {"minimax_atan", "atan(x) = x * P(x^2) for x in [0, 1].", atan_unit, 12}
+    };
+    std::printf("// This file is generated by tools/remez.cpp, do not edit it by hand.\n");
+    std::printf("#ifndef EIRIN_DETAIL_MINIMAX_HPP\n#define EIRIN_DETAIL_MINIMAX_HPP\n\n");
+    std::printf("#include <array>\n#include <cstddef>\n#include <cstdint>\n\n");
+    std::printf("namespace eirin::detail\n{\n");
+    std::printf("/**\n * @brief An odd minimax polynomial x * (c[0] + c[1] * x^2 + ...) on [0, 1].\n");
+    std::printf(" * The coefficients have %d fraction bits, and the max absolute error of the polynomial is below 2^-error_bits.\n */\n", coeff_fraction);
+    std::printf("struct minimax_poly\n{\n    size_t terms;\n    unsigned int error_bits;\n    std::array<int64_t, 12> coeffs;\n};\n\n");
+    std::printf("inline constexpr unsigned int minimax_fraction = %d;\n", coeff_fraction);
+    for(const auto& fn : functions)
+        emit(fn);
+    std::printf("\n/**\n * @brief The lowest degree polynomial in the table with an error below 2^-bits, or the most precise one.\n */\n");
+    std::printf("template <size_t N>\nconstexpr const minimax_poly& minimax_select(const minimax_poly (&table)[N], unsigned int bits) noexcept\n{\n");
+    std::printf("    for(const auto& poly : table)\n        if(poly.error_bits >= bits)\n            return poly;\n    return table[N - 1];\n}\n");
+    std::printf("} // namespace eirin::detail\n\n#endif\n");
+    return 0;
+}
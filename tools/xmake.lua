@@ -0,0 +1,3 @@
+target("eirin_fixed.remez")
+    set_kind("binary")
+    add_files("./remez.cpp")
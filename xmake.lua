@@ -18,6 +18,11 @@ option("eirin_dev_test")
     set_showmenu(true)
     set_description("Develop Test Include")
     option_end()
+option("eirin_build_tools")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Build the coefficient generators in tools")
+    option_end()
 option("eirin_build_advanced_benchmark")
     set_default(false)
     set_showmenu(true)
@@ -39,3 +44,6 @@ end
 if has_config("eirin_build_benchmarks") then
     includes("benchmark")
 end
+if has_config("eirin_build_tools") then
+    includes("tools")
+end